@@ -14,23 +14,29 @@
 # ********************************************************************/
 
 HEADERS += \
+src/autoroute/autoplacer.h \
 src/autoroute/autorouter.h \
 src/autoroute/autorouteprogressdialog.h \
 src/autoroute/autoroutersettingsdialog.h \
 src/autoroute/checker.h  \
 src/autoroute/binpacking/Rect.h  \
 src/autoroute/binpacking/GuillotineBinPack.h  \
+src/autoroute/mazerouter/grid.h  \
 src/autoroute/mazerouter/mazerouter.h  \
 src/autoroute/zoomcontrols.h \
 src/autoroute/drc.h \
+src/autoroute/drcbitmap.h \
 
 SOURCES += \
+src/autoroute/autoplacer.cpp \
 src/autoroute/autorouter.cpp \
 src/autoroute/autorouteprogressdialog.cpp \
 src/autoroute/autoroutersettingsdialog.cpp \
 src/autoroute/checker.cpp  \
 src/autoroute/binpacking/Rect.cpp  \
 src/autoroute/binpacking/GuillotineBinPack.cpp  \
+src/autoroute/mazerouter/grid.cpp  \
 src/autoroute/mazerouter/mazerouter.cpp  \
 src/autoroute/zoomcontrols.cpp \
 src/autoroute/drc.cpp \
+src/autoroute/drcbitmap.cpp \
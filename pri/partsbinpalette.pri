@@ -19,6 +19,7 @@ HEADERS += \
     src/partsbinpalette/partsbiniconview.h \
     src/partsbinpalette/graphicsflowlayout.h \
     src/partsbinpalette/svgiconwidget.h \
+    src/partsbinpalette/iconcache.h \
     src/partsbinpalette/partsbincommands.h \
     src/partsbinpalette/searchlineedit.h \
     src/partsbinpalette/binmanager/binmanager.h \
@@ -32,6 +33,7 @@ SOURCES +=  \
     src/partsbinpalette/partsbiniconview.cpp \
     src/partsbinpalette/graphicsflowlayout.cpp \
     src/partsbinpalette/svgiconwidget.cpp \
+    src/partsbinpalette/iconcache.cpp \
     src/partsbinpalette/partsbincommands.cpp \
     src/partsbinpalette/searchlineedit.cpp \
     src/partsbinpalette/binmanager/binmanager.cpp \
@@ -17,6 +17,7 @@ HEADERS += \
     src/sketch/fgraphicsscene.h \
     src/sketch/breadboardsketchwidget.h \
     src/sketch/infographicsview.h \
+    src/sketch/netlistcache.h \
     src/sketch/pcbsketchwidget.h \
     src/sketch/schematicsketchwidget.h \
     src/sketch/sketchwidget.h \
@@ -29,6 +30,7 @@ SOURCES += \
     src/sketch/fgraphicsscene.cpp \
     src/sketch/breadboardsketchwidget.cpp \
     src/sketch/infographicsview.cpp \
+    src/sketch/netlistcache.cpp \
     src/sketch/pcbsketchwidget.cpp \
     src/sketch/schematicsketchwidget.cpp \
     src/sketch/sketchwidget.cpp \
@@ -16,11 +16,15 @@ HEADERS += src/svg/svgfilesplitter.h \
     src/svg/svgpathparser.h \
     src/svg/svgpathgrammar_p.h \
     src/svg/svgpathlexer.h \
-    src/svg/svgpathrunner.h \
+    src/svg/svgpathvisitor.h \
     src/svg/svg2gerber.h \
+    src/svg/gerberwriter.h \
     src/svg/svgflattener.h \
+    src/svg/svgprefetch.h \
     src/svg/gerbergenerator.h \
     src/svg/groundplanegenerator.h \
+    src/svg/scanlinetracer.h \
+    src/svg/bitmaptracer.h \
     src/svg/x2svg.h \
     src/svg/kicad2svg.h \
     src/svg/kicadmodule2svg.h \
@@ -35,11 +39,15 @@ SOURCES += src/svg/svgfilesplitter.cpp \
     src/svg/svgpathparser.cpp \
     src/svg/svgpathgrammar.cpp \
     src/svg/svgpathlexer.cpp \
-    src/svg/svgpathrunner.cpp \
+    src/svg/svgpathvisitor.cpp \
     src/svg/svg2gerber.cpp \
+    src/svg/gerberwriter.cpp \
     src/svg/svgflattener.cpp \
+    src/svg/svgprefetch.cpp \
     src/svg/gerbergenerator.cpp \
     src/svg/groundplanegenerator.cpp \
+    src/svg/scanlinetracer.cpp \
+    src/svg/bitmaptracer.cpp \
     src/svg/x2svg.cpp \
     src/svg/kicad2svg.cpp \
     src/svg/kicadmodule2svg.cpp \
@@ -39,6 +39,7 @@ src/utils/graphutils.h \
 src/utils/ratsnestcolors.h \
 src/utils/schematicrectconstants.h \
 src/utils/s2s.h \
+src/utils/spanningtree.h \
 src/utils/textutils.h \
 src/utils/zoomslider.h
 
@@ -64,5 +65,6 @@ src/utils/graphutils.cpp \
 src/utils/ratsnestcolors.cpp \
 src/utils/schematicrectconstants.cpp \
 src/utils/s2s.cpp \
+src/utils/spanningtree.cpp \
 src/utils/textutils.cpp \
 src/utils/zoomslider.cpp
@@ -0,0 +1,467 @@
+/*******************************************************************
+
+Part of the Fritzing project - http://fritzing.org
+Copyright (c) 2007-2019 Fritzing
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************/
+
+#include "autoplacer.h"
+
+#include <QFuture>
+#include <QThread>
+#include <QtConcurrentRun>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+
+namespace {
+
+constexpr double SwapProbability = 0.3;
+constexpr double InitialOverlapWeight = 0.5;
+constexpr double MaxOverlapWeight = 100;
+constexpr double OverlapWeightGrowth = 1.1;
+constexpr double AreaTolerance = 1e-9;		// relative to the part's area; outside() is a difference of nearly equal areas
+
+double overlapArea(double x1, double y1, double w1, double h1, double x2, double y2, double w2, double h2) {
+	double ox = std::min(x1 + w1 / 2, x2 + w2 / 2) - std::max(x1 - w1 / 2, x2 - w2 / 2);
+	if (ox <= 0) return 0;
+	double oy = std::min(y1 + h1 / 2, y2 + h2 / 2) - std::max(y1 - h1 / 2, y2 - h2 / 2);
+	if (oy <= 0) return 0;
+	return ox * oy;
+}
+
+// one annealing run; positions are kept in flat arrays so a move only touches its own parts' nets
+class Chain
+{
+public:
+	Chain(const QRectF & area, const QList<AutoPlacer::Part> & parts, const QList<AutoPlacer::Net> & nets,
+	      const QVector< QVector<int> > & partNets, const QVector<int> & movable, unsigned seed)
+		: m_area(area)
+		, m_nets(nets)
+		, m_partNets(partNets)
+		, m_movable(movable)
+		, m_random(seed)
+		, m_netStamp(nets.count(), 0)
+		, m_netCost(nets.count(), 0)
+	{
+		double sides = 0;
+		Q_FOREACH (AutoPlacer::Part part, parts) {
+			m_x.append(part.center.x());
+			m_y.append(part.center.y());
+			m_w.append(part.size.width());
+			m_h.append(part.size.height());
+			m_fixed.append(part.fixed);
+			sides += part.size.width() + part.size.height();
+		}
+		m_meanSide = qMax(1.0, sides / qMax(1, 2 * (int) parts.count()));
+
+		for (int n = 0; n < m_nets.count(); n++) {
+			m_netCost[n] = netCost(n, Move());
+			m_wirelength += m_netCost[n];
+		}
+		Q_FOREACH (int a, m_movable) {
+			m_illegal += outside(a, m_x[a], m_y[a]);
+			for (int b = 0; b < m_x.count(); b++) {
+				// count each pair of movable parts once
+				if (b == a || (!m_fixed[b] && b < a)) continue;
+				m_illegal += overlapArea(m_x[a], m_y[a], m_w[a], m_h[a], m_x[b], m_y[b], m_w[b], m_h[b]);
+			}
+		}
+		m_illegal /= m_meanSide;
+	}
+
+	void anneal();
+	int legalize();
+
+	QList<QPointF> centers() const {
+		QList<QPointF> centers;
+		for (int i = 0; i < m_x.count(); i++) centers.append(QPointF(m_x[i], m_y[i]));
+		return centers;
+	}
+
+protected:
+	struct Move {
+		int a = -1;
+		double ax = 0;
+		double ay = 0;
+		int b = -1;
+		double bx = 0;
+		double by = 0;
+	};
+
+	double netCost(int n, const Move & move) const {
+		double minX = std::numeric_limits<double>::max();
+		double minY = std::numeric_limits<double>::max();
+		double maxX = std::numeric_limits<double>::lowest();
+		double maxY = std::numeric_limits<double>::lowest();
+		Q_FOREACH (AutoPlacer::Pin pin, m_nets.at(n)) {
+			double x;
+			double y;
+			if (pin.part == move.a) {
+				x = move.ax;
+				y = move.ay;
+			}
+			else if (pin.part == move.b) {
+				x = move.bx;
+				y = move.by;
+			}
+			else {
+				x = m_x[pin.part];
+				y = m_y[pin.part];
+			}
+			x += pin.offset.x();
+			y += pin.offset.y();
+			minX = std::min(minX, x);
+			maxX = std::max(maxX, x);
+			minY = std::min(minY, y);
+			maxY = std::max(maxY, y);
+		}
+		if (minX > maxX) return 0;
+		return (maxX - minX) + (maxY - minY);
+	}
+
+	double outside(int a, double x, double y) const {
+		double area = m_w[a] * m_h[a];
+		return area - overlapArea(x, y, m_w[a], m_h[a], m_area.center().x(), m_area.center().y(), m_area.width(), m_area.height());
+	}
+
+	// overlap of part a at (x, y) with every part except a and skip
+	double overlap(int a, double x, double y, int skip) const {
+		double total = 0;
+		for (int b = 0; b < m_x.count(); b++) {
+			if (b == a || b == skip) continue;
+			total += overlapArea(x, y, m_w[a], m_h[a], m_x[b], m_y[b], m_w[b], m_h[b]);
+		}
+		return total;
+	}
+
+	void evaluate(const Move & move, double & dWirelength, double & dIllegal);
+	void apply(const Move & move, double dWirelength, double dIllegal);
+	bool propose(double range, Move & move);
+	double uniform() {
+		return std::uniform_real_distribution<double>(0, 1)(m_random);
+	}
+
+protected:
+	QRectF m_area;
+	const QList<AutoPlacer::Net> & m_nets;
+	const QVector< QVector<int> > & m_partNets;
+	const QVector<int> & m_movable;
+	std::mt19937 m_random;
+	QVector<double> m_x;
+	QVector<double> m_y;
+	QVector<double> m_w;
+	QVector<double> m_h;
+	QVector<bool> m_fixed;
+	QVector<int> m_netStamp;
+	int m_stamp = 0;
+	QVector<double> m_netCost;
+	QVector<int> m_touched;
+	QVector<double> m_touchedCost;
+	double m_meanSide = 1;
+	double m_wirelength = 0;
+	double m_illegal = 0;						// overlap and overhang area, divided by m_meanSide
+	double m_overlapWeight = InitialOverlapWeight;
+};
+
+void Chain::evaluate(const Move & move, double & dWirelength, double & dIllegal) {
+	m_stamp++;
+	m_touched.clear();
+	m_touchedCost.clear();
+	dWirelength = 0;
+	for (int a : { move.a, move.b }) {
+		if (a < 0) continue;
+		Q_FOREACH (int n, m_partNets.at(a)) {
+			if (m_netStamp[n] == m_stamp) continue;
+			m_netStamp[n] = m_stamp;
+			double cost = netCost(n, move);
+			m_touched.append(n);
+			m_touchedCost.append(cost);
+			dWirelength += cost - m_netCost[n];
+		}
+	}
+
+	int a = move.a;
+	double illegal = overlap(a, move.ax, move.ay, move.b) - overlap(a, m_x[a], m_y[a], move.b);
+	illegal += outside(a, move.ax, move.ay) - outside(a, m_x[a], m_y[a]);
+	if (move.b >= 0) {
+		int b = move.b;
+		illegal += overlap(b, move.bx, move.by, a) - overlap(b, m_x[b], m_y[b], a);
+		illegal += outside(b, move.bx, move.by) - outside(b, m_x[b], m_y[b]);
+		illegal += overlapArea(move.ax, move.ay, m_w[a], m_h[a], move.bx, move.by, m_w[b], m_h[b]);
+		illegal -= overlapArea(m_x[a], m_y[a], m_w[a], m_h[a], m_x[b], m_y[b], m_w[b], m_h[b]);
+	}
+	dIllegal = illegal / m_meanSide;
+}
+
+void Chain::apply(const Move & move, double dWirelength, double dIllegal) {
+	m_x[move.a] = move.ax;
+	m_y[move.a] = move.ay;
+	if (move.b >= 0) {
+		m_x[move.b] = move.bx;
+		m_y[move.b] = move.by;
+	}
+	for (int i = 0; i < m_touched.count(); i++) {
+		m_netCost[m_touched.at(i)] = m_touchedCost.at(i);
+	}
+	m_wirelength += dWirelength;
+	m_illegal += dIllegal;
+}
+
+bool Chain::propose(double range, Move & move) {
+	std::uniform_int_distribution<int> pick(0, m_movable.count() - 1);
+	move = Move();
+	move.a = m_movable.at(pick(m_random));
+
+	if (m_movable.count() > 1 && uniform() < SwapProbability) {
+		int b = m_movable.at(pick(m_random));
+		if (b == move.a) return false;
+		if (std::abs(m_x[b] - m_x[move.a]) > range || std::abs(m_y[b] - m_y[move.a]) > range) return false;
+
+		move.b = b;
+		move.ax = m_x[b];
+		move.ay = m_y[b];
+		move.bx = m_x[move.a];
+		move.by = m_y[move.a];
+		return true;
+	}
+
+	// keep the part inside the area where it fits
+	int a = move.a;
+	double halfW = std::min(m_w[a], m_area.width()) / 2;
+	double halfH = std::min(m_h[a], m_area.height()) / 2;
+	move.ax = qBound(m_area.left() + halfW, m_x[a] + (uniform() * 2 - 1) * range, m_area.right() - halfW);
+	move.ay = qBound(m_area.top() + halfH, m_y[a] + (uniform() * 2 - 1) * range, m_area.bottom() - halfH);
+	return move.ax != m_x[a] || move.ay != m_y[a];
+}
+
+void Chain::anneal() {
+	if (m_movable.isEmpty()) return;
+
+	int movesPerTemperature = (int) (AutoPlacer::MovesPerPart * std::pow((double) m_movable.count(), 4.0 / 3.0));
+	double maxRange = std::max(m_area.width(), m_area.height());
+	double minRange = m_meanSide / 4;
+	double range = maxRange;
+
+	// start hot enough that nearly every random move is accepted
+	double sum = 0;
+	double sumSquares = 0;
+	int samples = 0;
+	for (int i = 0; i < m_movable.count() * 4; i++) {
+		Move move;
+		if (!propose(range, move)) continue;
+
+		double dWirelength, dIllegal;
+		evaluate(move, dWirelength, dIllegal);
+		double delta = dWirelength + m_overlapWeight * dIllegal;
+		sum += delta;
+		sumSquares += delta * delta;
+		samples++;
+	}
+	double deviation = samples > 1 ? std::sqrt(std::max(0.0, (sumSquares - sum * sum / samples) / (samples - 1))) : m_meanSide;
+	double temperature = std::max(deviation * 20, 1e-3);
+
+	for (int t = 0; t < AutoPlacer::MaxTemperatures; t++) {
+		int accepted = 0;
+		for (int i = 0; i < movesPerTemperature; i++) {
+			Move move;
+			if (!propose(range, move)) continue;
+
+			double dWirelength, dIllegal;
+			evaluate(move, dWirelength, dIllegal);
+			double delta = dWirelength + m_overlapWeight * dIllegal;
+			if (delta <= 0 || uniform() < std::exp(-delta / temperature)) {
+				apply(move, dWirelength, dIllegal);
+				accepted++;
+			}
+		}
+
+		double acceptRate = (double) accepted / movesPerTemperature;
+		range = qBound(minRange, range * (1 - 0.44 + acceptRate), maxRange);
+		if (acceptRate > 0.96) temperature *= 0.5;
+		else if (acceptRate > 0.8) temperature *= 0.9;
+		else if (acceptRate > 0.15) temperature *= 0.95;
+		else temperature *= 0.8;
+		m_overlapWeight = std::min(MaxOverlapWeight, m_overlapWeight * OverlapWeightGrowth);
+
+		double cost = m_wirelength + m_overlapWeight * m_illegal;
+		if (temperature < 0.005 * cost / qMax(1, (int) m_nets.count())) break;
+	}
+
+	// the running sums drift after many incremental updates
+	m_wirelength = 0;
+	for (int n = 0; n < m_nets.count(); n++) {
+		m_netCost[n] = netCost(n, Move());
+		m_wirelength += m_netCost[n];
+	}
+}
+
+int Chain::legalize() {
+	QVector<int> placed;
+	for (int i = 0; i < m_x.count(); i++) {
+		if (m_fixed[i]) placed.append(i);
+	}
+
+	auto fits = [&](int a, double x, double y) {
+		double tolerance = AreaTolerance * m_w[a] * m_h[a];
+		if (outside(a, x, y) > tolerance) return false;
+		Q_FOREACH (int b, placed) {
+			if (overlapArea(x, y, m_w[a], m_h[a], m_x[b], m_y[b], m_w[b], m_h[b]) > tolerance) return false;
+		}
+		return true;
+	};
+
+	// big parts first, they are the hardest to fit in later
+	QVector<int> order = m_movable;
+	std::sort(order.begin(), order.end(), [this](int a, int b) { return m_w[a] * m_h[a] > m_w[b] * m_h[b]; });
+
+	int overlaps = 0;
+	double step = std::max(1.0, m_meanSide / 4);
+	int maxRing = (int) std::ceil(std::max(m_area.width(), m_area.height()) / step);
+	Q_FOREACH (int a, order) {
+		if (!fits(a, m_x[a], m_y[a])) {
+			// search outward ring by ring for the closest free spot
+			bool found = false;
+			double bestX = 0;
+			double bestY = 0;
+			for (int ring = 1; ring <= maxRing && !found; ring++) {
+				double bestDistance = std::numeric_limits<double>::max();
+				for (int i = -ring; i <= ring; i++) {
+					for (int j = -ring; j <= ring; j++) {
+						if (std::abs(i) != ring && std::abs(j) != ring) continue;
+
+						double x = m_x[a] + i * step;
+						double y = m_y[a] + j * step;
+						double distance = (double) i * i + (double) j * j;
+						if (distance >= bestDistance) continue;
+						if (!fits(a, x, y)) continue;
+
+						found = true;
+						bestDistance = distance;
+						bestX = x;
+						bestY = y;
+					}
+				}
+			}
+			if (found) {
+				m_x[a] = bestX;
+				m_y[a] = bestY;
+			}
+			else {
+				overlaps++;
+			}
+		}
+		placed.append(a);
+	}
+
+	m_wirelength = 0;
+	for (int n = 0; n < m_nets.count(); n++) {
+		m_wirelength += netCost(n, Move());
+	}
+	return overlaps;
+}
+
+}
+
+AutoPlacer::AutoPlacer(const QRectF & area, const QList<Part> & parts, const QList<Net> & nets)
+	: m_area(area)
+	, m_parts(parts)
+	, m_nets(nets)
+	, m_partNets(parts.count())
+{
+	for (int n = 0; n < m_nets.count(); n++) {
+		Q_FOREACH (Pin pin, m_nets.at(n)) {
+			if (!m_partNets[pin.part].contains(n)) m_partNets[pin.part].append(n);
+		}
+	}
+
+	for (int i = 0; i < m_parts.count(); i++) {
+		m_result.centers.append(m_parts.at(i).center);
+		if (!m_parts.at(i).fixed) m_movable.append(i);
+	}
+	m_initialWirelength = m_result.wirelength = wirelength(m_nets, m_result.centers);
+}
+
+void AutoPlacer::place(int chains) {
+	if (m_movable.isEmpty()) return;
+
+	if (chains <= 0) chains = qMax(1, QThread::idealThreadCount());
+
+	// a move depends on every move accepted before it, so the threads run whole chains
+	QList< QFuture<Result> > futures;
+	for (int i = 0; i < chains; i++) {
+		unsigned seed = (unsigned) (i + 1);
+		futures << QtConcurrent::run([this, seed]() { return anneal(seed); });
+	}
+
+	bool first = true;
+	Q_FOREACH (QFuture<Result> future, futures) {
+		Result result = future.result();
+		if (first || result.overlaps < m_result.overlaps ||
+		        (result.overlaps == m_result.overlaps && result.wirelength < m_result.wirelength))
+		{
+			m_result = result;
+			first = false;
+		}
+	}
+}
+
+AutoPlacer::Result AutoPlacer::anneal(unsigned seed) const {
+	Chain chain(m_area, m_parts, m_nets, m_partNets, m_movable, seed);
+	chain.anneal();
+
+	Result result;
+	result.overlaps = chain.legalize();
+	result.centers = chain.centers();
+	result.wirelength = wirelength(m_nets, result.centers);
+	return result;
+}
+
+QList<QPointF> AutoPlacer::centers() const {
+	return m_result.centers;
+}
+
+double AutoPlacer::initialWirelength() const {
+	return m_initialWirelength;
+}
+
+double AutoPlacer::wirelength() const {
+	return m_result.wirelength;
+}
+
+int AutoPlacer::overlaps() const {
+	return m_result.overlaps;
+}
+
+double AutoPlacer::wirelength(const QList<Net> & nets, const QList<QPointF> & centers) {
+	double total = 0;
+	Q_FOREACH (Net net, nets) {
+		if (net.isEmpty()) continue;
+
+		QRectF bounds(centers.at(net.first().part) + net.first().offset, QSizeF(0, 0));
+		Q_FOREACH (Pin pin, net) {
+			QPointF p = centers.at(pin.part) + pin.offset;
+			bounds.setLeft(std::min(bounds.left(), p.x()));
+			bounds.setRight(std::max(bounds.right(), p.x()));
+			bounds.setTop(std::min(bounds.top(), p.y()));
+			bounds.setBottom(std::max(bounds.bottom(), p.y()));
+		}
+		total += bounds.width() + bounds.height();
+	}
+	return total;
+}
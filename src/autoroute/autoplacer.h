@@ -0,0 +1,83 @@
+/*******************************************************************
+
+Part of the Fritzing project - http://fritzing.org
+Copyright (c) 2007-2019 Fritzing
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************/
+
+#ifndef AUTOPLACER_H
+#define AUTOPLACER_H
+
+#include <QList>
+#include <QPointF>
+#include <QRectF>
+#include <QSizeF>
+#include <QVector>
+
+// places parts inside a board area by simulated annealing on the half perimeter wirelength
+// (HPWL) of their nets, then moves any parts still overlapping to the nearest free spot.
+// Independent annealing chains run on the thread pool and the best result is kept.
+class AutoPlacer
+{
+public:
+	struct Part {
+		QSizeF size;				// including clearance to neighboring parts
+		QPointF center;
+		bool fixed = false;
+	};
+
+	struct Pin {
+		int part = 0;
+		QPointF offset;				// from the part's center
+	};
+
+	typedef QList<Pin> Net;
+
+public:
+	AutoPlacer(const QRectF & area, const QList<Part> & parts, const QList<Net> & nets);
+
+	void place(int chains = 0);		// 0 runs one chain per thread
+	QList<QPointF> centers() const;
+	double initialWirelength() const;
+	double wirelength() const;
+	int overlaps() const;			// parts left overlapping another part or outside the area
+
+	static double wirelength(const QList<Net> & nets, const QList<QPointF> & centers);
+
+public:
+	static constexpr int MovesPerPart = 10;
+	static constexpr int MaxTemperatures = 300;
+
+protected:
+	struct Result {
+		QList<QPointF> centers;
+		double wirelength = 0;
+		int overlaps = 0;
+	};
+
+	Result anneal(unsigned seed) const;
+
+protected:
+	QRectF m_area;
+	QList<Part> m_parts;
+	QList<Net> m_nets;
+	QVector< QVector<int> > m_partNets;
+	QVector<int> m_movable;
+	Result m_result;
+	double m_initialWirelength = 0;
+};
+
+#endif
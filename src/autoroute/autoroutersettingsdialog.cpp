@@ -50,6 +50,7 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 
 
 const QString AutorouterSettingsDialog::AutorouteTraceWidth = "autorouteTraceWidth";
+const QString AutorouterSettingsDialog::AutorouteNegotiate = "autorouteNegotiate";
 
 AutorouterSettingsDialog::AutorouterSettingsDialog(QHash<QString, QString> & settings, QWidget *parent) : QDialog(parent)
 {
@@ -111,6 +112,11 @@ AutorouterSettingsDialog::AutorouterSettingsDialog(QHash<QString, QString> & set
 
 	windowLayout->addWidget(prodGroupBox);
 
+	m_negotiateCheckBox = new QCheckBox(tr("Rip up and reroute only conflicting traces"), this);
+	m_negotiateCheckBox->setToolTip(tr("Instead of trying many net orderings, route all nets and then repeatedly reroute only the nets whose traces overlap, making crowded areas more expensive each round."));
+	m_negotiateCheckBox->setChecked(settings.value(AutorouteNegotiate) == "1");
+	windowLayout->addWidget(m_negotiateCheckBox);
+
 	windowLayout->addSpacerItem(new QSpacerItem(1, 10, QSizePolicy::Preferred, QSizePolicy::Expanding));
 
 	windowLayout->addWidget(buttonBox);
@@ -377,6 +383,7 @@ QHash<QString, QString> AutorouterSettingsDialog::getSettings() {
 	settings.insert(Via::AutorouteViaHoleSize, m_holeSettings.holeDiameter);
 	settings.insert(Via::AutorouteViaRingThickness, m_holeSettings.ringThickness);
 	settings.insert(AutorouteTraceWidth, QString::number(m_traceWidth));
+	settings.insert(AutorouteNegotiate, m_negotiateCheckBox->isChecked() ? "1" : "0");
 
 	return settings;
 }
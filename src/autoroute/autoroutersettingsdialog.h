@@ -27,6 +27,7 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include <QRadioButton>
 #include <QGroupBox>
 #include <QDoubleSpinBox>
+#include <QCheckBox>
 
 #include "../items/via.h"
 
@@ -76,9 +77,11 @@ protected:
 	QDoubleSpinBox * m_keepoutSpinBox;
 	QRadioButton * m_inRadio;
 	QRadioButton * m_mmRadio;
+	QCheckBox * m_negotiateCheckBox;
 
 public:
 	static const QString AutorouteTraceWidth;
+	static const QString AutorouteNegotiate;
 
 };
 
@@ -19,6 +19,7 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 ********************************************************************/
 
 #include "drc.h"
+#include "drcbitmap.h"
 #include "../connectors/svgidlayer.h"
 #include "../sketch/pcbsketchwidget.h"
 #include "../debugdialog.h"
@@ -31,6 +32,7 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include "../viewlayer.h"
 #include "../processeventblocker.h"
 #include "src/items/wire.h"
+#include "../testing/FProbeTiming.h"
 
 #include <qmath.h>
 #include <QApplication>
@@ -59,40 +61,6 @@ const QString DRC::AlsoNet = "alsoNet";
 const QString DRC::NotNet = "notnet";
 const QString DRC::Net = "net";
 
-const uchar DRC::BitTable[] = { 128, 64, 32, 16, 8, 4, 2, 1 };
-
-bool pixelsCollide(QImage * image1, QImage * image2, QImage * image3, int x1, int y1, int x2, int y2, uint clr, QList<QPointF> & points) {
-	bool result = false;
-	const uchar * bits1 = image1->constScanLine(0);
-	const uchar * bits2 = image2->constScanLine(0);
-	int bytesPerLine = image1->bytesPerLine();
-	for (int y = y1; y < y2; y++) {
-		int offset = y * bytesPerLine;
-		for (int x = x1; x < x2; x++) {
-			//QRgb p1 = image1->pixel(x, y);
-			//if (p1 == 0xffffffff) continue;
-
-			//QRgb p2 = image2->pixel(x, y);
-			//if (p2 == 0xffffffff) continue;
-
-			int byteOffset = (x >> 3) + offset;
-			uchar mask = DRC::BitTable[x & 7];
-
-			if ((*(bits1 + byteOffset) & mask) != 0) continue;
-			if ((*(bits2 + byteOffset) & mask) != 0) continue;
-
-			image3->setPixel(x, y, clr);
-			//DebugDialog::debug(QString("p1:%1 p2:%2").arg(p1, 0, 16).arg(p2, 0, 16));
-			result = true;
-			if (points.count() < 1000) {
-				points.append(QPointF(x, y));
-			}
-		}
-	}
-
-	return result;
-}
-
 QStringList getNames(CollidingThing * collidingThing) {
 	QStringList names;
 	QList<ItemBase *> itemBases;
@@ -297,6 +265,7 @@ QStringList DRC::start(bool showOkMessage, double keepoutMils) {
 }
 
 bool DRC::startAux(QString & message, QStringList & messages, QList<CollidingThing *> & collidingThings, double keepoutMils) {
+	FProbeTimer probeTimer("DRC");
 	bool bothSidesNow = m_sketchWidget->boardLayers() == 2;
 
 	QList<ConnectorItem *> visited;
@@ -436,7 +405,7 @@ bool DRC::startAux(QString & message, QStringList & messages, QList<CollidingThi
 		}
 
 		QList<QPointF> atPixels;
-		if (pixelsCollide(m_plusImage, m_minusImage, m_displayImage, 0, 0, imgSize.width(), imgSize.height(), 1 /* 0x80ff0000 */, atPixels)) {
+		if (DRCBitmap::pixelsCollide(m_plusImage, m_minusImage, m_displayImage, 0, 0, imgSize.width(), imgSize.height(), 1 /* 0x80ff0000 */, atPixels)) {
 			CollidingThing * collidingThing = findItemsAt(atPixels, m_board, viewLayerIDs, keepoutMils, dpi, true, nullptr);
 			QString msg = tr("Too close to a border (%1 layer)")
 						  .arg(viewLayerPlacement == ViewLayer::NewTop ? ItemBase::TranslatedPropertyNames.value("top") : ItemBase::TranslatedPropertyNames.value("bottom"))
@@ -538,7 +507,7 @@ bool DRC::startAux(QString & message, QStringList & messages, QList<CollidingThi
 				double b = (rect.bottom() - boardRect.top()) * dpi / GraphicsUtils::SVGDPI;
 				//DebugDialog::debug(QString("l:%1 t:%2 r:%3 b:%4").arg(l).arg(t).arg(r).arg(b));
 				QList<QPointF> atPixels;
-				if (pixelsCollide(m_plusImage, m_minusImage, m_displayImage, l, t, r, b, 1 /* 0x80ff0000 */, atPixels)) {
+				if (DRCBitmap::pixelsCollide(m_plusImage, m_minusImage, m_displayImage, l, t, r, b, 1 /* 0x80ff0000 */, atPixels)) {
 
 #ifndef QT_NO_DEBUG
 					m_plusImage->save(FolderUtils::getTopLevelUserDataStorePath() + QString("/collidePlus%1_%2.png").arg(viewLayerPlacement).arg(index));
@@ -947,46 +916,9 @@ CollidingThing * DRC::findItemsAt(QList<QPointF> & atPixels, ItemBase * board, c
 }
 
 void DRC::extendBorder(const double keepout, QImage * image) {
-	Q_ASSERT(image->format() == QImage::Format_Mono);
-	// keepout in terms of the board grid size
-	QImage copy = image->copy();
-
-	const int h = image->height();
-	const int w = image->width();
-	const int ikeepout = qCeil(keepout);
-	for (int y = 0; y < h; y++) {
-		uchar * s = copy.scanLine(y);
-		for (int x = 0; x < w; x++) {
-			if (((*(s + (x >> 3)) >> (~x & 7)) & 1) != 0) {  // if (copy.pixel(x, y) != 1)
-				continue;
-			}
-
-			const int y1 = std::max(y - ikeepout, 0);
-			const int y2 = std::min(y + ikeepout, h);
-			const int x1 = std::max(x - ikeepout, 0);
-			const int x2 = std::min(x + ikeepout, w);
-			// extend border by keepout
-			auto dx = 0;
-			for (int dy = y1; dy < y2; ++dy) {
-				uchar * r = image->scanLine(dy);
-				// This section is often the hotspot for creating copper layers,
-				// especially if shapes are irregular.
-				// We apply a kernel of size 'ikeepout' to the image just
-				// to get the *board* border (not an offset around traces)
-				// Directly calculating this on the vector graphic would be
-				// a thousand times faster: Minkowski sum on a polygon with a small
-				// number of vertices. This is work in progress, using the
-				// Clipper library. However that is a major change, therefore
-				// we are happy with replacing setPixel() for now.
-				for (dx = x1; dx < x2; ++dx) {
-					*(r + (dx >> 3)) &= ~(1 << (7-(dx & 7))); //image->setPixel(dx, dy, 0);
-				}
-			}
-		}
-	}
+	DRCBitmap::extendBorder(keepout, image);
 }
 
-
 void DRC::checkHoles(QStringList & messages, QList<CollidingThing *> & collidingThings, double dpi) {
 	QRectF boardRect = m_board->sceneBoundingRect();
 	Q_FOREACH (QGraphicsItem * item, m_sketchWidget->scene()->collidingItems(m_board)) {
@@ -81,7 +81,6 @@ public:
 	static const QString NotNet;
 	static const QString AlsoNet;
 	static const QString Net;
-	static const uchar BitTable[];
 	static const QString KeepoutSettingName;
 	static const double KeepoutDefaultMils;
 
@@ -0,0 +1,99 @@
+/*******************************************************************
+
+Part of the Fritzing project - http://fritzing.org
+Copyright (c) 2007-2019 Fritzing
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************/
+
+#include "drcbitmap.h"
+
+#include <qmath.h>
+
+#include <algorithm>
+
+const uchar DRCBitmap::BitTable[] = { 128, 64, 32, 16, 8, 4, 2, 1 };
+
+bool DRCBitmap::pixelsCollide(QImage * image1, QImage * image2, QImage * image3, int x1, int y1, int x2, int y2, uint clr, QList<QPointF> & points) {
+	bool result = false;
+	const uchar * bits1 = image1->constScanLine(0);
+	const uchar * bits2 = image2->constScanLine(0);
+	int bytesPerLine = image1->bytesPerLine();
+	for (int y = y1; y < y2; y++) {
+		int offset = y * bytesPerLine;
+		for (int x = x1; x < x2; x++) {
+			//QRgb p1 = image1->pixel(x, y);
+			//if (p1 == 0xffffffff) continue;
+
+			//QRgb p2 = image2->pixel(x, y);
+			//if (p2 == 0xffffffff) continue;
+
+			int byteOffset = (x >> 3) + offset;
+			uchar mask = BitTable[x & 7];
+
+			if ((*(bits1 + byteOffset) & mask) != 0) continue;
+			if ((*(bits2 + byteOffset) & mask) != 0) continue;
+
+			image3->setPixel(x, y, clr);
+			//DebugDialog::debug(QString("p1:%1 p2:%2").arg(p1, 0, 16).arg(p2, 0, 16));
+			result = true;
+			if (points.count() < 1000) {
+				points.append(QPointF(x, y));
+			}
+		}
+	}
+
+	return result;
+}
+
+void DRCBitmap::extendBorder(const double keepout, QImage * image) {
+	Q_ASSERT(image->format() == QImage::Format_Mono);
+	// keepout in terms of the board grid size
+	QImage copy = image->copy();
+
+	const int h = image->height();
+	const int w = image->width();
+	const int ikeepout = qCeil(keepout);
+	for (int y = 0; y < h; y++) {
+		uchar * s = copy.scanLine(y);
+		for (int x = 0; x < w; x++) {
+			if (((*(s + (x >> 3)) >> (~x & 7)) & 1) != 0) {  // if (copy.pixel(x, y) != 1)
+				continue;
+			}
+
+			const int y1 = std::max(y - ikeepout, 0);
+			const int y2 = std::min(y + ikeepout, h);
+			const int x1 = std::max(x - ikeepout, 0);
+			const int x2 = std::min(x + ikeepout, w);
+			// extend border by keepout
+			auto dx = 0;
+			for (int dy = y1; dy < y2; ++dy) {
+				uchar * r = image->scanLine(dy);
+				// This section is often the hotspot for creating copper layers,
+				// especially if shapes are irregular.
+				// We apply a kernel of size 'ikeepout' to the image just
+				// to get the *board* border (not an offset around traces)
+				// Directly calculating this on the vector graphic would be
+				// a thousand times faster: Minkowski sum on a polygon with a small
+				// number of vertices. This is work in progress, using the
+				// Clipper library. However that is a major change, therefore
+				// we are happy with replacing setPixel() for now.
+				for (dx = x1; dx < x2; ++dx) {
+					*(r + (dx >> 3)) &= ~(1 << (7-(dx & 7))); //image->setPixel(dx, dy, 0);
+				}
+			}
+		}
+	}
+}
@@ -18,39 +18,23 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 
 ********************************************************************/
 
-#ifndef SVGPATHRUNNER_H
-#define SVGPATHRUNNER_H
+#ifndef DRCBITMAP_H
+#define DRCBITMAP_H
 
-#include <QVariant>
-#include <QVector>
+#include <QImage>
+#include <QList>
+#include <QPointF>
 
-struct PathCommand {
-	bool relative;
-	int argCount;
-	QChar command;
-};
-
-class SVGPathRunner : public QObject
+// the pixel loops of the DRC on QImage::Format_Mono images (0 is copper or board edge, 1 is free);
+// kept apart from DRC so they can be benchmarked without the sketch classes
+class DRCBitmap
 {
-	Q_OBJECT
-
 public:
-	SVGPathRunner();
-	~SVGPathRunner();
+	static bool pixelsCollide(QImage * image1, QImage * image2, QImage * image3, int x1, int y1, int x2, int y2, uint clr, QList<QPointF> & points);
+	static void extendBorder(double keepoutImagePixels, QImage * image);
 
 public:
-	bool runPath(QVector<QVariant> & pathData, void * userData);
-
-Q_SIGNALS:
-	// note: must connect to this signal via Qt::DirectConnection since args is modified immediately after the signal
-	void commandSignal(QChar command, bool relative, QList<double> & args, void * userData);
-
-protected:
-	static void initStates();
-
-protected:
-	static QHash<QChar, PathCommand *> pathCommands;
-
+	static const uchar BitTable[];
 };
 
-#endif // SVGPATHRUNNER_H
+#endif
@@ -0,0 +1,176 @@
+/*******************************************************************
+
+Part of the Fritzing project - http://fritzing.org
+Copyright (c) 2007-2019 Fritzing
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************/
+
+#include "grid.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+// Obstacle images are Format_Mono, most significant bit first, where a set bit is white (free).
+// Boards are mostly free space, so the transfers below test 64 bits at a time and only look
+// at single pixels inside words that contain something black.
+
+namespace {
+
+inline quint64 loadWord(const uchar * bits) {
+	quint64 word;
+	memcpy(&word, bits, sizeof(word));
+	return word;
+}
+
+constexpr quint64 AllWhite = ~quint64(0);
+
+}
+
+Grid::Grid(int sx, int sy, int sz) : 
+	data(new GridValue[sx * sy * sz]()), // initialize to zero
+	x(sx), y(sy), z(sz) { }
+
+GridValue Grid::at(int sx, int sy, int sz) const {
+    Q_ASSERT (sx < x);
+    Q_ASSERT (sy < y);
+    Q_ASSERT (sz < z);
+	return *(data + (sz * y * x) + (sy * x) + sx);
+}
+
+void Grid::setAt(int sx, int sy, int sz, GridValue value) {
+    Q_ASSERT (sx < x);
+    Q_ASSERT (sy < y);
+    Q_ASSERT (sz < z);
+	*(data + (sz * y * x) + (sy * x) + sx) = value;
+}
+
+QList<QPoint> Grid::init(int sx, int sy, int sz, int width, int height, const QImage & image, GridValue value, bool collectPoints) {
+	// one bit per grid cell
+	QList<QPoint> points;
+	const uchar * bits1 = image.constScanLine(0);
+	int bytesPerLine = image.bytesPerLine();
+	int ex = sx + width;
+	for (int iy = sy; iy < sy + height; iy++) {
+		const uchar * line = bits1 + (iy * bytesPerLine);
+		GridValue * row = data + (sz * y * x) + (iy * x);
+		int ix = sx;
+		while (ix < ex) {
+			if ((ix & 63) == 0 && ix + 64 <= ex && loadWord(line + (ix >> 3)) == AllWhite) {
+				ix += 64;
+				continue;
+			}
+
+			if ((*(line + (ix >> 3)) & (0x80 >> (ix & 7))) == 0) {
+				row[ix] = value;
+				if (collectPoints) {
+					points.append(QPoint(ix, iy));
+				}
+			}
+			ix++;
+		}
+	}
+
+	return points;
+}
+
+
+QList<QPoint> Grid::init4(int sx, int sy, int sz, int width, int height, const QImage * image, GridValue value, bool collectPoints) {
+	// pixels are 4 x 4 bits: a grid cell is free only if all 16 bits are white
+	QList<QPoint> points;
+	const uchar * bits1 = image->constScanLine(0);
+	int bytesPerLine = image->bytesPerLine();
+	int ex = sx + width;
+	for (int iy = sy; iy < sy + height; iy++) {
+		const uchar * line0 = bits1 + (iy * bytesPerLine * 4);
+		const uchar * line1 = line0 + bytesPerLine;
+		const uchar * line2 = line1 + bytesPerLine;
+		const uchar * line3 = line2 + bytesPerLine;
+		GridValue * row = data + (sz * y * x) + (iy * x);
+		int ix = sx;
+		while (ix < ex) {
+			// 16 cells per 64-bit word of each of the four scanlines
+			if ((ix & 15) == 0 && ix + 16 <= ex) {
+				int byteOffset = ix >> 1;
+				quint64 word = loadWord(line0 + byteOffset) & loadWord(line1 + byteOffset) & loadWord(line2 + byteOffset) & loadWord(line3 + byteOffset);
+				if (word == AllWhite) {
+					ix += 16;
+					continue;
+				}
+			}
+
+			int byteOffset = ix >> 1;
+			uchar mask = ix & 1 ? 0x0f : 0xf0;
+			if ((line0[byteOffset] & line1[byteOffset] & line2[byteOffset] & line3[byteOffset] & mask) != mask) {
+				row[ix] = value;
+				if (collectPoints) {
+					points.append(QPoint(ix, iy));
+				}
+			}
+			ix++;
+		}
+	}
+
+	return points;
+}
+
+void Grid::copy(int fromIndex, int toIndex) {
+	memcpy(((uchar *) data) + toIndex * x * y * sizeof(GridValue), ((uchar *) data) + fromIndex * x * y * sizeof(GridValue), x * y * sizeof(GridValue));
+}
+
+void Grid::clear() {
+	// memset can be very dangerous, clear out memory this way
+	std::fill_n(data, x * y * z, 0);
+	present.fill(0);
+	presentNet.fill(-1);
+}
+
+void Grid::initCongestion() {
+	history.fill(0, x * y * z);
+	present.fill(0, x * y * z);
+	presentNet.fill(-1, x * y * z);
+}
+
+int Grid::index(int sx, int sy, int sz) const {
+	if (sx < 0 || sx >= x || sy < 0 || sy >= y || sz < 0 || sz >= z) return -1;
+
+	return (sz * y * x) + (sy * x) + sx;
+}
+
+void Grid::addPresent(int sx, int sy, int sz, int netIndex) {
+	int i = index(sx, sy, sz);
+	if (i < 0 || present.isEmpty()) return;
+
+	// the footprint squares of one net overlap, and so may its traces; count the net once
+	if (presentNet.at(i) == netIndex) return;
+
+	presentNet[i] = netIndex;
+	if (present.at(i) < std::numeric_limits<quint16>::max()) present[i]++;
+}
+
+GridValue Grid::congestion(int sx, int sy, int sz, GridValue presentCost, GridValue historyCost) const {
+	int i = index(sx, sy, sz);
+	if (i < 0 || present.isEmpty()) return 0;
+
+	return (present.at(i) * presentCost) + (history.at(i) * historyCost);
+}
+
+Grid::~Grid() {
+	if (data) {
+		delete [] data;
+		data = nullptr;
+	}
+}
@@ -0,0 +1,59 @@
+/*******************************************************************
+
+Part of the Fritzing project - http://fritzing.org
+Copyright (c) 2007-2019 Fritzing
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************/
+
+#ifndef GRID_H
+#define GRID_H
+
+#include <QImage>
+#include <QList>
+#include <QPoint>
+#include <QVector>
+
+typedef quint64 GridValue;
+
+struct Grid {
+	/// @todo replace this with std::unique_ptr<GridValue[]>
+	GridValue * data = nullptr;
+	int x = 0;
+	int y = 0;
+	int z = 0;
+
+	// negotiated routing only: how often each cell was contested in earlier passes,
+	// and how many other nets cover it in the current pass (presentNet is the last net counted)
+	QVector<quint16> history;
+	QVector<quint16> present;
+	QVector<int> presentNet;
+
+	Grid(int x, int y, int layers);
+    ~Grid();
+
+	GridValue at(int x, int y, int z) const;
+	void setAt(int x, int y, int z, GridValue value);
+	QList<QPoint> init(int x, int y, int z, int width, int height, const QImage &, GridValue value, bool collectPoints);
+	QList<QPoint> init4(int x, int y, int z, int width, int height, const QImage *, GridValue value, bool collectPoints);
+	void clear();
+	void copy(int fromIndex, int toIndex);
+	void initCongestion();
+	int index(int x, int y, int z) const;
+	void addPresent(int x, int y, int z, int netIndex);		// call with the traces grouped by net
+	GridValue congestion(int x, int y, int z, GridValue presentCost, GridValue historyCost) const;
+};
+
+#endif
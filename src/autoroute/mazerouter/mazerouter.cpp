@@ -70,9 +70,11 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include "../../fsvgrenderer.h"
 #include "../drc.h"
 #include "../../connectors/svgidlayer.h"
+#include "../../testing/FProbeTiming.h"
+#include "../../utils/fmessagebox.h"
 
 #include <QApplication>
-#include <QMessageBox>
+#include <QElapsedTimer>
 #include <QSettings>
 
 #include <qmath.h>
@@ -100,6 +102,9 @@ static constexpr uint Layer1Cost = 100;
 static constexpr uint CrossLayerCost = 100;
 static constexpr uint ViaCost = 2000;
 static constexpr uint AvoidCost = 7;
+static constexpr GridValue PresentCost = 50;			// negotiated routing: first pass cost of a cell under another net's trace
+static constexpr GridValue MaxPresentCost = 1 << 20;
+static constexpr GridValue HistoryCost = 25;			// negotiated routing: added for each earlier pass in which a cell was contested
 
 static constexpr uchar GridPointDone = 1;
 static constexpr uchar GridPointStepYPlus = 2;
@@ -318,101 +323,6 @@ bool GridPoint::operator<(const GridPoint& other) const {
 }
 ////////////////////////////////////////////////////////////////////
 
-Grid::Grid(int sx, int sy, int sz) : 
-	data(new GridValue[sx * sy * sz]()), // initialize to zero
-	x(sx), y(sy), z(sz) { }
-
-GridValue Grid::at(int sx, int sy, int sz) const {
-    Q_ASSERT (sx < x);
-    Q_ASSERT (sy < y);
-    Q_ASSERT (sz < z);
-	return *(data + (sz * y * x) + (sy * x) + sx);
-}
-
-void Grid::setAt(int sx, int sy, int sz, GridValue value) {
-    Q_ASSERT (sx < x);
-    Q_ASSERT (sy < y);
-    Q_ASSERT (sz < z);
-	*(data + (sz * y * x) + (sy * x) + sx) = value;
-}
-
-QList<QPoint> Grid::init(int sx, int sy, int sz, int width, int height, const QImage & image, GridValue value, bool collectPoints) {
-	QList<QPoint> points;
-	const uchar * bits1 = image.constScanLine(0);
-	int bytesPerLine = image.bytesPerLine();
-	for (int iy = sy; iy < sy + height; iy++) {
-		int offset = iy * bytesPerLine;
-		for (int ix = sx; ix < sx + width; ix++) {
-			int byteOffset = (ix >> 3) + offset;
-			uchar mask = DRC::BitTable[ix & 7];
-
-			//if (routeNumber > 40) {
-			//    DebugDialog::debug(QString("image %1 %2, %3").arg(image.width()).arg(image.height()).arg(image.isNull()));
-			//    DebugDialog::debug(QString("init point %1 %2 %3").arg(ix).arg(iy).arg(sz));
-			//    DebugDialog::debug(QString("init grid %1 %2 %3, %4").arg(x).arg(y).arg(z).arg((long) data, 0, 16));
-			//}
-			if ((*(bits1 + byteOffset)) & mask) continue;
-
-			//if (routeNumber > 40) DebugDialog::debug("after mask");
-
-			setAt(ix, iy, sz, value);
-			//if (routeNumber > 40)
-			//    DebugDialog::debug("set");
-			if (collectPoints) {
-				points.append(QPoint(ix, iy));
-			}
-		}
-	}
-
-	return points;
-}
-
-
-QList<QPoint> Grid::init4(int sx, int sy, int sz, int width, int height, const QImage * image, GridValue value, bool collectPoints) {
-	// pixels are 4 x 4 bits
-	QList<QPoint> points;
-	const uchar * bits1 = image->constScanLine(0);
-	int bytesPerLine = image->bytesPerLine();
-	for (int iy = sy; iy < sy + height; iy++) {
-		int offset = iy * bytesPerLine * 4;
-		for (int ix = sx; ix < sx + width; ix++) {
-			int byteOffset = (ix >> 1) + offset;
-			uchar mask = ix & 1 ? 0x0f : 0xf0;
-
-			if ((*(bits1 + byteOffset) & mask) != mask) ;
-			else if ((*(bits1 + byteOffset + bytesPerLine) & mask) != mask) ;
-			else if ((*(bits1 + byteOffset + bytesPerLine + bytesPerLine) & mask) != mask) ;
-			else if ((*(bits1 + byteOffset + bytesPerLine + bytesPerLine + bytesPerLine) & mask) != mask) ;
-			else continue;  // "pixel" is all white
-
-			setAt(ix, iy, sz, value);
-			if (collectPoints) {
-				points.append(QPoint(ix, iy));
-			}
-		}
-	}
-
-	return points;
-}
-
-void Grid::copy(int fromIndex, int toIndex) {
-	memcpy(((uchar *) data) + toIndex * x * y * sizeof(GridValue), ((uchar *) data) + fromIndex * x * y * sizeof(GridValue), x * y * sizeof(GridValue));
-}
-
-void Grid::clear() {
-	// memset can be very dangerous, clear out memory this way
-	std::fill_n(data, x * y * z, 0);
-}
-
-Grid::~Grid() {
-	if (data) {
-		delete [] data;
-		data = nullptr;
-	}
-}
-
-////////////////////////////////////////////////////////////////////
-
 
 void Score::setOrdering(const NetOrdering & _ordering) {
 	reorderNet = -1;
@@ -601,9 +511,10 @@ MazeRouter::~MazeRouter()
 
 void MazeRouter::start()
 {
+	FProbeTimer probeTimer("Autoroute");
 	if (m_pcbType) {
 		if (!m_board) {
-			QMessageBox::warning(nullptr, QObject::tr("Fritzing"), QObject::tr("Cannot autoroute: no board (or multiple boards) found"));
+			FMessageBox::warning(nullptr, QObject::tr("Fritzing"), QObject::tr("Cannot autoroute: no board (or multiple boards) found"));
 			return;
 		}
 		m_jumperWillFitFunction = jumperWillFit;
@@ -617,6 +528,7 @@ void MazeRouter::start()
 		m_traceColors[0] = m_traceColors[1] = 0xa0303030;
 	}
 
+	m_negotiate = m_pcbType && m_sketchWidget->getAutorouterNegotiate();
 	m_keepoutPixels = m_sketchWidget->getKeepout();			// 15 mils space (in pixels)
 	m_gridPixels = qMax(m_standardWireWidth, m_keepoutPixels);
 	m_keepoutMils = m_keepoutPixels * GraphicsUtils::StandardFritzingDPI / GraphicsUtils::SVGDPI;
@@ -646,7 +558,7 @@ void MazeRouter::start()
 
 	if (m_allPartConnectorItems.count() == 0) {
 		QString message = m_pcbType ?  QObject::tr("No connections (on the PCB) to route.") : QObject::tr("No connections to route.");
-		QMessageBox::information(nullptr, QObject::tr("Fritzing"), message);
+		FMessageBox::information(nullptr, QObject::tr("Fritzing"), message);
 		Autorouter::cleanUpNets();
 		return;
 	}
@@ -716,7 +628,7 @@ void MazeRouter::start()
 	QSize boardImageSize(qCeil(gridSize.width()), qCeil(gridSize.height()));
 	m_grid = new Grid(boardImageSize.width(), boardImageSize.height(), m_bothSidesNow ? 2 : 1);
 	if (!m_grid->data) {
-		QMessageBox::information(nullptr, QObject::tr("Fritzing"), "Out of memory--unable to proceed");
+		FMessageBox::information(nullptr, QObject::tr("Fritzing"), "Out of memory--unable to proceed");
 		restoreOriginalState(parentCommand);
 		cleanUpNets(netList);
 		return;
@@ -758,36 +670,53 @@ void MazeRouter::start()
 	allOrderings << initialOrdering;
 	Score bestScore;
 	Score currentScore;
+	QElapsedTimer routingTimer;
+	routingTimer.start();
 	auto run = 0;
-	for (; run < m_maxCycles && run < allOrderings.count(); run++) {
-		QString msg= tr("best so far: %1 of %2 routed").arg(bestScore.totalRoutedCount).arg(totalToRoute);
-		if (m_pcbType) {
-			msg +=  tr(" with %n vias", "", bestScore.totalViaCount);
-		}
-		Q_EMIT setProgressMessage(msg);
-		Q_EMIT setCycleMessage(tr("round %1 of:").arg(run + 1));
-		Q_EMIT setProgressValue(run);
-		ProcessEventBlocker::processEvents();
-		currentScore.setOrdering(allOrderings.at(run));
-		currentScore.anyUnrouted = false;
-		routeNets(netList, false, currentScore, gridSize, allOrderings);
-		if (bestScore.ordering.order.count() == 0) {
-			bestScore = currentScore;
-		}
-		else {
-			if (currentScore.totalRoutedCount > bestScore.totalRoutedCount) {
+	if (m_negotiate) {
+		currentScore.setOrdering(initialOrdering);
+		run = negotiateNets(netList, currentScore, gridSize, totalToRoute);
+		bestScore = currentScore;
+	}
+	else {
+		for (; run < m_maxCycles && run < allOrderings.count(); run++) {
+			QString msg= tr("best so far: %1 of %2 routed").arg(bestScore.totalRoutedCount).arg(totalToRoute);
+			if (m_pcbType) {
+				msg +=  tr(" with %n vias", "", bestScore.totalViaCount);
+			}
+			Q_EMIT setProgressMessage(msg);
+			Q_EMIT setCycleMessage(tr("round %1 of:").arg(run + 1));
+			Q_EMIT setProgressValue(run);
+			ProcessEventBlocker::processEvents();
+			currentScore.setOrdering(allOrderings.at(run));
+			currentScore.anyUnrouted = false;
+			routeNets(netList, false, currentScore, gridSize, allOrderings);
+			if (bestScore.ordering.order.count() == 0) {
 				bestScore = currentScore;
 			}
-			else if (currentScore.totalRoutedCount == bestScore.totalRoutedCount && currentScore.totalViaCount < bestScore.totalViaCount) {
-				bestScore = currentScore;
+			else {
+				if (currentScore.totalRoutedCount > bestScore.totalRoutedCount) {
+					bestScore = currentScore;
+				}
+				else if (currentScore.totalRoutedCount == bestScore.totalRoutedCount && currentScore.totalViaCount < bestScore.totalViaCount) {
+					bestScore = currentScore;
+				}
 			}
+			if (m_cancelled || bestScore.anyUnrouted == false || m_stopTracing) break;
 		}
-		if (m_cancelled || bestScore.anyUnrouted == false || m_stopTracing) break;
 	}
 
 	Q_EMIT disableButtons();
 
 	//DebugDialog::debug("done running");
+	DebugDialog::debug(QString("autorouter (%1): %2 rounds in %3 ms, %4 expansions, queue storage allocated %5 times, reused %6 times, peak %7 points")
+			.arg(m_negotiate ? "negotiated" : "orderings")
+			.arg(run)
+			.arg(routingTimer.elapsed())
+			.arg(m_expansions)
+			.arg(m_routeThing.sourceQ.growths + m_routeThing.targetQ.growths)
+			.arg(m_routeThing.sourceQ.reuses + m_routeThing.targetQ.reuses)
+			.arg(qMax(m_routeThing.sourceQ.peak, m_routeThing.targetQ.peak)));
 
 
 	if (m_cancelled) {
@@ -984,11 +913,14 @@ bool MazeRouter::makeMasters(QString & message) {
 
 bool MazeRouter::routeNets(NetList & netList, bool makeJumper, Score & currentScore, const QSizeF gridSize, QList<NetOrdering> & allOrderings)
 {
-	RouteThing routeThing;
+	RouteThing & routeThing = m_routeThing;
 	routeThing.netElements[0] = NetElements();
 	routeThing.netElements[1] = NetElements();
 	routeThing.r = QRectF(QPointF(0, 0), gridSize);
 	routeThing.r4 = QRectF(QPointF(0, 0), gridSize * 4);
+	routeThing.sourceQ.clear();
+	routeThing.targetQ.clear();
+	routeThing.layerSpecs.clear();
 	routeThing.layerSpecs << ViewLayer::NewBottom;
 	if (m_bothSidesNow) routeThing.layerSpecs << ViewLayer::NewTop;
 
@@ -1029,11 +961,7 @@ bool MazeRouter::routeNets(NetList & netList, bool makeJumper, Score & currentSc
 			// should only be here when makeJumpers = true
 			// remove the set of routed traces for this net--the net was not completely routed
 			// we didn't get all the way through before
-			currentScore.totalRoutedCount -= currentScore.routedCount.value(netIndex);
-			currentScore.routedCount.insert(netIndex, 0);
-			currentScore.totalViaCount -= currentScore.viaCount.value(netIndex);
-			currentScore.viaCount.insert(netIndex, 0);
-			currentScore.traces.remove(netIndex);
+			ripUp(currentScore, netIndex);
 		}
 
 		//foreach (ConnectorItem * connectorItem, *(net->net)) {
@@ -1137,8 +1065,8 @@ bool MazeRouter::routeNets(NetList & netList, bool makeJumper, Score & currentSc
 		routeThing.netElements[1].net.clear();
 		routeThing.netElements[1].notNet.clear();
 		routeThing.netElements[1].alsoNet.clear();
-		routeThing.sourceQ = std::priority_queue<GridPoint>();
-		routeThing.targetQ = std::priority_queue<GridPoint>();
+		routeThing.sourceQ.clear();
+		routeThing.targetQ.clear();
 
 		if (!result) break;
 	}
@@ -1146,6 +1074,108 @@ bool MazeRouter::routeNets(NetList & netList, bool makeJumper, Score & currentSc
 	return result;
 }
 
+int MazeRouter::negotiateNets(NetList & netList, Score & score, const QSizeF gridSize, int totalToRoute)
+{
+	// negotiated congestion (as in PathFinder): every net is routed with the traces of the other nets
+	// as extra cost rather than as obstacles; afterwards only the nets whose traces overlap are ripped up
+	// and rerouted. Each round the cost of sharing a cell grows, and contested cells keep a history cost,
+	// until the nets settle on separate paths
+	QList<NetOrdering> allOrderings;			// negotiation never reorders nets
+	m_grid->initCongestion();
+	m_softObstacles = true;
+	m_presentCost = PresentCost;
+
+	auto run = 0;
+	while (run < m_maxCycles) {
+		QString msg = tr("%1 of %2 routed").arg(score.totalRoutedCount).arg(totalToRoute);
+		msg += tr(" with %n vias", "", score.totalViaCount);
+		Q_EMIT setProgressMessage(msg);
+		Q_EMIT setCycleMessage(tr("round %1 of:").arg(run + 1));
+		Q_EMIT setProgressValue(run);
+		ProcessEventBlocker::processEvents();
+
+		run++;
+		score.anyUnrouted = false;
+		routeNets(netList, false, score, gridSize, allOrderings);
+		if (m_cancelled || m_stopTracing) break;
+
+		QSet<int> conflicts = findConflicts(score, true);
+		DebugDialog::debug(QString("negotiated routing round %1: %2 nets overlap, %3 expansions so far").arg(run).arg(conflicts.count()).arg(m_expansions));
+		if (conflicts.isEmpty()) break;
+
+		Q_FOREACH (int netIndex, conflicts) {
+			ripUp(score, netIndex);
+		}
+		m_presentCost = qMin(m_presentCost * 2, MaxPresentCost);
+	}
+
+	m_softObstacles = false;
+	if (m_cancelled || m_stopTracing) return run;
+
+	// whatever still overlaps is routed once more with the other traces as obstacles
+	QSet<int> conflicts = findConflicts(score, false);
+	if (!conflicts.isEmpty()) {
+		Q_FOREACH (int netIndex, conflicts) {
+			ripUp(score, netIndex);
+		}
+		score.anyUnrouted = false;
+		routeNets(netList, false, score, gridSize, allOrderings);
+	}
+
+	return run;
+}
+
+QSet<int> MazeRouter::findConflicts(Score & score, bool updateHistory) {
+	// a net conflicts with another when one of its trace cells lies in the other's footprint,
+	// i.e. where traceObstacles() would have blocked it
+	QSet<int> conflicts;
+	QVector<int> owners(m_grid->x * m_grid->y * m_grid->z, -1);
+	QList<Trace> traces = score.traces.values();
+	Q_FOREACH (Trace trace, traces) {
+		Q_FOREACH (GridPoint gridPoint, trace.gridPoints) {
+			int i = m_grid->index(gridPoint.x, gridPoint.y, gridPoint.z);
+			if (i < 0) continue;
+
+			if (owners.at(i) >= 0 && owners.at(i) != trace.netIndex) {
+				conflicts << owners.at(i) << trace.netIndex;
+			}
+			owners[i] = trace.netIndex;
+		}
+	}
+
+	QBitArray contested(owners.count());
+	Q_FOREACH (Trace trace, traces) {
+		traceFootprint(trace, m_keepoutGridInt, [&](int x, int y, int z) {
+			int i = m_grid->index(x, y, z);
+			if (i < 0) return;
+
+			int owner = owners.at(i);
+			if (owner < 0 || owner == trace.netIndex) return;
+
+			conflicts << owner << trace.netIndex;
+			contested.setBit(i);
+		});
+	}
+
+	if (updateHistory) {
+		for (int i = 0; i < contested.size(); i++) {
+			if (contested.testBit(i) && m_grid->history.at(i) < std::numeric_limits<quint16>::max()) {
+				m_grid->history[i]++;
+			}
+		}
+	}
+
+	return conflicts;
+}
+
+void MazeRouter::ripUp(Score & score, int netIndex) {
+	score.totalRoutedCount -= score.routedCount.value(netIndex);
+	score.routedCount.insert(netIndex, 0);
+	score.totalViaCount -= score.viaCount.value(netIndex);
+	score.viaCount.insert(netIndex, 0);
+	score.traces.remove(netIndex);
+}
+
 bool MazeRouter::routeOne(bool makeJumper, Score & currentScore, int netIndex, RouteThing & routeThing, QList<NetOrdering> & allOrderings) {
 
 	//DebugDialog::debug("start route()");
@@ -1168,7 +1198,7 @@ bool MazeRouter::routeOne(bool makeJumper, Score & currentScore, int netIndex, R
 		}
 		else {
 			routeThing.unrouted = true;
-			if (currentScore.reorderNet < 0) {
+			if (!m_negotiate && currentScore.reorderNet < 0) {
 				for (int i = 0; i < currentScore.ordering.order.count(); i++) {
 					if (currentScore.ordering.order.at(i) == netIndex) {
 						if (moveBack(currentScore, i, allOrderings)) {
@@ -1236,8 +1266,8 @@ bool MazeRouter::routeNext(bool makeJumper, RouteThing & routeThing, QList< QLis
 	auto jp = routeThing.nearest.jc->sceneAdjustedTerminalPoint(nullptr) - m_maxRect.topLeft();
 	routeThing.gridTargetPoint = QPoint(jp.x() / m_gridPixels, jp.y() / m_gridPixels);
 
-	routeThing.sourceQ = std::priority_queue<GridPoint>();
-	routeThing.targetQ = std::priority_queue<GridPoint>();
+	routeThing.sourceQ.clear();
+	routeThing.targetQ.clear();
 
 	if (!m_pcbType) {
 		QList<Trace> traces = currentScore.traces.values();
@@ -1733,6 +1763,7 @@ void MazeRouter::expand(GridPoint & gridPoint, RouteThing & routeThing)
 	//if (debugit) {
 	//    DebugDialog::debug(QString("expand %1 %2 %3, %4").arg(gridPoint.x).arg(gridPoint.y).arg(gridPoint.z).arg(routeThing.pq.size()));
 	//}
+	m_expansions++;
 	if (gridPoint.x > 0) expandOne(gridPoint, routeThing, -1, 0, 0, false);
 	if (gridPoint.x < m_grid->x - 1) expandOne(gridPoint, routeThing, 1, 0, 0, false);
 	if (gridPoint.y > 0) expandOne(gridPoint, routeThing, 0, -1, 0, false);
@@ -1772,7 +1803,7 @@ void MazeRouter::expandOne(GridPoint & gridPoint, RouteThing & routeThing, int d
 	else if (nextval == GridAvoid) {
 		bool contains = true;
 		for (int i = 1; i <= 3; i++) {
-			if (!routeThing.avoids.contains(((next.y - (i * dy)) * m_grid->x) + next.x - (i * dx))) {
+			if (!routeThing.avoided(((next.y - (i * dy)) * m_grid->x) + next.x - (i * dx))) {
 				contains = false;
 				break;
 			}
@@ -1831,6 +1862,9 @@ void MazeRouter::expandOne(GridPoint & gridPoint, RouteThing & routeThing, int d
 		next.baseCost += AvoidCost;
 	}
 	next.baseCost++;
+	if (m_softObstacles) {
+		next.baseCost += m_grid->congestion(next.x, next.y, next.z, m_presentCost, HistoryCost);
+	}
 
 
 	/*
@@ -2038,30 +2072,49 @@ void MazeRouter::displayTrace(Trace & trace) {
 	}
 }
 
-void MazeRouter::traceObstacles(QList<Trace> & traces, int netIndex, Grid * grid, int ikeepout) {
-	// treat traces from previous nets as obstacles
-	Q_FOREACH (Trace trace, traces) {
-		if (trace.netIndex == netIndex) continue;
-
-		int lastZ = trace.gridPoints.at(0).z;
-		Q_FOREACH (GridPoint gridPoint, trace.gridPoints) {
-			if (gridPoint.z != lastZ) {
-				for (int y = -m_halfGridViaSize; y <= m_halfGridViaSize; y++) {
-					for (int x = -m_halfGridViaSize; x <= m_halfGridViaSize; x++) {
-						grid->setAt(gridPoint.x + x, gridPoint.y + y, 0, GridBoardObstacle);
-						grid->setAt(gridPoint.x + x, gridPoint.y + y, 1, GridBoardObstacle);
-					}
+template <typename Visit>
+void MazeRouter::traceFootprint(const Trace & trace, int ikeepout, Visit visit) {
+	// the cells a trace keeps other nets out of: its keepout, and the via size on both layers where it changes layer
+	int lastZ = trace.gridPoints.at(0).z;
+	Q_FOREACH (GridPoint gridPoint, trace.gridPoints) {
+		if (gridPoint.z != lastZ) {
+			for (int y = -m_halfGridViaSize; y <= m_halfGridViaSize; y++) {
+				for (int x = -m_halfGridViaSize; x <= m_halfGridViaSize; x++) {
+					visit(gridPoint.x + x, gridPoint.y + y, 0);
+					visit(gridPoint.x + x, gridPoint.y + y, 1);
 				}
-				lastZ = gridPoint.z;
 			}
-			else {
-				for (int y = -ikeepout; y <= ikeepout; y++) {
-					for (int x = -ikeepout; x <= ikeepout; x++) {
-						grid->setAt(gridPoint.x + x, gridPoint.y + y, gridPoint.z, GridBoardObstacle);
-					}
+			lastZ = gridPoint.z;
+		}
+		else {
+			for (int y = -ikeepout; y <= ikeepout; y++) {
+				for (int x = -ikeepout; x <= ikeepout; x++) {
+					visit(gridPoint.x + x, gridPoint.y + y, gridPoint.z);
 				}
 			}
+		}
+	}
+}
+
+void MazeRouter::traceObstacles(QList<Trace> & traces, int netIndex, Grid * grid, int ikeepout) {
+	QList<Trace> others;
+	Q_FOREACH (Trace trace, traces) {
+		if (trace.netIndex != netIndex) others.append(trace);
+	}
+	if (m_softObstacles) {
+		// Grid::addPresent counts a cell once per net, which needs each net's traces to come together
+		std::stable_sort(others.begin(), others.end(), [](const Trace & t1, const Trace & t2) { return t1.netIndex < t2.netIndex; });
+	}
 
+	// treat traces from previous nets as obstacles
+	Q_FOREACH (Trace trace, others) {
+		if (m_softObstacles) {
+			// when negotiating, other traces only make their cells more expensive
+			int traceNet = trace.netIndex;
+			traceFootprint(trace, ikeepout, [grid, traceNet](int x, int y, int z) { grid->addPresent(x, y, z, traceNet); });
+		}
+		else {
+			traceFootprint(trace, ikeepout, [grid](int x, int y, int z) { grid->setAt(x, y, z, GridBoardObstacle); });
 		}
 
 		if (trace.flags) {
@@ -2081,7 +2134,7 @@ void MazeRouter::traceObstacles(QList<Trace> & traces, int netIndex, Grid * grid
 
 void MazeRouter::traceAvoids(QList<Trace> & traces, int netIndex, RouteThing & routeThing) {
 	// treat traces from previous nets as semi-obstacles
-	routeThing.avoids.clear();
+	routeThing.avoids.fill(false, m_grid->x * m_grid->y);
 	Q_FOREACH (Trace trace, traces) {
 		if (trace.netIndex == netIndex) continue;
 
@@ -2092,7 +2145,8 @@ void MazeRouter::traceAvoids(QList<Trace> & traces, int netIndex, RouteThing & r
 					if (val == GridPartObstacle || val == GridBoardObstacle || val == GridSource || val == GridTarget) continue;
 
 					m_grid->setAt(gridPoint.x + x, gridPoint.y + y, 0, GridAvoid);
-					routeThing.avoids.insert(((gridPoint.y + y) * m_grid->x) + x + gridPoint.x);
+					int index = ((gridPoint.y + y) * m_grid->x) + x + gridPoint.x;
+					if (index >= 0 && index < routeThing.avoids.size()) routeThing.avoids.setBit(index);
 				}
 			}
 		}
@@ -2208,17 +2262,23 @@ void MazeRouter::createTraces(NetList & netList, Score & bestScore, QUndoCommand
 		addJumperToUndo(jumperItem, parentCommand);
 	}
 
+	// traces and their connections go into one compact command rather than five commands per trace
+	auto * addWiresCommand = new AddWiresCommand(m_sketchWidget, parentCommand);
 	Q_FOREACH (QList< QPointer<TraceWire> > bundle, allBundles) {
 		Q_FOREACH (TraceWire * traceWire, bundle) {
-			addWireToUndo(traceWire, parentCommand);
+			addWiresCommand->addWire(traceWire);
 		}
 	}
 
 	Q_FOREACH (ConnectorItem * source, connectionThing.sd.uniqueKeys()) {
 		Q_FOREACH (ConnectorItem * dest, connectionThing.values(source)) {
-			addConnectionToUndo(source, dest, parentCommand);
+			addWiresCommand->addConnection(source, dest);
 		}
 	}
+	DebugDialog::debug(QString("autoroute undo: %1 traces %2 connections in %3 bytes")
+	                   .arg(addWiresCommand->wireCount())
+	                   .arg(addWiresCommand->connectionCount())
+	                   .arg(addWiresCommand->byteCount()));
 
 	QList<ModelPart *> modelParts;
 	Q_FOREACH (QList< QPointer<TraceWire> > bundle, allBundles) {
@@ -2692,18 +2752,6 @@ void MazeRouter::removeStep(int ix, QList<GridPoint> & gridPoints) {
 
 }
 
-void MazeRouter::addConnectionToUndo(ConnectorItem * from, ConnectorItem * to, QUndoCommand * parentCommand)
-{
-	if (from == nullptr || to == nullptr) return;
-
-	auto * ccc = new ChangeConnectionCommand(m_sketchWidget, BaseCommand::CrossView,
-	        from->attachedToID(), from->connectorSharedID(),
-	        to->attachedToID(), to->connectorSharedID(),
-	        ViewLayer::specFromID(from->attachedToViewLayerID()),
-	        true, parentCommand);
-	ccc->setUpdateConnections(false);
-}
-
 void MazeRouter::addViaToUndo(Via * via, QUndoCommand * parentCommand) {
 	new AddItemCommand(m_sketchWidget, BaseCommand::CrossView, ModuleIDNames::ViaModuleIDName, via->viewLayerPlacement(), via->getViewGeometry(), via->id(), false, -1, parentCommand);
 	new SetPropCommand(m_sketchWidget, via->id(), "hole size", via->holeSize(), via->holeSize(), true, parentCommand);
@@ -32,6 +32,7 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include <QProgressDialog>
 #include <QUndoCommand>
 #include <QPointer>
+#include <QBitArray>
 
 #include <limits>
 #include <queue>
@@ -40,8 +41,7 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include "../../viewlayer.h"
 #include "../../commands.h"
 #include "../autorouter.h"
-
-typedef quint64 GridValue;
+#include "grid.h"
 
 struct GridPoint {
 	int x, y, z;
@@ -54,6 +54,27 @@ struct GridPoint {
 	constexpr GridPoint() : x(0), y(0), z(0) { }
 };
 
+// a priority queue whose storage survives clear(), so one queue serves every net in a routing session
+class GridPointQueue : public std::priority_queue<GridPoint>
+{
+public:
+	void push(const GridPoint & gridPoint) {
+		size_t before = c.capacity();
+		std::priority_queue<GridPoint>::push(gridPoint);
+		if (c.capacity() != before) growths++;
+	}
+	void clear() {
+		if (c.capacity() > 0) reuses++;
+		peak = qMax(peak, c.size());
+		c.clear();
+	}
+
+public:
+	int growths = 0;		// times the storage was (re)allocated
+	int reuses = 0;			// times a cleared queue kept its storage for the next search
+	size_t peak = 0;
+};
+
 struct PointZ {
 	QPointF p;
 	int z = 0;
@@ -106,25 +127,6 @@ struct Nearest {
 	ConnectorItem * jc = nullptr;
 };
 
-struct Grid {
-	/// @todo replace this with std::unique_ptr<GridValue[]>
-	GridValue * data = nullptr;
-	int x = 0;
-	int y = 0;
-	int z = 0;
-
-	Grid(int x, int y, int layers);
-    ~Grid();
-
-	GridValue at(int x, int y, int z) const;
-	void setAt(int x, int y, int z, GridValue value);
-	QList<QPoint> init(int x, int y, int z, int width, int height, const QImage &, GridValue value, bool collectPoints);
-	QList<QPoint> init4(int x, int y, int z, int width, int height, const QImage *, GridValue value, bool collectPoints);
-	void clear();
-	void copy(int fromIndex, int toIndex);
-};
-
-
 struct NetElements {
 	QList<QDomElement> net;
 	QList<QDomElement> alsoNet;
@@ -136,8 +138,8 @@ struct RouteThing {
 	QRectF r4;
 	QList<ViewLayer::ViewLayerPlacement> layerSpecs;
 	Nearest nearest;
-	std::priority_queue<GridPoint> sourceQ;
-	std::priority_queue<GridPoint> targetQ;
+	GridPointQueue sourceQ;
+	GridPointQueue targetQ;
 	QPoint gridSourcePoint;
 	QPoint gridTargetPoint;
 	GridValue sourceValue;
@@ -148,7 +150,11 @@ struct RouteThing {
 	GridPoint bestLocationToSource;
 	bool unrouted;
 	NetElements netElements[2];
-	QSet<int> avoids;
+	QBitArray avoids;		// grid cells next to traces of other nets, indexed by y * grid width + x
+
+	bool avoided(int index) const {
+		return index >= 0 && index < avoids.size() && avoids.testBit(index);
+	}
 };
 
 struct TraceThing {
@@ -193,6 +199,10 @@ protected:
 	bool makeBoard(QImage *, double keepout, const QRectF & r);
 	bool makeMasters(QString &);
 	bool routeNets(NetList &, bool makeJumper, Score & currentScore, const QSizeF gridSize, QList<NetOrdering> & allOrderings);
+	int negotiateNets(NetList &, Score &, const QSizeF gridSize, int totalToRoute);
+	QSet<int> findConflicts(Score &, bool updateHistory);
+	void ripUp(Score &, int netIndex);
+	template <typename Visit> void traceFootprint(const Trace &, int ikeepout, Visit visit);
 	bool routeOne(bool makeJumper, Score & currentScore, int netIndex, RouteThing &, QList<NetOrdering> & allOrderings);
 	void findNearestPair(QList< QList<ConnectorItem *> > & subnets, Nearest &);
 	void findNearestPair(QList< QList<ConnectorItem *> > & subnets, int i, QList<ConnectorItem *> & inet, Nearest &);
@@ -222,7 +232,6 @@ protected:
 	void removeStep(int ix, QList<GridPoint> & gridPoints);
 	ConnectorItem * findAnchor(GridPoint gp, TraceThing &, Net * net, QPointF & p, bool & onTrace, ConnectorItem * already);
 	ConnectorItem * findAnchor(GridPoint gp, const QRectF &, TraceThing &, Net * net, QPointF & p, bool & onTrace, ConnectorItem * already);
-	void addConnectionToUndo(ConnectorItem * from, ConnectorItem * to, QUndoCommand * parentCommand);
 	void addViaToUndo(Via *, QUndoCommand * parentCommand);
 	void addJumperToUndo(JumperItem *, QUndoCommand * parentCommand);
 	void routeJumper(int netIndex, RouteThing &, Score & currentScore);
@@ -259,9 +268,14 @@ protected:
 	JumperWillFitFunction m_jumperWillFitFunction;
 	uint m_traceColors[2] = { 0 };
 	Grid * m_grid;
+	RouteThing m_routeThing;		// reused by every net and ordering in one autorouting session
 	int m_cleanupCount;
 	int m_netLabelIndex;
 	int m_commandCount;
+	bool m_negotiate = false;			// rip up and reroute conflicting nets instead of searching net orderings
+	bool m_softObstacles = false;		// traces of other nets cost extra instead of blocking
+	GridValue m_presentCost = 0;
+	qint64 m_expansions = 0;
 };
 
 #endif
@@ -25,6 +25,7 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include "connectors/connectoritem.h"
 #include "items/moduleidnames.h"
 #include "utils/bezier.h"
+#include "testing/FProbeTiming.h"
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -233,14 +234,14 @@ SimulationCommand::SimulationCommand(BaseCommand::CrossViewType crossViewType, S
 void SimulationCommand::undo() {
 	BaseCommand::undo();
 	if(m_mainWindow) {
-		m_mainWindow->triggerSimulator();
+		m_mainWindow->triggerSimulator(m_valueChangeItemID);
 	}
 }
 
 void SimulationCommand::redo() {
 	BaseCommand::redo();
 	if(m_mainWindow) {
-		m_mainWindow->triggerSimulator();
+		m_mainWindow->triggerSimulator(m_valueChangeItemID);
 	}
 }
 
@@ -1150,10 +1151,10 @@ QString ChangeZCommand::getParamString() const {
 
 CheckStickyCommand::CheckStickyCommand(SketchWidget* sketchWidget, BaseCommand::CrossViewType crossViewType, long itemID, bool checkCurrent, CheckType checkType, QUndoCommand *parent)
 	: BaseCommand(crossViewType, sketchWidget, parent),
-	m_itemID(itemID),
 	m_checkCurrent(checkCurrent),
 	m_checkType(checkType)
 {
+	m_itemIDs.append(itemID);
 	m_skipFirstRedo = true;
 }
 
@@ -1185,7 +1186,9 @@ void CheckStickyCommand::redo()
 	if (m_checkType == UndoOnly) return;
 
 	if (m_skipFirstRedo) {
-		m_sketchWidget->checkStickyForCommand(m_itemID, m_crossViewType == BaseCommand::CrossView, m_checkCurrent, this);
+		Q_FOREACH (long itemID, m_itemIDs) {
+			m_sketchWidget->checkStickyForCommand(itemID, m_crossViewType == BaseCommand::CrossView, m_checkCurrent, this);
+		}
 		m_skipFirstRedo = false;
 	}
 	else {
@@ -1203,6 +1206,10 @@ QString CheckStickyCommand::getParamString() const {
 	       .arg(this->m_stickyList.count());
 }
 
+void CheckStickyCommand::addItemID(long itemID) {
+	m_itemIDs.append(itemID);
+}
+
 void CheckStickyCommand::stick(SketchWidget * sketchWidget, long fromID, long toID, bool stickem) {
 	auto * stickyThing = new StickyThing;
 	stickyThing->sketchWidget = sketchWidget;
@@ -1855,6 +1862,7 @@ SetResistanceCommand::SetResistanceCommand(SketchWidget * sketchWidget, long ite
 	m_newPinSpacing(newPinSpacing),
 	m_itemID(itemID)
 {
+	m_valueChangeItemID = itemID;
 }
 
 void SetResistanceCommand::undo() {
@@ -1887,6 +1895,7 @@ SetPropCommand::SetPropCommand(SketchWidget * sketchWidget, long itemID, QString
 	m_newValue(newValue),
 	m_itemID(itemID)
 {
+	m_valueChangeItemID = itemID;
 }
 
 void SetPropCommand::undo() {
@@ -2268,6 +2277,134 @@ QString AddSubpartCommand::getParamString() const {
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+AddWiresCommand::AddWiresCommand(SketchWidget *sketchWidget, QUndoCommand *parent)
+	: SimulationCommand(BaseCommand::CrossView, sketchWidget, parent)
+{
+}
+
+void AddWiresCommand::addWire(Wire * wire)
+{
+	if (wire == nullptr) return;
+
+	ViewGeometry viewGeometry = wire->getViewGeometry();
+	WireRecord record;
+	record.id = wire->id();
+	record.loc = viewGeometry.loc();
+	record.line = viewGeometry.line();
+	record.z = viewGeometry.z();
+	record.width = wire->width();
+	record.opacity = wire->opacity();
+	record.wireFlags = viewGeometry.wireFlags();
+	record.color = stringIndex(wire->colorString());
+	record.viewLayerPlacement = wire->viewLayerPlacement();
+	m_wires.append(record);
+
+	// one sticky check for all the wires, run after they have all been added
+	if (m_checkStickyCommand == nullptr) {
+		m_checkStickyCommand = new CheckStickyCommand(m_sketchWidget, BaseCommand::SingleView, wire->id(), false, CheckStickyCommand::RemoveOnly, nullptr);
+		addSubCommand(m_checkStickyCommand);
+	}
+	else {
+		m_checkStickyCommand->addItemID(wire->id());
+	}
+}
+
+void AddWiresCommand::addConnection(ConnectorItem * from, ConnectorItem * to)
+{
+	if (from == nullptr || to == nullptr) return;
+
+	ConnectionRecord record;
+	record.fromID = from->attachedToID();
+	record.toID = to->attachedToID();
+	record.fromConnectorID = stringIndex(from->connectorSharedID());
+	record.toConnectorID = stringIndex(to->connectorSharedID());
+	record.viewLayerPlacement = ViewLayer::specFromID(from->attachedToViewLayerID());
+	m_connections.append(record);
+}
+
+int AddWiresCommand::stringIndex(const QString & string)
+{
+	int ix = m_stringIndexes.value(string, -1);
+	if (ix >= 0) return ix;
+
+	ix = m_strings.count();
+	m_strings.append(string);
+	m_stringIndexes.insert(string, ix);
+	return ix;
+}
+
+int AddWiresCommand::wireCount() const
+{
+	return m_wires.count();
+}
+
+int AddWiresCommand::connectionCount() const
+{
+	return m_connections.count();
+}
+
+qint64 AddWiresCommand::byteCount() const
+{
+	qint64 bytes = sizeof(AddWiresCommand);
+	bytes += m_wires.capacity() * sizeof(WireRecord);
+	bytes += m_connections.capacity() * sizeof(ConnectionRecord);
+	Q_FOREACH (QString string, m_strings) {
+		bytes += sizeof(QString) + string.capacity() * sizeof(QChar);
+	}
+	// the hash shares the strings' data
+	bytes += m_stringIndexes.capacity() * (sizeof(QString) + sizeof(int) + sizeof(void *));
+	return bytes;
+}
+
+void AddWiresCommand::undo()
+{
+	FProbeTimer probeTimer("AddWiresUndo");
+	for (int i = m_connections.count() - 1; i >= 0; i--) {
+		const ConnectionRecord & record = m_connections.at(i);
+		m_sketchWidget->changeConnection(record.fromID, m_strings.at(record.fromConnectorID),
+		                                 record.toID, m_strings.at(record.toConnectorID),
+		                                 record.viewLayerPlacement,
+		                                 false, m_crossViewType == CrossView, false);
+	}
+	subUndo();
+	for (int i = m_wires.count() - 1; i >= 0; i--) {
+		m_sketchWidget->deleteItemForCommand(m_wires.at(i).id, true, true, false);
+	}
+	SimulationCommand::undo();
+}
+
+void AddWiresCommand::redo()
+{
+	FProbeTimer probeTimer("AddWiresRedo");
+	Q_FOREACH (WireRecord record, m_wires) {
+		ViewGeometry viewGeometry;
+		viewGeometry.setLoc(record.loc);
+		viewGeometry.setLine(record.line);
+		viewGeometry.setZ(record.z);
+		viewGeometry.setWireFlags(record.wireFlags);
+		m_sketchWidget->addItemForCommand(ModuleIDNames::WireModuleIDName, record.viewLayerPlacement, m_crossViewType, viewGeometry, record.id, -1, nullptr);
+		m_sketchWidget->changeWireWidthForCommand(record.id, record.width);
+		m_sketchWidget->changeWireColorForCommand(record.id, m_strings.at(record.color), record.opacity);
+	}
+	subRedo();
+	Q_FOREACH (ConnectionRecord record, m_connections) {
+		m_sketchWidget->changeConnection(record.fromID, m_strings.at(record.fromConnectorID),
+		                                 record.toID, m_strings.at(record.toConnectorID),
+		                                 record.viewLayerPlacement,
+		                                 true, m_crossViewType == CrossView, false);
+	}
+	SimulationCommand::redo();
+}
+
+QString AddWiresCommand::getParamString() const {
+	return QString("AddWiresCommand ")
+	       + BaseCommand::getParamString()
+	       + QString(" wires:%1 connections:%2 bytes:%3")
+	       .arg(m_wires.count()).arg(m_connections.count()).arg(byteCount());
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
 PackItemsCommand::PackItemsCommand(SketchWidget *sketchWidget, int columns, const QList<long> & ids, QUndoCommand *parent)
 	: BaseCommand(BaseCommand::CrossView, sketchWidget, parent),
 	m_columns(columns),
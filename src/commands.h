@@ -116,6 +116,10 @@ public:
 	SimulationCommand(BaseCommand::CrossViewType, SketchWidget * sketchWidget, QUndoCommand *parent);
 	void undo();
 	void redo();
+
+protected:
+	long m_valueChangeItemID = -1;	// set by commands that only change a property value of one part
+
 private:
 	MainWindow* m_mainWindow;
 };
@@ -598,13 +602,14 @@ public:
 	void undo();
 	void redo();
 	void stick(SketchWidget *, long fromID, long toID, bool stickem);
+	void addItemID(long itemID);
 
 
 protected:
 	QString getParamString() const;
 
 protected:
-	long m_itemID = 0;
+	QList<long> m_itemIDs;
 	QList<StickyThing *> m_stickyList;
 	bool m_checkCurrent = false;
 	CheckType m_checkType;
@@ -1185,6 +1190,56 @@ protected:
 
 /////////////////////////////////////////////
 
+// Adds many wires and their connections, e.g. the traces from an autoroute, in one command.
+// Stands in for an AddItemCommand, CheckStickyCommand, WireWidthChangeCommand and
+// WireColorChangeCommand per wire and a ChangeConnectionCommand per connection,
+// keeping only the values those commands would use in flat arrays.
+class AddWiresCommand : public SimulationCommand
+{
+public:
+	AddWiresCommand(class SketchWidget *sketchWidget, QUndoCommand *parent);
+	void addWire(class Wire *);
+	void addConnection(class ConnectorItem * from, class ConnectorItem * to);
+	int wireCount() const;
+	int connectionCount() const;
+	qint64 byteCount() const;
+	void undo();
+	void redo();
+
+protected:
+	QString getParamString() const;
+	int stringIndex(const QString &);
+
+protected:
+	struct WireRecord {
+		qint64 id;
+		QPointF loc;
+		QLineF line;
+		double z;
+		double width;
+		double opacity;
+		ViewGeometry::WireFlags wireFlags;
+		int color;					// index into m_strings
+		ViewLayer::ViewLayerPlacement viewLayerPlacement;
+	};
+
+	struct ConnectionRecord {
+		qint64 fromID;
+		qint64 toID;
+		int fromConnectorID;		// index into m_strings
+		int toConnectorID;
+		ViewLayer::ViewLayerPlacement viewLayerPlacement;
+	};
+
+	QVector<WireRecord> m_wires;
+	QVector<ConnectionRecord> m_connections;
+	QStringList m_strings;
+	QHash<QString, int> m_stringIndexes;		// string -> index into m_strings
+	CheckStickyCommand * m_checkStickyCommand = nullptr;
+};
+
+/////////////////////////////////////////////
+
 class PackItemsCommand : public BaseCommand
 {
 public:
@@ -225,6 +225,7 @@ parts editor support
 #include "../utils/bezierdisplay.h"
 #include "../utils/cursormaster.h"
 #include "ercdata.h"
+#include "../testing/FProbeTiming.h"
 
 /////////////////////////////////////////////////////////
 
@@ -320,6 +321,7 @@ ConnectorItem::ConnectorItem( Connector * connector, ItemBase * attachedTo )
 		connector->addViewItem(this);
 	}
 	setAcceptHoverEvents(true);
+	ItemBase::ConnectivityRevision++;
 	this->setCursor((attachedTo && attachedTo->itemType() == ModelPart::Wire) ? *CursorMaster::BendpointCursor : *CursorMaster::MakeWireCursor);
 
 	//DebugDialog::debug(QString("%1 attached to %2")
@@ -329,6 +331,7 @@ ConnectorItem::ConnectorItem( Connector * connector, ItemBase * attachedTo )
 
 ConnectorItem::~ConnectorItem() {
 	m_equalPotentialDisplayItems.removeOne(this);
+	ItemBase::ConnectivityRevision++;
 	//DebugDialog::debug(QString("deleting connectorItem %1").arg((long) this, 0, 16));
 	Q_FOREACH (ConnectorItem * connectorItem, m_connectedTo) {
 		if (connectorItem) {
@@ -458,6 +461,7 @@ void ConnectorItem::connectTo(ConnectorItem * connected) {
 	if (m_connectedTo.contains(connected)) return;
 
 	m_connectedTo.append(connected);
+	ItemBase::ConnectivityRevision++;
 	//DebugDialog::debug(QString("connect to cc:%4 this:%1 to:%2 %3").arg((long) this, 0, 16).arg((long) connected, 0, 16).arg(connected->attachedTo()->modelPartShared()->title()).arg(m_connectedTo.count()) );
 	QList<ConnectorItem *> visited;
 	restoreColor(visited);
@@ -472,6 +476,7 @@ ConnectorItem * ConnectorItem::removeConnection(ItemBase * itemBase) {
 		if (m_connectedTo[i]->attachedTo() == itemBase) {
 			ConnectorItem * removed = m_connectedTo[i];
 			m_connectedTo.removeAt(i);
+			ItemBase::ConnectivityRevision++;
 			if (m_attachedTo) {
 				m_attachedTo->connectionChange(this, removed, false);
 			}
@@ -493,6 +498,7 @@ void ConnectorItem::removeConnection(ConnectorItem * connectedItem, bool emitCha
 	if (!connectedItem) return;
 
 	m_connectedTo.removeOne(connectedItem);
+	ItemBase::ConnectivityRevision++;
 	QList<ConnectorItem *> visited;
 	restoreColor(visited);
 	if (emitChange) {
@@ -502,6 +508,7 @@ void ConnectorItem::removeConnection(ConnectorItem * connectedItem, bool emitCha
 
 void ConnectorItem::tempConnectTo(ConnectorItem * item, bool applyColor) {
 	if (!m_connectedTo.contains(item)) m_connectedTo.append(item);
+	ItemBase::ConnectivityRevision++;
 
 	if(applyColor) {
 		QList<ConnectorItem *> visited;
@@ -511,6 +518,7 @@ void ConnectorItem::tempConnectTo(ConnectorItem * item, bool applyColor) {
 
 void ConnectorItem::tempRemove(ConnectorItem * item, bool applyColor) {
 	m_connectedTo.removeOne(item);
+	ItemBase::ConnectivityRevision++;
 
 	if(applyColor) {
 		QList<ConnectorItem *> visited;
@@ -1336,6 +1344,8 @@ void ConnectorItem::collectEqualPotential(
 		ViewGeometry::WireFlags skipFlags,
 		bool skipBuses)
 {
+	FProbeTimer probeTimer("CollectEqualPotential");
+
 	// take a local (temporary working) copy of the supplied list, and wipe the original
 	QList<ConnectorItem *> tempItems = connectorItems;
 	connectorItems.clear();
@@ -28,6 +28,7 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include <QEvent>
 #include <QCoreApplication>
 #include <QFile>
+#include <QMutex>
 #include <QTextStream>
 #include <QDir>
 #include <QtDebug>
@@ -150,6 +151,9 @@ void DebugDialog::debug(QString message, DebugLevel debugLevel, QObject * ancest
 
 	qDebug() << message;
 
+	// messages also come from worker threads, e.g. while converting kicad footprints
+	static QMutex fileMutex;
+	QMutexLocker locker(&fileMutex);
 	if (m_file.open(QIODevice::Append | QIODevice::Text)) {
 		QTextStream out(&m_file);
 #if QT_VERSION < QT_VERSION_CHECK(6, 0, 0)
@@ -166,6 +166,7 @@ void PrefsDialog::initBetaFeatures(QWidget * widget)
 	QVBoxLayout * vLayout = new QVBoxLayout();
 	vLayout->addWidget(createSimulatorBetaFeaturesForm());
 	vLayout->addWidget(createGerberBetaFeaturesForm());
+	vLayout->addWidget(createLazyViewsBetaFeaturesForm());
 	vLayout->addSpacerItem(new QSpacerItem(1, 1, QSizePolicy::Preferred, QSizePolicy::Expanding));
 	widget->setLayout(vLayout);
 }
@@ -464,6 +465,32 @@ QWidget * PrefsDialog::createGerberBetaFeaturesForm() {
 	return gerberGroup;
 }
 
+QWidget * PrefsDialog::createLazyViewsBetaFeaturesForm() {
+	QSettings settings;
+	QGroupBox * lazyViewsGroup = new QGroupBox(tr("Opening sketches"), this);
+
+	QVBoxLayout * layout = new QVBoxLayout();
+
+	QLabel * label = new QLabel(tr("Only the visible view is built when a sketch is opened. "
+								   "The other views are built when you switch to them or start editing."));
+	label->setWordWrap(true);
+	layout->addWidget(label);
+	layout->addSpacing(10);
+
+	QCheckBox * box = new QCheckBox(tr("Load views on demand"));
+	box->setFixedWidth(FORMLABELWIDTH * 2);
+	box->setChecked(settings.value("lazyViewLoading", false).toBool());
+	layout->addWidget(box);
+
+	lazyViewsGroup->setLayout(layout);
+
+	connect(box, &QCheckBox::clicked, this, [this](bool checked) {
+		m_settings.insert("lazyViewLoading", QString::number(checked));
+	});
+
+	return lazyViewsGroup;
+}
+
 QWidget * PrefsDialog::createSimulatorBetaFeaturesForm() {
 	QSettings settings;
 	QGroupBox * simulator = new QGroupBox(tr("Simulator"), this);
@@ -66,6 +66,7 @@ protected:
 	QWidget *createProgrammerForm(QList<Platform *> platforms);
 	QWidget *createSimulatorBetaFeaturesForm();
 	QWidget *createGerberBetaFeaturesForm();
+	QWidget *createLazyViewsBetaFeaturesForm();
 	void updateWheelText();
 	void initGeneral(QWidget * general, QFileInfoList & languages);
 	void initBreadboard(QWidget *, ViewInfoThing *);
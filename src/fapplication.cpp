@@ -57,6 +57,16 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include "autoroute/checker.h"
 #include "sketch/sketchwidget.h"
 #include "sketch/pcbsketchwidget.h"
+#include "sketch/netlistcache.h"
+#include "svg/svgprefetch.h"
+#include "autoroute/autoroutersettingsdialog.h"
+#include "autoroute/mazerouter/mazerouter.h"
+#include "items/via.h"
+#include "items/tracewire.h"
+#include "items/moduleidnames.h"
+#include "commands.h"
+#include "routingstatus.h"
+#include "waitpushundostack.h"
 #include "help/firsttimehelpdialog.h"
 #include "help/aboutbox.h"
 #include "version/partschecker.h"
@@ -82,7 +92,16 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include <QMultiHash>
 #include <QTemporaryFile>
 #include <QDir>
+#include <QElapsedTimer>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QtConcurrentRun>
+#include <QFuture>
 #include <time.h>
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
 
 #ifdef LINUX_32
 #define PLATFORM_NAME "linux-32bit"
@@ -380,6 +399,18 @@ int FApplication::init() {
 			toRemove << i;
 		}
 
+		if ((m_arguments[i].compare("-shareddb", Qt::CaseInsensitive) == 0) ||
+		        (m_arguments[i].compare("--shareddb", Qt::CaseInsensitive) == 0)) {
+			SqliteReferenceModel::setSharedDatabase(true);
+			toRemove << i;
+		}
+
+		if ((m_arguments[i].compare("-noprefetch", Qt::CaseInsensitive) == 0) ||
+		        (m_arguments[i].compare("--noprefetch", Qt::CaseInsensitive) == 0)) {
+			SvgPrefetch::setEnabled(false);
+			toRemove << i;
+		}
+
 		if ((m_arguments[i].compare("-ftesting", Qt::CaseInsensitive) == 0) ||
 			(m_arguments[i].compare("--ftesting", Qt::CaseInsensitive) == 0)) {
 			DebugDialog::setEnabled(true);
@@ -510,6 +541,21 @@ int FApplication::init() {
 			toRemove << i << i + 1;
 		}
 
+		if ((m_arguments[i].compare("-b", Qt::CaseInsensitive) == 0) ||
+			(m_arguments[i].compare("-batch", Qt::CaseInsensitive) == 0)||
+			(m_arguments[i].compare("--batch", Qt::CaseInsensitive) == 0)) {
+			m_serviceType = ServiceType::BatchService;
+			DebugDialog::setEnabled(true);
+			m_batchInput = m_arguments[i + 1];
+			toRemove << i << i + 1;
+		}
+
+		if ((m_arguments[i].compare("-outputs", Qt::CaseInsensitive) == 0) ||
+			(m_arguments[i].compare("--outputs", Qt::CaseInsensitive) == 0)) {
+			m_batchOutputs = m_arguments[i + 1].toLower().split(",", Qt::SkipEmptyParts);
+			toRemove << i << i + 1;
+		}
+
 		if (m_arguments[i].compare("-ep", Qt::CaseInsensitive) == 0) {
 			m_externalProcessPath = m_arguments[i + 1];
 			toRemove << i << i + 1;
@@ -832,13 +878,14 @@ MainWindow * FApplication::openWindowForService(bool lockFiles, int initialTab)
 	mainWindow->setReportMissingModules(false);
 	mainWindow->noBackup();
 	mainWindow->noSchematicConversion();
+	mainWindow->setLazyViews(false);
 
 	return mainWindow;
 }
 
 int FApplication::serviceStartup() {
 
-	if (m_outputFolder.isEmpty()) {
+	if (m_outputFolder.isEmpty() && m_batchInput.isEmpty()) {
 		return -1;
 	}
 
@@ -886,6 +933,10 @@ int FApplication::serviceStartup() {
 		runSvgService();
 		return 0;
 
+	case ServiceType::BatchService:
+		runBatchService();
+		return 0;
+
 	case ServiceType::ExampleService:
 		runExampleService();
 		return 0;
@@ -939,7 +990,11 @@ void FApplication::runExportAllServiceAux()
 	QStringList filters;
 	filters << "*" + FritzingBundleExtension;
 	QStringList filenames = dir.entryList(filters, QDir::Files);
+	QElapsedTimer totalTimer;
+	totalTimer.start();
 	Q_FOREACH (QString filename, filenames) {
+		QElapsedTimer timer;
+		timer.start();
 		QString filepath = dir.absoluteFilePath(filename);
 		MainWindow * mainWindow = openWindowForService(false, 3);
 		m_started = true;
@@ -958,7 +1013,9 @@ void FApplication::runExportAllServiceAux()
 
 		mainWindow->setCloseSilently(true);
 		mainWindow->close();
+		DebugDialog::debug(QString("%1 %2: %3 ms").arg("runExportAllServiceAux").arg(filename).arg(timer.elapsed()));
 	}
+	DebugDialog::debug(QString("%1: %2 files in %3 ms").arg("runExportAllServiceAux").arg(filenames.count()).arg(totalTimer.elapsed()));
 }
 
 void FApplication::initService()
@@ -981,7 +1038,11 @@ void FApplication::runSvgServiceAux()
 	QStringList filters;
 	filters << "*" + FritzingBundleExtension;
 	QStringList filenames = dir.entryList(filters, QDir::Files);
+	QElapsedTimer totalTimer;
+	totalTimer.start();
 	Q_FOREACH (QString filename, filenames) {
+		QElapsedTimer timer;
+		timer.start();
 		QString filepath = dir.absoluteFilePath(filename);
 		MainWindow * mainWindow = openWindowForService(false, -1);
 		m_started = true;
@@ -1001,7 +1062,346 @@ void FApplication::runSvgServiceAux()
 
 		mainWindow->setCloseSilently(true);
 		mainWindow->close();
+		DebugDialog::debug(QString("%1 %2: %3 ms").arg("runSvgServiceAux").arg(filename).arg(timer.elapsed()));
+	}
+	DebugDialog::debug(QString("%1: %2 files in %3 ms").arg("runSvgServiceAux").arg(filenames.count()).arg(totalTimer.elapsed()));
+}
+
+/**
+ * Autoroute the PCB view of a batch sketch in one routing mode, and undo it again so the other
+ * mode starts from the same sketch. Returns the time, the routed nets, the vias added
+ * and the undo layouts of the new traces (see batchUndoLayouts).
+ */
+QJsonObject FApplication::batchAutoroute(MainWindow * mainWindow, bool negotiate)
+{
+	QJsonObject result;
+	PCBSketchWidget * pcbView = mainWindow->pcbView();
+	int boardCount;
+	ItemBase * board = pcbView->findSelectedBoard(boardCount);
+	if (board == nullptr) {
+		result["skipped"] = QString("%1 boards").arg(boardCount);
+		return result;
+	}
+
+	auto countVias = [pcbView]() {
+		int count = 0;
+		Q_FOREACH (QGraphicsItem * item, pcbView->scene()->items()) {
+			if (dynamic_cast<Via *>(item) != nullptr) count++;
+		}
+		return count;
+	};
+
+	QHash<QString, QString> settings = pcbView->getAutorouterSettings();
+	settings.insert(AutorouterSettingsDialog::AutorouteNegotiate, negotiate ? "1" : "0");
+	pcbView->setAutorouterSettings(settings);
+
+	QSet<qint64> oldTraceIDs;
+	Q_FOREACH (QGraphicsItem * item, pcbView->scene()->items()) {
+		auto * traceWire = dynamic_cast<TraceWire *>(item);
+		if (traceWire != nullptr) oldTraceIDs.insert(traceWire->id());
+	}
+
+	int vias = countVias();
+	int undoIndex = pcbView->undoStack()->index();
+	QElapsedTimer timer;
+	timer.start();
+	pcbView->scene()->clearSelection();
+	pcbView->setIgnoreSelectionChangeEvents(true);
+	{
+		MazeRouter mazeRouter(pcbView, board, true);
+		mazeRouter.start();
+	}
+	pcbView->setIgnoreSelectionChangeEvents(false);
+	result["time"] = timer.elapsed();
+
+	RoutingStatus routingStatus;
+	routingStatus.zero();
+	pcbView->updateRoutingStatus(routingStatus, true);
+	result["nets"] = routingStatus.m_netCount;
+	result["routed"] = routingStatus.m_netRoutedCount;
+	result["connectorsLeft"] = routingStatus.m_connectorsLeftToRoute;
+	result["jumpers"] = routingStatus.m_jumperItemCount;
+	result["vias"] = countVias() - vias;
+	result["undo"] = batchUndoLayouts(pcbView, oldTraceIDs);
+
+	while (pcbView->undoStack()->index() > undoIndex) {
+		pcbView->undoStack()->undo();
+	}
+
+	return result;
+}
+
+/**
+ * Heap bytes in use, or -1 where the C library can't tell
+ */
+static qint64 heapBytes()
+{
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+	struct mallinfo2 info = mallinfo2();
+	return qint64(info.uordblks + info.hblkhd);
+#else
+	return -1;
+#endif
+}
+
+/**
+ * Stores the traces the autorouter just added in the two undo layouts: one AddWiresCommand, and the
+ * AddItemCommand, CheckStickyCommand, WireWidthChangeCommand and WireColorChangeCommand per trace plus
+ * ChangeConnectionCommand per connection the autorouter used before. Reports the heap each takes and
+ * the time to undo and redo it on the routed board, which is left as it was.
+ */
+QJsonObject FApplication::batchUndoLayouts(PCBSketchWidget * pcbView, const QSet<qint64> & oldTraceIDs)
+{
+	QList<TraceWire *> traceWires;
+	Q_FOREACH (QGraphicsItem * item, pcbView->scene()->items()) {
+		auto * traceWire = dynamic_cast<TraceWire *>(item);
+		if (traceWire != nullptr && !oldTraceIDs.contains(traceWire->id())) {
+			traceWires.append(traceWire);
+		}
+	}
+
+	QList< QPair<ConnectorItem *, ConnectorItem *> > connections;
+	QSet< QPair<ConnectorItem *, ConnectorItem *> > seen;
+	Q_FOREACH (TraceWire * traceWire, traceWires) {
+		Q_FOREACH (ConnectorItem * end, QList<ConnectorItem *>() << traceWire->connector0() << traceWire->connector1()) {
+			if (end == nullptr) continue;
+
+			Q_FOREACH (ConnectorItem * to, end->connectedToItems()) {
+				if (seen.contains(qMakePair(to, end))) continue;
+
+				seen.insert(qMakePair(end, to));
+				connections.append(qMakePair(end, to));
+			}
+		}
+	}
+
+	QJsonObject result;
+	result["traces"] = traceWires.count();
+	result["connections"] = connections.count();
+
+	qint64 heap = heapBytes();
+	auto * addWiresCommand = new AddWiresCommand(pcbView, nullptr);
+	Q_FOREACH (TraceWire * traceWire, traceWires) {
+		addWiresCommand->addWire(traceWire);
+	}
+	for (const auto & connection : connections) {
+		addWiresCommand->addConnection(connection.first, connection.second);
+	}
+	qint64 addWiresHeap = (heap < 0) ? -1 : heapBytes() - heap;
+
+	heap = heapBytes();
+	auto * perTraceCommand = new QUndoCommand();
+	Q_FOREACH (TraceWire * traceWire, traceWires) {
+		ViewGeometry viewGeometry = traceWire->getViewGeometry();
+		new AddItemCommand(pcbView, BaseCommand::CrossView, ModuleIDNames::WireModuleIDName, traceWire->viewLayerPlacement(), viewGeometry, traceWire->id(), false, -1, perTraceCommand);
+		new CheckStickyCommand(pcbView, BaseCommand::SingleView, traceWire->id(), false, CheckStickyCommand::RemoveOnly, perTraceCommand);
+		new WireWidthChangeCommand(pcbView, traceWire->id(), traceWire->width(), traceWire->width(), perTraceCommand);
+		new WireColorChangeCommand(pcbView, traceWire->id(), traceWire->colorString(), traceWire->colorString(), traceWire->opacity(), traceWire->opacity(), perTraceCommand);
+	}
+	for (const auto & connection : connections) {
+		auto * ccc = new ChangeConnectionCommand(pcbView, BaseCommand::CrossView,
+		        connection.first->attachedToID(), connection.first->connectorSharedID(),
+		        connection.second->attachedToID(), connection.second->connectorSharedID(),
+		        ViewLayer::specFromID(connection.first->attachedToViewLayerID()),
+		        true, perTraceCommand);
+		ccc->setUpdateConnections(false);
+	}
+	qint64 perTraceHeap = (heap < 0) ? -1 : heapBytes() - heap;
+
+	// the trace items are deleted by the first undo, so nothing above may be used after this
+	traceWires.clear();
+	connections.clear();
+
+	auto timeLayout = [](QUndoCommand * command, qint64 bytes) {
+		QJsonObject layout;
+		layout["bytes"] = bytes;
+		QElapsedTimer timer;
+		timer.start();
+		command->undo();
+		layout["undo"] = timer.nsecsElapsed() / 1000000.0;
+		timer.restart();
+		command->redo();
+		layout["redo"] = timer.nsecsElapsed() / 1000000.0;
+		return layout;
+	};
+	result["addWires"] = timeLayout(addWiresCommand, addWiresHeap);
+	result["perTrace"] = timeLayout(perTraceCommand, perTraceHeap);
+	result["addWiresEstimate"] = addWiresCommand->byteCount();
+
+	delete addWiresCommand;
+	delete perTraceCommand;
+
+	return result;
+}
+
+/**
+ * The sketches named by the -batch argument: all .fzz files in a folder,
+ * or a text file listing one sketch per line (relative paths are relative to the list)
+ */
+QStringList FApplication::batchSketches(QString & summaryFolder)
+{
+	QStringList filepaths;
+	QFileInfo input(m_batchInput);
+	if (input.isDir()) {
+		QDir dir(input.absoluteFilePath());
+		summaryFolder = dir.absolutePath();
+		QStringList filenames = dir.entryList(QStringList("*" + FritzingBundleExtension), QDir::Files, QDir::Name);
+		Q_FOREACH (QString filename, filenames) {
+			filepaths << dir.absoluteFilePath(filename);
+		}
+		return filepaths;
+	}
+
+	summaryFolder = input.absolutePath();
+	QFile file(input.absoluteFilePath());
+	if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+		DebugDialog::debug(QString("unable to read batch list %1").arg(m_batchInput));
+		return filepaths;
+	}
+
+	QDir dir(summaryFolder);
+	QTextStream in(&file);
+	while (!in.atEnd()) {
+		QString line = in.readLine().trimmed();
+		if (line.isEmpty() || line.startsWith("#")) continue;
+
+		filepaths << QFileInfo(dir, line).absoluteFilePath();
+	}
+	return filepaths;
+}
+
+/**
+ * Export many sketches in one process. The reference model, the part caches and the svg renderer
+ * caches are loaded once and stay warm for the whole run. Exported text files are written on a
+ * worker thread while the next sketch is loading. Per-file timings go to fritzing_batch.json.
+ */
+void FApplication::runBatchService()
+{
+	static const QStringList AllOutputs = { "gerber", "svg", "bom", "netlist", "ipc" };
+	static const QStringList ExtraOutputs = { "autoroute" };		// only when asked for
+
+	QElapsedTimer totalTimer;
+	totalTimer.start();
+	FMessageBox::BlockMessages = true;
+	initService();
+	qint64 initTime = totalTimer.elapsed();
+
+	QStringList outputs = m_batchOutputs.isEmpty() ? AllOutputs : m_batchOutputs;
+	Q_FOREACH (QString output, outputs) {
+		if (!AllOutputs.contains(output) && !ExtraOutputs.contains(output)) {
+			DebugDialog::debug(QString("unknown batch output %1").arg(output));
+		}
+	}
+
+	QString summaryFolder;
+	QStringList filepaths = batchSketches(summaryFolder);
+
+	QList< QFuture<bool> > writes;
+	auto writeText = [&writes](const QString & filename, const QString & text) {
+		writes << QtConcurrent::run([filename, text]() { return TextUtils::writeUtf8(filename, text); });
+	};
+
+	QJsonArray files;
+	int failures = 0;
+	Q_FOREACH (QString filepath, filepaths) {
+		QFileInfo info(filepath);
+		QString basename = info.completeBaseName();
+		QDir outputDir = info.absoluteDir();
+		QJsonObject timings;
+		QJsonObject result;
+		result["file"] = filepath;
+
+		QElapsedTimer fileTimer;
+		fileTimer.start();
+		QElapsedTimer timer;
+		timer.start();
+		MainWindow * mainWindow = openWindowForService(false, 3);
+		m_started = true;
+		timings["window"] = timer.restart();
+
+		FolderUtils::setOpenSaveFolderAux(outputDir.absolutePath());
+		bool loaded = info.exists() && mainWindow->loadWhich(filepath, false, false, false, "");
+		timings["load"] = timer.restart();
+		result["loaded"] = loaded;
+		int prepared, used, direct;
+		SvgPrefetch::lastCounts(prepared, used, direct);
+		QJsonObject prefetch;
+		prefetch["prepared"] = prepared;
+		prefetch["used"] = used;
+		prefetch["direct"] = direct;
+		result["svgPrefetch"] = prefetch;
+
+		if (loaded) {
+			if (outputs.contains("gerber")) {
+				GerberGenerator::exportToGerber(basename, outputDir.absolutePath(), nullptr, mainWindow->pcbView(), false);
+				timings["gerber"] = timer.restart();
+			}
+			if (outputs.contains("svg")) {
+				QList<ViewLayer::ViewID> ids;
+				ids << ViewLayer::BreadboardView << ViewLayer::SchematicView << ViewLayer::PCBView;
+				Q_FOREACH (ViewLayer::ViewID id, ids) {
+					QString fn = QString("%1_%2.svg").arg(basename).arg(ViewLayer::viewIDNaturalName(id));
+					mainWindow->setCurrentView(id);
+					mainWindow->exportSvg(GraphicsUtils::StandardFritzingDPI, false, false, outputDir.absoluteFilePath(fn));
+				}
+				timings["svg"] = timer.restart();
+			}
+			// the bom and the netlist are taken from the current view, which the svg export changes
+			mainWindow->setCurrentView(ViewLayer::PCBView);
+			if (outputs.contains("bom")) {
+				writeText(outputDir.absoluteFilePath(basename + "_bom.csv"), mainWindow->getExportBOM_CSV());
+				timings["bom"] = timer.restart();
+			}
+			if (outputs.contains("netlist")) {
+				writeText(outputDir.absoluteFilePath(basename + "_netlist.xml"), mainWindow->getExportNetlist());
+				timings["netlist"] = timer.restart();
+			}
+			if (outputs.contains("ipc")) {
+				writeText(outputDir.absoluteFilePath(basename + ".ipc"), mainWindow->exportIPC_D_356A());
+				timings["ipc"] = timer.restart();
+			}
+			if (outputs.contains("autoroute")) {
+				QJsonObject autoroute;
+				autoroute["orderings"] = batchAutoroute(mainWindow, false);
+				autoroute["negotiated"] = batchAutoroute(mainWindow, true);
+				result["autoroute"] = autoroute;
+				timings["autoroute"] = timer.restart();
+			}
+			result["netlistCacheHits"] = mainWindow->netlistCache()->hits();
+			result["netlistCacheMisses"] = mainWindow->netlistCache()->misses();
+		}
+		else {
+			failures++;
+		}
+
+		mainWindow->setCloseSilently(true);
+		mainWindow->close();
+		timings["close"] = timer.elapsed();
+		result["timings"] = timings;
+		result["total"] = fileTimer.elapsed();
+		files.append(result);
+		DebugDialog::debug(QString("%1 %2: %3 ms").arg("runBatchService").arg(info.fileName()).arg(fileTimer.elapsed()));
 	}
+
+	int writeFailures = 0;
+	for (QFuture<bool> & write : writes) {
+		if (!write.result()) writeFailures++;
+	}
+
+	QJsonObject summary;
+	summary["version"] = Version::versionString();
+	summary["outputs"] = QJsonArray::fromStringList(outputs);
+	summary["init"] = initTime;
+	summary["total"] = totalTimer.elapsed();
+	summary["failed"] = failures;
+	summary["writeFailures"] = writeFailures;
+	summary["files"] = files;
+
+	QString summaryPath = QDir(summaryFolder).absoluteFilePath("fritzing_batch.json");
+	if (!TextUtils::writeUtf8(summaryPath, QJsonDocument(summary).toJson())) {
+		DebugDialog::debug(QString("unable to write batch summary %1").arg(summaryPath));
+	}
+	DebugDialog::debug(QString("%1: %2 files in %3 ms").arg("runBatchService").arg(filepaths.count()).arg(totalTimer.elapsed()));
 }
 
 void FApplication::runDatabaseService()
@@ -1103,31 +1503,26 @@ void FApplication::runKicadFootprintService() {
 	QStringList filenames = dir.entryList(filters, QDir::Files);
 	Q_FOREACH (QString filename, filenames) {
 		QString filepath = dir.absoluteFilePath(filename);
-		QStringList moduleNames = KicadModule2Svg::listModules(filepath);
-		Q_FOREACH (QString moduleName, moduleNames) {
-			KicadModule2Svg kicad;
-			try {
-				QString svg = kicad.convert(filepath, moduleName, false);
-				if (svg.isEmpty()) {
-					DebugDialog::debug("svg is empty " + filepath + " " + moduleName);
-					continue;
-				}
-				Q_FOREACH (QChar c, QString("<>:\"/\\|?*")) {
-					moduleName.remove(c);
-				}
-
-				QString newFilePath = dir.absoluteFilePath(moduleName + "_" + filename);
-				newFilePath.replace(".mod", ".svg");
-
-				if (!TextUtils::writeUtf8(newFilePath, svg)) {
-					DebugDialog::debug("unable to open file " + newFilePath);
-				}
+		Q_FOREACH (KicadModule2Svg::ConvertedModule converted, KicadModule2Svg::convertLibrary(filepath, false)) {
+			if (!converted.error.isEmpty()) {
+				DebugDialog::debug(converted.error);
+				continue;
 			}
-			catch (const QString & msg) {
-				DebugDialog::debug(msg);
+			if (converted.svg.isEmpty()) {
+				DebugDialog::debug("svg is empty " + filepath + " " + converted.name);
+				continue;
 			}
-			catch (...) {
-				DebugDialog::debug("who knows");
+
+			QString moduleName = converted.name;
+			Q_FOREACH (QChar c, QString("<>:\"/\\|?*")) {
+				moduleName.remove(c);
+			}
+
+			QString newFilePath = dir.absoluteFilePath(moduleName + "_" + filename);
+			newFilePath.replace(".mod", ".svg");
+
+			if (!TextUtils::writeUtf8(newFilePath, converted.svg)) {
+				DebugDialog::debug("unable to open file " + newFilePath);
 			}
 		}
 	}
@@ -34,6 +34,8 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include <QThread>
 #include <QNetworkReply>
 #include <QNetworkAccessManager>
+#include <QJsonObject>
+#include <QSet>
 
 #include "referencemodel/referencemodel.h"
 
@@ -171,6 +173,10 @@ protected:
 	void runExportAllServiceAux();
 	void runSvgService();
 	void runSvgServiceAux();
+	void runBatchService();
+	QStringList batchSketches(QString & summaryFolder);
+	QJsonObject batchAutoroute(class MainWindow *, bool negotiate);
+	QJsonObject batchUndoLayouts(class PCBSketchWidget *, const QSet<qint64> & oldTraceIDs);
 	void runExampleService();
 	void runExampleService(QDir &);
 	QList<class MainWindow *> recoverBackups();
@@ -198,6 +204,7 @@ protected:
 		PortService,
 		DRCService,
 		ExportAllService,
+		BatchService,
 		NoService
 	};
 
@@ -222,6 +229,8 @@ protected:
 	int m_progressIndex = 0;
 	class FSplashScreen * m_splash = nullptr;
 	QString m_outputFolder;
+	QString m_batchInput;
+	QStringList m_batchOutputs;
 	QString m_portRootFolder;
 	QString m_panelFilename;
 	QHash<QString, struct LockedFile *> m_lockedFiles;
@@ -32,6 +32,7 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include "../fsvgrenderer.h"
 #include "../svg/svgfilesplitter.h"
 #include "../svg/svgflattener.h"
+#include "../svg/svgprefetch.h"
 #include "../utils/folderutils.h"
 #include "../utils/textutils.h"
 #include "../utils/graphicsutils.h"
@@ -101,6 +102,8 @@ QBrush ItemBase::UnconnectedBrush(StandardUnconnectedColor);
 QBrush ItemBase::ChosenBrush(QColor(255,0,0));
 QBrush ItemBase::EqualPotentialBrush(QColor(255,255,0));
 
+quint64 ItemBase::ConnectivityRevision = 0;
+
 static QHash<QString, QStringList> CachedValues;
 
 ///////////////////////////////////////////////////
@@ -118,12 +121,14 @@ ItemBase::ItemBase( ModelPart* modelPart, ViewLayer::ViewID viewID, const ViewGe
 		m_modelPart->addViewItem(this);
 	}
 	setCursor(*CursorMaster::MoveCursor);
+	ConnectivityRevision++;
 
 	setAcceptHoverEvents ( true );
 }
 
 ItemBase::~ItemBase() {
 	//DebugDialog::debug(QString("deleting itembase %1 %2 %3").arg((long) this, 0, 16).arg(m_id).arg((long) m_modelPart, 0, 16));
+	ConnectivityRevision++;
 	if (m_partLabel != nullptr) {
 		delete m_partLabel;
 		m_partLabel = nullptr;
@@ -1369,48 +1374,33 @@ FSvgRenderer * ItemBase::setUpImage(ModelPart * modelPart, LayerAttributes & lay
 		break;
 	}
 
-	auto * newRenderer = new FSvgRenderer();
 	QDomDocument flipDoc;
 	getFlipDoc(modelPart, filename, layerAttributes.viewLayerID, layerAttributes.viewLayerPlacement, flipDoc, layerAttributes.orientation);
+	bool multipleLayers = (layerAttributes.viewID != ViewLayer::IconView) && modelPartShared->hasMultipleLayers(layerAttributes.viewID);
 	QByteArray bytesToLoad;
-	if (layerAttributes.viewLayerID == ViewLayer::Schematic) {
-		bytesToLoad = SvgFileSplitter::hideText(filename);
-	}
-	else if (layerAttributes.viewLayerID == ViewLayer::SchematicText) {
-		bool hasText = false;
-		bytesToLoad = SvgFileSplitter::showText(filename, hasText);
+	if (flipDoc.isNull() || layerAttributes.viewLayerID == ViewLayer::Schematic || layerAttributes.viewLayerID == ViewLayer::SchematicText) {
+		// may already have been prepared on a worker thread while loading a sketch
+		bool hasText = true;
+		bytesToLoad = SvgPrefetch::layerBytes(filename, layerAttributes.viewLayerID, multipleLayers, hasText);
 		if (!hasText) {
 			return nullptr;
 		}
 	}
-	else if ((layerAttributes.viewID != ViewLayer::IconView) && modelPartShared->hasMultipleLayers(layerAttributes.viewID)) {
+	else if (multipleLayers) {
 		QString layerName = ViewLayer::viewLayerXmlNameFromID(layerAttributes.viewLayerID);
 		// need to treat create "virtual" svg file for each layer
 		SvgFileSplitter svgFileSplitter;
-		bool result;
-		if (flipDoc.isNull()) {
-			result = svgFileSplitter.split(filename, layerName);
-		}
-		else {
-			QString f = flipDoc.toString();
-			result = svgFileSplitter.splitString(f, layerName);
-		}
-		if (result) {
+		QString f = flipDoc.toString();
+		if (svgFileSplitter.splitString(f, layerName)) {
 			bytesToLoad = svgFileSplitter.byteArray();
 		}
 	}
 	else {
-		// only one layer, just load it directly
-		if (flipDoc.isNull()) {
-			QFile file(filename);
-			file.open(QFile::ReadOnly);
-			bytesToLoad = file.readAll();
-		}
-		else {
-			bytesToLoad = flipDoc.toByteArray();
-		}
+		bytesToLoad = flipDoc.toByteArray();
 	}
 
+	auto * newRenderer = new FSvgRenderer();
+
 	QByteArray resultBytes;
 	if (!bytesToLoad.isEmpty()) {
 		if (makeLocalModifications(bytesToLoad, filename)) {
@@ -1460,6 +1450,22 @@ void ItemBase::updateConnectionsAux(bool includeRatsnest, QList<ConnectorItem *>
 void ItemBase::figureHover() {
 }
 
+/**
+ * The svg of this item as last rendered by SketchWidget::renderToSVG, before it is moved to the item's position.
+ * @param key the layer and render options the fragment was made with
+ */
+QString ItemBase::renderSvgFragment(const QString & key) const {
+	return m_renderSvgFragments.value(key);
+}
+
+void ItemBase::setRenderSvgFragment(const QString & key, const QString & svg) {
+	m_renderSvgFragments.insert(key, svg);
+}
+
+void ItemBase::clearRenderSvgFragments() {
+	m_renderSvgFragments.clear();
+}
+
 QString ItemBase::retrieveSvg(ViewLayer::ViewLayerID /* viewLayerID */,  QHash<QString, QString> & /* svgHash */, bool /* blackOnly */, double /* dpi */, double & factor)
 {
 	factor = 1;
@@ -1589,6 +1595,7 @@ void ItemBase::setProp(const QString & prop, const QString & value) {
 
 	//DebugDialog::debug(QString("setting prop %1 %2").arg(prop).arg(value));
 	m_modelPart->setLocalProp(prop, value);
+	clearRenderSvgFragments();
 }
 
 QString ItemBase::prop(const QString & p)
@@ -2046,6 +2053,7 @@ FSvgRenderer * ItemBase::fsvgRenderer() const {
 }
 
 void ItemBase::setSharedRendererEx(FSvgRenderer * newRenderer) {
+	clearRenderSvgFragments();
 	if (newRenderer != m_fsvgRenderer) {
 		setSharedRenderer(newRenderer);  // original renderer is deleted if it is not shared
 		if (m_fsvgRenderer != nullptr) delete m_fsvgRenderer;
@@ -2062,6 +2070,7 @@ bool ItemBase::reloadRenderer(const QString & svg, bool fastLoad) {
 	if (!svg.isEmpty()) {
 		//DebugDialog::debug(svg);
 		prepareGeometryChange();
+		clearRenderSvgFragments();
 		bool result = fastLoad ? fsvgRenderer()->fastLoad(svg.toUtf8()) : fsvgRenderer()->loadSvgString(svg.toUtf8());
 		if (result) {
 			update();
@@ -180,6 +180,9 @@ public:
 	void contextMenuEvent(QGraphicsSceneContextMenuEvent *event);
 	virtual void figureHover();
 	virtual QString retrieveSvg(ViewLayer::ViewLayerID, QHash<QString, QString> & svgHash, bool blackOnly, double dpi, double & factor);
+	QString renderSvgFragment(const QString & key) const;
+	void setRenderSvgFragment(const QString & key, const QString & svg);
+	virtual void clearRenderSvgFragments();
 	virtual void slamZ(double newZ);
 	bool isEverVisible();
 	void setEverVisible(bool);
@@ -230,6 +233,7 @@ public:
 	QString family();
 	QPixmap * getPixmap(QSize size);
 	FSvgRenderer * fsvgRenderer() const;
+	bool hasFsvgRenderer() const noexcept { return m_fsvgRenderer != nullptr; }
 	void setSharedRendererEx(FSvgRenderer *);
 	bool reloadRenderer(const QString & svg, bool fastload);
 	bool resetRenderer(const QString & svg);
@@ -398,6 +402,7 @@ protected:
 	bool m_squashShape = false;
 	QPainterPath m_selectionShape;
 	QGraphicsObject * m_simItem = nullptr;
+	QHash<QString, QString> m_renderSvgFragments;		// SketchWidget::renderToSVG output, cleared whenever the svg changes or the undo stack moves
 
 protected:
 	static long nextID;
@@ -409,6 +414,7 @@ public:
 	static QHash<QString, QString> TranslatedPropertyNames;
 	static QString PartInstanceDefaultTitle;
 	static const QList<ItemBase *> EmptyList;
+	static quint64 ConnectivityRevision;		// bumped when items or connectors come and go or connections change
 	const static QColor HoverColor;
 	const static double HoverOpacity;
 	const static QColor ConnectorHoverColor;
@@ -312,6 +312,7 @@ QString JumperItem::makeSvg(ViewLayer::ViewLayerID viewLayerID)
 	modelPart()->setLocalProp("r0y", r0y);
 	modelPart()->setLocalProp("r1x", r1x);
 	modelPart()->setLocalProp("r1y", r1y);
+	clearRenderSvgFragments();
 
 	switch (viewLayerID) {
 	case ViewLayer::Copper0:
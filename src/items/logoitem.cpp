@@ -27,7 +27,7 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include "../svg/svgfilesplitter.h"
 #include "../svg/gerbergenerator.h"
 #include "moduleidnames.h"
-#include "../svg/groundplanegenerator.h"
+#include "../svg/bitmaptracer.h"
 #include "../utils/cursormaster.h"
 #include "../debugdialog.h"
 
@@ -432,11 +432,8 @@ void LogoItem::loadImage(const QString & fileName, bool addName)
 		if (this->m_standardizeColors) {
 			image = image.convertToFormat(QImage::Format_Mono);
 			double res = image.dotsPerMeterX() / GraphicsUtils::InchesPerMeter;
-			GroundPlaneGenerator gpg;
-			gpg.setLayerName(layerName());
-			gpg.setMinRunSize(1, 1);
-			gpg.scanImage(image, image.width(), image.height(), 1, res, colorString(), false, false, QSizeF(0, 0), 0, QPointF(0, 0));
-			if (gpg.newSVGs().count() < 1) {
+			svg = BitmapTracer::traceSvg(image, res, colorString(), layerName());
+			if (svg.isEmpty()) {
 				FMessageBox::information(
 				    nullptr,
 				    tr("Unable to display"),
@@ -444,8 +441,6 @@ void LogoItem::loadImage(const QString & fileName, bool addName)
 				);
 				return;
 			}
-
-			svg = gpg.mergeSVGs("", layerName());
 		}
 		else {
 			double res = image.dotsPerMeterX() / GraphicsUtils::InchesPerMeter;
@@ -588,6 +583,7 @@ void LogoItem::setLogo(QString logo, bool force) {
 	m_logo = logo;
 	modelPart()->setLocalProp("logo", logo);
 	modelPart()->setLocalProp("shape", svg);
+	clearRenderSvgFragments();
 	if (ok && !force) {
 		QSizeF newSvgSize = fsvgRenderer()->viewBoxF().size();
 		QSizeF newSize = newSvgSize * oldSize.height() / oldSvgSize.height();
@@ -102,6 +102,7 @@ void MysteryPart::setChipLabel(QString chipLabel, bool force) {
 	}
 
 	modelPart()->setLocalProp("chip label", chipLabel);
+	clearRenderSvgFragments();
 
 	if (m_partLabel != nullptr) m_partLabel->displayTextsIf();
 }
@@ -445,6 +445,7 @@ void Note::contentsChangedSlot() {
 	if (m_modelPart != nullptr) {
 		m_modelPart->setInstanceText(m_graphicsTextItem->document()->toHtml());
 	}
+	clearRenderSvgFragments();
 }
 
 void Note::checkSize(QSizeF & newSize) {
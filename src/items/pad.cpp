@@ -302,6 +302,7 @@ void Pad::setInitialSize() {
 		modelPart()->setLocalProp("width", GraphicsUtils::pixels2mm(OriginalWidth, GraphicsUtils::SVGDPI));
 		modelPart()->setLocalProp("height", GraphicsUtils::pixels2mm(OriginalHeight, GraphicsUtils::SVGDPI));
 		modelPart()->setLocalProp("connect", "center");
+		clearRenderSvgFragments();
 	}
 }
 
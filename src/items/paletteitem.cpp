@@ -300,6 +300,13 @@ void PaletteItem::flipItem(Qt::Orientations orientation) {
 	}
 }
 
+void PaletteItem::clearRenderSvgFragments() {
+	PaletteItemBase::clearRenderSvgFragments();
+	Q_FOREACH (ItemBase * lkpi, m_layerKin) {
+		lkpi->clearRenderSvgFragments();
+	}
+}
+
 void PaletteItem::transformItem2(const QTransform & matrix) {
 	PaletteItemBase::transformItem2(matrix);
 	Q_FOREACH (ItemBase * lkpi, m_layerKin) {
@@ -84,6 +84,7 @@ public:
 	void moveItem(ViewGeometry & viewGeometry);
 	void transformItem2(const QTransform &);
 	void setItemPos(QPointF & pos);
+	void clearRenderSvgFragments();
 
 	bool renderImage(ModelPart * modelPart, ViewLayer::ViewID viewID, const LayerHash & viewLayers, ViewLayer::ViewLayerID, bool doConnectors, QString & error);
 
@@ -578,6 +578,7 @@ void Stripboard::reinitBuses(bool triggerUndo)
 	modelPart()->clearBuses();
 	modelPart()->initBuses();
 	modelPart()->setLocalProp("buses",  busPropertyString);
+	clearRenderSvgFragments();
 
 
 
@@ -272,6 +272,7 @@ void SymbolPaletteItem::setVoltage(double v) {
 
 	m_voltage = v;
 	m_modelPart->setLocalProp("voltage", v);
+	clearRenderSvgFragments();
 	if (!Voltages.contains(v)) {
 		Voltages.append(v);
 	}
@@ -127,6 +127,10 @@ int main(int argc, char *argv[])
 			     "Options:\n"
 			     "\n"
 			     "User options:\n"
+			     "  -b, -batch FOLDER|LIST        export all sketches in FOLDER, or listed one per line in the text file LIST,\n"
+			     "                                in one process, next to each sketch; timings are written to fritzing_batch.json\n"
+			     "  -outputs LIST                 with -batch, comma separated outputs among gerber,svg,bom,netlist,ipc (default all)\n"
+			     "                                and autoroute, which routes the pcb both ways and undoes it\n"
 			     "  -d, -debug                    run Fritzing in debug mode, providing additional debug information\n"
 			     //" drc filename : runs a design rule check on the given sketch file\n"
 			     "  -f, -folder FOLDER            use Fritzing parts, sketches, bins and translations in folders under FOLDER\n"
@@ -136,6 +140,8 @@ int main(int argc, char *argv[])
 			     "  -kicad FOLDER                 convert all Kicad footprint (.mod) files in FOLDER to Fritzing SVGs\n"
 			     "  -kicadschematic FOLDER        convert all Kicad schematic (.lib) files in FOLDER to Fritzing SVGs\n"
 			     "  -port NUMBER                  run Fritzing as a server process on port NUMBER\n"
+			     "  -shareddb                     read the parts database in place, read-only and memory mapped, instead of\n"
+			     "                                copying it into each process; for running several exporters on one host\n"
 			     "  -svg FOLDER                   export all sketches in FOLDER to SVGs of all views, in the same folder\n"
 			     "\n"
 			     "Administrator option:\n"
@@ -146,8 +152,9 @@ int main(int argc, char *argv[])
 			     "  -ep FILE                      add menu item for external process using executable FILE\n"
 			     "  -eparg ARGS                   with -ep, external process arguments ARGS\n"
 			     "  -epname NAME                  with -ep, external process menu item NAME\n"
+			     "  -noprefetch                   read part svgs on the gui thread only while loading, to compare load times\n"
 			     "\n"
-			     "The -geda, -kicad, -kicadschematic, -gerber SVG options all exit Fritzing after the conversion process is complete;\n"
+			     "The -geda, -kicad, -kicadschematic, -gerber, -batch SVG options all exit Fritzing after the conversion process is complete;\n"
 			     "these options are mutually exclusive.\n"
 			     "\n"
 #ifndef PKGDATADIR
@@ -32,6 +32,7 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include <QPaintDevice>
 #include <QPixmap>
 #include <QTimer>
+#include <QElapsedTimer>
 #include <QStackedWidget>
 #include <QXmlStreamReader>
 #include <QShortcut>
@@ -49,6 +50,7 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include "../sketch/schematicsketchwidget.h"
 #include "../sketch/pcbsketchwidget.h"
 #include "../sketch/welcomeview.h"
+#include "../sketch/netlistcache.h"
 #include "../utils/folderutils.h"
 #include "../utils/fmessagebox.h"
 #include "../utils/lockmanager.h"
@@ -75,6 +77,7 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include "../simulation/simulator.h"
 #include "../simulation/FProbeStartSimulator.h"
 #include "../mainwindow/FProbeDropByModuleID.h"
+#include "../testing/FProbeTiming.h"
 
 FTabWidget::FTabWidget(QWidget * parent) : QTabWidget(parent)
 {
@@ -249,6 +252,7 @@ MainWindow::MainWindow(ReferenceModel *referenceModel, QWidget * parent) :
 {
 	m_noSchematicConversion = m_useOldSchematic = m_convertedSchematic = false;
 	m_initialTab = 1;
+	m_lazyViews = QSettings().value("lazyViewLoading", false).toBool();
 	m_rolloverQuoteDialog = nullptr;
 	setCorner(Qt::BottomRightCorner, Qt::RightDockWidgetArea);
 	setDockOptions(QMainWindow::AnimatedDocks);
@@ -433,6 +437,9 @@ void MainWindow::init(ReferenceModel *referenceModel, bool lockFiles) {
 
 	m_simulator = new Simulator(this);
 
+	m_netlistCache = new NetlistCache(this);
+	connect(m_undoStack, SIGNAL(indexChanged(int)), m_netlistCache, SLOT(invalidate()));
+
 	m_undoView = new QUndoView();
 	m_undoGroup = new QUndoGroup(this);
 	m_undoView->setGroup(m_undoGroup);
@@ -813,15 +820,9 @@ void MainWindow::setCurrentFile(const QString &filename, bool addToRecent, bool
 			setWindowModified(true);
 		}
 		else {
-			QStringList files = settings.value("lastTabList").toStringList();
-			for (int ix = files.count() - 1; ix >= 0; ix--) {
-				if (files[ix].mid(1) == filename) {
-					bool ok;
-					int lastTab = files[ix].left(1).toInt(&ok);
-					if (ok) {
-						setCurrentTabIndex(lastTab);
-					}
-				}
+			int lastTab = savedTabIndex(filename);
+			if (lastTab >= 0) {
+				setCurrentTabIndex(lastTab);
 			}
 		}
 	}
@@ -1147,6 +1148,9 @@ void MainWindow::tabWidget_currentChanged(int index) {
 	if (m_pcbGraphicsView != nullptr) m_pcbGraphicsView->setCurrent(false);
 
 	auto *widget = qobject_cast<SketchWidget *>(widgetParent->contentView());
+	if (widget != nullptr) {
+		loadPendingView(widget);
+	}
 
 	if(m_currentGraphicsView != nullptr) {
 		m_currentGraphicsView->saveZoom(m_zoomSlider->value());
@@ -1297,6 +1301,23 @@ void MainWindow::closeEvent(QCloseEvent *event) {
 	QMainWindow::closeEvent(event);
 }
 
+int MainWindow::savedTabIndex(const QString & filename) {
+	int lastTab = -1;
+	QSettings settings;
+	QStringList files = settings.value("lastTabList").toStringList();
+	for (int ix = files.count() - 1; ix >= 0; ix--) {
+		if (files[ix].mid(1) == filename) {
+			bool ok;
+			int tab = files[ix].left(1).toInt(&ok);
+			if (ok) {
+				lastTab = tab;
+			}
+		}
+	}
+
+	return lastTab;
+}
+
 void MainWindow::saveLastTabList() {
 	QSettings settings;
 	QStringList files = settings.value("lastTabList").toStringList();
@@ -1605,7 +1626,7 @@ void MainWindow::loadBundledSketch(const QString &fileName, bool addToRecent, bo
 	}
 
 	// the bundled itself
-	this->mainLoad(sketchName, "", checkObsolete);
+	this->mainLoad(sketchName, "", checkObsolete, setAsLastOpened ? fileName : QString());
 	setCurrentFile(fileName, addToRecent, setAsLastOpened);
 }
 
@@ -2451,6 +2472,8 @@ void MainWindow::subSwapSlot(SketchWidget * sketchWidget, ItemBase * itemBase, c
 
 long MainWindow::swapSelectedAuxAux(ItemBase * itemBase, const QString & moduleID,  ViewLayer::ViewLayerPlacement viewLayerPlacement, QMap<QString, QString> & propsMap, QUndoCommand * parentCommand)
 {
+	loadPendingViews();		// swaps can come from the parts editor, without an edit in this window
+
 	long modelIndex = ModelPart::nextIndex();
 
 	QList<SketchWidget *> sketchWidgets;
@@ -2977,6 +3000,10 @@ PCBSketchWidget * MainWindow::pcbView() {
 	return m_pcbGraphicsView;
 }
 
+NetlistCache * MainWindow::netlistCache() {
+	return m_netlistCache;
+}
+
 void MainWindow::noBackup()
 {
 	m_autosaveTimer.stop();
@@ -3328,8 +3355,87 @@ void MainWindow::setInitialTab(int tab) {
 	m_initialTab = tab;
 }
 
-void MainWindow::triggerSimulator() {
-	m_simulator->triggerSimulation();
+void MainWindow::setLazyViews(bool lazy) {
+	m_lazyViews = lazy;
+}
+
+void MainWindow::loadPendingView(SketchWidget * sketchWidget) {
+	if (!m_pendingViews.removeOne(sketchWidget)) return;
+
+	FProbeTimer probeTimer("PendingViewLoad");
+	QElapsedTimer elapsedTimer;
+	elapsedTimer.start();
+
+	QList<ModelPart *> modelParts;
+	Q_FOREACH (QPointer<ModelPart> modelPart, m_pendingModelParts) {
+		if (modelPart) modelParts.append(modelPart);
+	}
+
+	QList<long> newIDs;
+	sketchWidget->loadFromModelParts(modelParts, BaseCommand::SingleView, nullptr, false, nullptr, false, newIDs);
+	DebugDialog::debug(QString("loaded pending %1 in %2 ms").arg(sketchWidget->viewName()).arg(elapsedTimer.elapsed()));
+
+	if (m_pendingViews.isEmpty()) {
+		m_pendingModelParts.clear();
+		if (m_pendingViewsFilter != nullptr) {
+			qApp->removeEventFilter(m_pendingViewsFilter);
+		}
+	}
+}
+
+void MainWindow::loadPendingViews() {
+	Q_FOREACH (SketchWidget * sketchWidget, m_pendingViews) {
+		loadPendingView(sketchWidget);
+	}
+}
+
+bool MainWindow::isFirstEdit(QObject * object, QEvent * event) {
+	// anything that can start a command in this window: the cross-view signals
+	// are sent while the command is built, so the other views must exist by then.
+	// Wheel zooming and hovering leave the pending views alone, and a click on the tab bar
+	// only loads the view it switches to
+	switch (event->type()) {
+	case QEvent::MouseButtonPress:
+	case QEvent::MouseButtonDblClick:
+	case QEvent::KeyPress:
+	case QEvent::ShortcutOverride:
+	case QEvent::DragEnter:
+	case QEvent::ContextMenu:
+		break;
+	default:
+		return false;
+	}
+
+	auto * widget = qobject_cast<QWidget *>(object);
+	if (widget == nullptr || qobject_cast<QTabBar *>(widget) != nullptr) return false;
+
+	// menus, context menus and floating docks are windows of their own, but they act on this window
+	QWidget * w = widget->window();
+	while (w != nullptr && w != this) {
+		QWidget * parent = w->parentWidget();
+		w = (parent == nullptr) ? nullptr : parent->window();
+	}
+
+	return w == this;
+}
+
+PendingViewsFilter::PendingViewsFilter(MainWindow * mainWindow) : QObject(mainWindow), m_mainWindow(mainWindow)
+{
+}
+
+bool PendingViewsFilter::eventFilter(QObject * object, QEvent * event) {
+	if (!m_mainWindow->m_pendingViews.isEmpty() && m_mainWindow->isFirstEdit(object, event)) {
+		m_mainWindow->loadPendingViews();
+	}
+	return false;
+}
+
+void MainWindow::triggerSimulator(long valueChangeItemID) {
+	if (valueChangeItemID >= 0) {
+		m_simulator->triggerSimulation(valueChangeItemID);
+	} else {
+		m_simulator->triggerSimulation();
+	}
 }
 
 bool MainWindow::isSimulatorEnabled() {
@@ -107,6 +107,18 @@ struct GridSizeThing
 	GridSizeThing(const QString & viewName, const QString & shortName, double defaultSize, const QString & gridSizeText);
 };
 
+// application event filter that loads a window's pending views before the first edit in it
+class PendingViewsFilter : public QObject {
+public:
+	PendingViewsFilter(class MainWindow *);
+
+protected:
+	bool eventFilter(QObject *, QEvent *);
+
+protected:
+	class MainWindow * m_mainWindow;
+};
+
 class GridSizeDialog : public QDialog {
 	Q_OBJECT
 
@@ -146,6 +158,8 @@ class MainWindow : public FritzingWindow
 	Q_OBJECT
 	Q_PROPERTY(int fireQuoteDelay READ fireQuoteDelay WRITE setFireQuoteDelay DESIGNABLE true)
 
+	friend class PendingViewsFilter;
+
 	void setEnableSubmenu(QMenu *menu, bool value);
 	void save_text_file(QString text, QString actionType, QString dialogTitle, QString differentiator, QString errorMessage);
 
@@ -154,7 +168,7 @@ public:
 	MainWindow(QFile & fileToLoad);
 	~MainWindow();
 
-	void mainLoad(const QString & fileName, const QString & displayName, bool checkObsolete);
+	void mainLoad(const QString & fileName, const QString & displayName, bool checkObsolete, const QString & tabFileName = QString());
 	bool loadWhich(const QString & fileName, bool setAsLastOpened, bool addToRecent, bool checkObsolete, const QString & displayName);
 	void notClosableForAWhile();
 	QAction *raiseWindowAction();
@@ -191,6 +205,7 @@ public:
 	ProgramWindow * programmingWidget();
 	void setCloseSilently(bool);
 	class PCBSketchWidget * pcbView();
+	class NetlistCache * netlistCache();
 	void noBackup();
 	void swapSelectedAux(ItemBase * itemBase, const QString & moduleID, bool useViewLayerPlacement, ViewLayer::ViewLayerPlacement, QMap<QString, QString> & propsMap);
 	void swapLayers(ItemBase * itemBase, int layers, const QString & msg);
@@ -217,11 +232,14 @@ public:
 	void setFireQuoteDelay(int);
 	void setInitialTab(int);
 	void noSchematicConversion();
+	void setLazyViews(bool);
+	void loadPendingViews();
 	QString getExportBOM_CSV();
+	QString getExportNetlist();
 	QString getSpiceNetlist(QString, QList< QList<class ConnectorItem *>* >&, QSet<class ItemBase *>& );
 	bool isSimulatorEnabled();
 	void enableSimulator(bool);
-	void triggerSimulator();
+	void triggerSimulator(long valueChangeItemID = -1);
 
 public:
 	static void initNames();
@@ -359,6 +377,7 @@ protected Q_SLOTS:
 	void updateItemMenu();
 
 	void newAutoroute();
+	void autoPlace();
 	void orderFab();
 	void activeLayerTop();
 	void activeLayerBottom();
@@ -528,6 +547,7 @@ protected:
 	void recoverBackupedFiles();
 	void resetTempFolder();
 	void saveLastTabList();
+	int savedTabIndex(const QString & filename);
 
 	virtual QMenu *breadboardItemMenu();
 	virtual QMenu *schematicItemMenu();
@@ -641,6 +661,8 @@ protected:
 	QMessageBox::StandardButton oldSchematicMessage(const QString & filename);
 	MainWindow * revertAux();
 	void migratePartLabelOffset(QList<ModelPart*>);
+	void loadPendingView(class SketchWidget *);
+	bool isFirstEdit(QObject *, QEvent *);
 
 protected:
 	static void removeActionsStartingAt(QMenu *menu, int start=0);
@@ -671,6 +693,7 @@ protected:
 	QPointer<QToolBar> m_toolbar;
 
 	class Simulator *m_simulator;
+	class NetlistCache *m_netlistCache = nullptr;
 
 	bool m_closing = false;
 	bool m_dontClose = false;
@@ -845,6 +868,7 @@ protected:
 	QMenu *m_schematicTraceMenu = nullptr;
 	QMenu *m_breadboardTraceMenu = nullptr;
 	QAction *m_newAutorouteAct = nullptr;
+	QAction *m_autoPlaceAct = nullptr;
 	QAction *m_orderFabAct = nullptr;
 	QAction *m_activeLayerTopAct = nullptr;
 	QAction *m_activeLayerBottomAct = nullptr;
@@ -950,6 +974,12 @@ protected:
 	bool m_noSchematicConversion = false;
 	int m_initialTab = 0;
 
+	// views not built yet when a sketch was opened with lazy view loading
+	bool m_lazyViews = false;
+	QList<SketchWidget *> m_pendingViews;
+	QList< QPointer<ModelPart> > m_pendingModelParts;
+	PendingViewsFilter * m_pendingViewsFilter = nullptr;
+
 	// dock management
 	QList<FDockWidget*> m_docks;
 	FDockWidget* m_topDock = nullptr;
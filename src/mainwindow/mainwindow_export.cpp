@@ -37,6 +37,7 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include "../eagle/fritzing2eagle.h"
 #include "../sketch/schematicsketchwidget.h"
 #include "../sketch/pcbsketchwidget.h"
+#include "../sketch/netlistcache.h"
 #include "../infoview/htmlinfoview.h"
 #include "../utils/fileprogressdialog.h"
 #include "../svg/svgfilesplitter.h"
@@ -132,6 +133,8 @@ void MainWindow::print() {
 
 	if (m_currentGraphicsView == nullptr) return;
 
+	loadPendingViews();
+
 #ifndef QT_NO_PRINTER
 	QPrinter printer(QPrinter::HighResolution);
 
@@ -156,6 +159,8 @@ void MainWindow::exportEtchable() {
 
 void MainWindow::exportEtchable(bool wantPDF, bool wantSVG)
 {
+	loadPendingViews();
+
 	int boardCount;
 	ItemBase * board = m_pcbGraphicsView->findSelectedBoard(boardCount);
 	if (boardCount == 0) {
@@ -806,6 +811,12 @@ bool MainWindow::saveAsAux(const QString & fileName) {
 }
 
 void MainWindow::saveAsAuxAux(const QString & fileName) {
+	// every view writes its own geometry
+	loadPendingViews();
+	Q_FOREACH (SketchWidget * sketchWidget, sketchWidgets()) {
+		sketchWidget->updateDeferredRoutingStatus();
+	}
+
 	QApplication::setOverrideCursor(Qt::WaitCursor);
 
 	connectStartSave(true);
@@ -1187,6 +1198,7 @@ void MainWindow::exportSvgWatermark(QString & svg, double res)
 }
 
 QString MainWindow::getExportBOM_CSV() {
+	loadPendingViews();
 
 	QList <ItemBase*> partList;
 	std::map<QString, int> descrs;
@@ -1194,7 +1206,7 @@ QString MainWindow::getExportBOM_CSV() {
 	QString separator = ";";
 	std::list<QString> properties({"mn", "mpn", "part number"});
 
-	m_currentGraphicsView->collectParts(partList);
+	m_netlistCache->collectParts(m_currentGraphicsView, partList);
 	std::sort(partList.begin(), partList.end(), sortPartList);
 
 	QString propertiess;
@@ -1247,6 +1259,8 @@ void MainWindow::exportBOM() {
 		return;
 	}
 
+	loadPendingViews();
+
 	QString bomTemplate;
 	QFile file(":/resources/templates/bom.html");
 	if (file.open(QFile::ReadOnly)) {
@@ -1271,7 +1285,7 @@ void MainWindow::exportBOM() {
 	QList<QString> descrList;
 	QMultiHash<QString, ItemBase *> descrs;
 
-	m_currentGraphicsView->collectParts(partList);
+	m_netlistCache->collectParts(m_currentGraphicsView, partList);
 
 	std::sort(partList.begin(), partList.end(), sortPartList);
 
@@ -1429,9 +1443,10 @@ QString MainWindow::getSpiceNetlist(QString simulationName) {
  * @return A string that is a circuit description in spice
  */
 QString MainWindow::getSpiceNetlist(QString simulationName, QList< QList<class ConnectorItem *>* >& netList, QSet<class ItemBase *>& itemBases) {
+	loadPendingViews();
 	QString output = simulationName + "\n";
 	QHash<ConnectorItem *, int> indexer;
-	this->m_schematicGraphicsView->collectAllNets(indexer, netList, true, false);
+	m_netlistCache->collectAllNets(m_schematicGraphicsView, indexer, netList, true, false);
 
 
 	//DebugDialog::debug("_______________");
@@ -1573,6 +1588,7 @@ QString MainWindow::getSpiceNetlist(QString simulationName, QList< QList<class C
 }
 
 QString MainWindow::exportIPC_D_356A() {
+	loadPendingViews();
 	int boardCount;
 	ItemBase * board = m_pcbGraphicsView->findSelectedBoard(boardCount);
 
@@ -1583,7 +1599,7 @@ QString MainWindow::exportIPC_D_356A() {
 
 	QHash<ConnectorItem *, int> indexer;
 	QList< QList<ConnectorItem *>* > netList;
-	this->m_pcbGraphicsView->collectAllNets(indexer, netList, true, m_pcbGraphicsView->boardLayers() > 1, skipFlags, skipBuses);
+	m_netlistCache->collectAllNets(m_pcbGraphicsView, indexer, netList, true, m_pcbGraphicsView->boardLayers() > 1, skipFlags, skipBuses);
 
 	QString ipc = getExportIPC_D_356A(board, basename, netList);
 	return ipc;
@@ -1620,9 +1636,20 @@ void MainWindow::exportIPC_D_356A_interactive() {
 
 
 void MainWindow::exportNetlist() {
+	save_text_file(
+				getExportNetlist(),
+				netlistActionType,
+				tr("Export Netlist..."),
+				"netlist",
+				tr("Unable to save netlist file.") + tr("But the content was copied to the clipboard.")
+				);
+}
+
+QString MainWindow::getExportNetlist() {
+	loadPendingViews();
 	QHash<ConnectorItem *, int> indexer;
 	QList< QList<ConnectorItem *>* > netList;
-	this->m_currentGraphicsView->collectAllNets(indexer, netList, true, m_currentGraphicsView->boardLayers() > 1);
+	m_netlistCache->collectAllNets(m_currentGraphicsView, indexer, netList, true, m_currentGraphicsView->boardLayers() > 1);
 
 	QDomDocument doc;
 	doc.setContent(QString("<?xml version='1.0' encoding='UTF-8'?>\n") + TextUtils::CreatedWithFritzingXmlComment);
@@ -1689,15 +1716,7 @@ void MainWindow::exportNetlist() {
 	}
 	netList.clear();
 
-	save_text_file(
-				doc.toString(),
-				netlistActionType,
-				tr("Export Netlist..."),
-				"netlist",
-				tr("Unable to save netlist file.") + tr("But the content was copied to the clipboard.")
-				);
-
-	return;
+	return doc.toString();
 }
 
 FileProgressDialog * MainWindow::exportProgress() {
@@ -1743,6 +1762,8 @@ void MainWindow::exportToGerber() {
 
 	//NOTE: this assumes just one board per sketch
 
+	loadPendingViews();
+
 	int boardCount;
 	ItemBase * board = m_pcbGraphicsView->findSelectedBoard(boardCount);
 
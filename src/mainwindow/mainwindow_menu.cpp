@@ -66,6 +66,8 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include "../processeventblocker.h"
 #include "../sketchtoolbutton.h"
 #include "../help/firsttimehelpdialog.h"
+#include "../svg/svgprefetch.h"
+#include "../testing/FProbeTiming.h"
 
 ////////////////////////////////////////////////////////
 
@@ -348,7 +350,8 @@ bool MainWindow::loadWhich(const QString & fileName, bool setAsLastOpened, bool
 	return result;
 }
 
-void MainWindow::mainLoad(const QString & fileName, const QString & displayName, bool checkObsolete) {
+void MainWindow::mainLoad(const QString & fileName, const QString & displayName, bool checkObsolete, const QString & tabFileName) {
+	FProbeTimer probeTimer("SketchLoad");
 
 	if (m_fileProgressDialog) {
 		m_fileProgressDialog->setMaximum(200);
@@ -404,6 +407,53 @@ void MainWindow::mainLoad(const QString & fileName, const QString & displayName,
 	disconnect(m_sketchModel, SIGNAL(obsoleteSMDOrientationSignal()),
 	           this, SLOT(obsoleteSMDOrientationSlot()));
 
+	// with lazy view loading only the visible view is built now; the others are built from the same
+	// model parts on first use (see loadPendingView). Sketches that still need converting or checking
+	// in every view are loaded fully
+	bool anyObsolete = false;
+	if (checkObsolete) {
+		Q_FOREACH (ModelPart * modelPart, modelParts) {
+			if (modelPart->isObsolete()) {
+				anyObsolete = true;
+				break;
+			}
+		}
+	}
+	bool lazy = m_lazyViews && !m_convertedSchematic && !m_useOldSchematic && !m_obsoleteSMDOrientation
+	            && !doMigratePartLabelOffset && !anyObsolete && !m_sketchModel->checkForReversedWires();
+	if (lazy) {
+		// setCurrentFile switches to the tab the sketch was saved with, so that is the view to build now
+		SketchWidget * keepView = m_currentGraphicsView;
+		if (!tabFileName.isEmpty()) {
+			int lastTab = savedTabIndex(tabFileName);
+			auto * tabWidget = qobject_cast<QTabWidget *>(m_tabWidget);
+			auto * sketchAreaWidget = (lastTab >= 0 && tabWidget != nullptr) ? qobject_cast<SketchAreaWidget *>(tabWidget->widget(lastTab)) : nullptr;
+			if (sketchAreaWidget != nullptr) {
+				auto * sketchWidget = qobject_cast<SketchWidget *>(sketchAreaWidget->contentView());
+				if (sketchWidget != nullptr) {
+					keepView = sketchWidget;
+				}
+			}
+		}
+		Q_FOREACH (SketchWidget * sketchWidget, sketchWidgets()) {
+			if (sketchWidget != keepView) {
+				m_pendingViews.append(sketchWidget);
+			}
+		}
+		Q_FOREACH (ModelPart * modelPart, modelParts) {
+			m_pendingModelParts.append(modelPart);
+		}
+	}
+
+	// read and split the part svgs on worker threads while the views are built
+	QList<ViewLayer::ViewID> prefetchViews;
+	Q_FOREACH (SketchWidget * sketchWidget, QList<SketchWidget *>() << m_breadboardGraphicsView << m_pcbGraphicsView << m_schematicGraphicsView) {
+		if (!m_pendingViews.contains(sketchWidget)) {
+			prefetchViews.append(sketchWidget->viewID());
+		}
+	}
+	SvgPrefetch::start(modelParts, prefetchViews);
+
 	ProcessEventBlocker::processEvents();
 	if (m_fileProgressDialog) {
 		m_fileProgressDialog->setValue(155);
@@ -411,7 +461,9 @@ void MainWindow::mainLoad(const QString & fileName, const QString & displayName,
 	}
 
 	QList<long> newIDs;
-	m_breadboardGraphicsView->loadFromModelParts(modelParts, BaseCommand::SingleView, nullptr, false, nullptr, false, newIDs);
+	if (!m_pendingViews.contains(m_breadboardGraphicsView)) {
+		m_breadboardGraphicsView->loadFromModelParts(modelParts, BaseCommand::SingleView, nullptr, false, nullptr, false, newIDs);
+	}
 
 	ProcessEventBlocker::processEvents();
 	if (m_fileProgressDialog) {
@@ -420,7 +472,9 @@ void MainWindow::mainLoad(const QString & fileName, const QString & displayName,
 	}
 
 	newIDs.clear();
-	m_pcbGraphicsView->loadFromModelParts(modelParts, BaseCommand::SingleView, nullptr, false, nullptr, false, newIDs);
+	if (!m_pendingViews.contains(m_pcbGraphicsView)) {
+		m_pcbGraphicsView->loadFromModelParts(modelParts, BaseCommand::SingleView, nullptr, false, nullptr, false, newIDs);
+	}
 
 
 	ProcessEventBlocker::processEvents();
@@ -430,10 +484,22 @@ void MainWindow::mainLoad(const QString & fileName, const QString & displayName,
 	}
 
 	newIDs.clear();
-	m_schematicGraphicsView->setConvertSchematic(m_convertedSchematic);
-	m_schematicGraphicsView->setOldSchematic(this->m_useOldSchematic);
-	m_schematicGraphicsView->loadFromModelParts(modelParts, BaseCommand::SingleView, nullptr, false, nullptr, false, newIDs);
-	m_schematicGraphicsView->setConvertSchematic(false);
+	if (!m_pendingViews.contains(m_schematicGraphicsView)) {
+		m_schematicGraphicsView->setConvertSchematic(m_convertedSchematic);
+		m_schematicGraphicsView->setOldSchematic(this->m_useOldSchematic);
+		m_schematicGraphicsView->loadFromModelParts(modelParts, BaseCommand::SingleView, nullptr, false, nullptr, false, newIDs);
+		m_schematicGraphicsView->setConvertSchematic(false);
+	}
+
+	SvgPrefetch::finish();
+
+	if (!m_pendingViews.isEmpty()) {
+		DebugDialog::debug(QString("lazy view loading: %1 views pending").arg(m_pendingViews.count()));
+		if (m_pendingViewsFilter == nullptr) {
+			m_pendingViewsFilter = new PendingViewsFilter(this);
+		}
+		qApp->installEventFilter(m_pendingViewsFilter);
+	}
 
 	if (m_sketchModel->checkForReversedWires()) {
 		m_pcbGraphicsView->checkForReversedWires();
@@ -1569,6 +1635,7 @@ void MainWindow::createTraceMenus()
 {
 	m_pcbTraceMenu = menuBar()->addMenu(tr("&Routing"));
 	m_pcbTraceMenu->addAction(m_newAutorouteAct);
+	m_pcbTraceMenu->addAction(m_autoPlaceAct);
 	m_pcbTraceMenu->addAction(m_newDesignRulesCheckAct);
 	m_pcbTraceMenu->addAction(m_autorouterSettingsAct);
 	m_pcbTraceMenu->addAction(m_fabQuoteAct);
@@ -2207,6 +2274,7 @@ void MainWindow::updateTraceMenu() {
 	m_clearGroundFillSeedsAct->setEnabled(traceMenuThing.gfsEnabled && traceMenuThing.boardCount >= 1);
 
 	m_newDesignRulesCheckAct->setEnabled(traceMenuThing.boardCount >= 1);
+	m_autoPlaceAct->setEnabled(traceMenuThing.boardCount >= 1);
 	m_autorouterSettingsAct->setEnabled(m_currentGraphicsView == m_pcbGraphicsView);
 	m_updateRoutingStatusAct->setEnabled(true);
 
@@ -2772,6 +2840,10 @@ void MainWindow::createTraceMenuActions() {
 	m_newAutorouteAct->setShortcut(tr("Shift+Ctrl+A"));
 	connect(m_newAutorouteAct, SIGNAL(triggered()), this, SLOT(newAutoroute()));
 
+	m_autoPlaceAct = new QAction(tr("Auto-place Parts"), this);
+	m_autoPlaceAct->setStatusTip(tr("Move the unlocked parts onto the board, keeping connected parts close together"));
+	connect(m_autoPlaceAct, SIGNAL(triggered()), this, SLOT(autoPlace()));
+
 	createOrderFabAct();
 	createActiveLayerActions();
 
@@ -2989,6 +3061,9 @@ void MainWindow::newAutoroute() {
 	auto * pcbSketchWidget = qobject_cast<PCBSketchWidget *>(m_currentGraphicsView);
 	if (pcbSketchWidget == nullptr) return;
 
+	// the routed traces are sent to the other views
+	loadPendingViews();
+
 	ItemBase * board = nullptr;
 	if (pcbSketchWidget->autorouteTypePCB()) {
 		int boardCount;
@@ -3060,6 +3135,29 @@ void MainWindow::newAutoroute() {
 	Q_EMIT pcbSketchWidget->routingStatusSignal(pcbSketchWidget, routingStatus);
 }
 
+void MainWindow::autoPlace() {
+	auto * pcbSketchWidget = qobject_cast<PCBSketchWidget *>(m_currentGraphicsView);
+	if (pcbSketchWidget == nullptr) return;
+
+	int boardCount;
+	ItemBase * board = pcbSketchWidget->findSelectedBoard(boardCount);
+	if (boardCount == 0) {
+		QMessageBox::critical(this, tr("Fritzing"),
+		                      tr("Your sketch does not have a board yet!  Please add a PCB in order to place parts."));
+		return;
+	}
+	if (board == nullptr) {
+		QMessageBox::critical(this, tr("Fritzing"),
+		                      tr("Please select the board you want to place parts on. Parts can only be placed on one board at a time."));
+		return;
+	}
+
+	if (!pcbSketchWidget->autoPlace(board)) {
+		QMessageBox::information(this, tr("Fritzing"),
+		                         tr("Some parts do not fit on the board without overlapping. Try a larger board or a smaller keepout."));
+	}
+}
+
 void MainWindow::createTrace() {
 	m_currentGraphicsView->createTrace(retrieveWire(), true);
 }
@@ -4261,6 +4359,8 @@ QStringList MainWindow::newDesignRulesCheck(bool showOkMessage)
 
 	if (m_currentGraphicsView == nullptr) return results;
 
+	loadPendingViews();
+
 	auto * pcbSketchWidget = qobject_cast<PCBSketchWidget *>(m_currentGraphicsView);
 	if (pcbSketchWidget == nullptr) return results;
 
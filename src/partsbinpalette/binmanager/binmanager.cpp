@@ -27,6 +27,7 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include <QInputDialog>
 #include <QDropEvent>
 #include <QMimeData>
+#include <QElapsedTimer>
 
 #include "binmanager.h"
 #include "stacktabwidget.h"
@@ -44,6 +45,7 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include "../../items/partfactory.h"
 #include "../partsbinpalettewidget.h"
 #include "../partsbinview.h"
+#include "../iconcache.h"
 
 ///////////////////////////////////////////////////////////
 
@@ -134,6 +136,9 @@ BinManager::~BinManager() {
 
 void BinManager::initStandardBins()
 {
+	QElapsedTimer elapsedTimer;
+	elapsedTimer.start();
+
 	createCombinedMenu();
 	createContextMenus();
 
@@ -161,6 +166,9 @@ void BinManager::initStandardBins()
 	currentChanged(m_stackTabWidget->currentIndex());
 
 	connectTabWidget();
+
+	DebugDialog::debug(QString("init standard bins %1 ms, icon cache hits:%2 misses:%3")
+	                   .arg(elapsedTimer.elapsed()).arg(IconCache::hits()).arg(IconCache::misses()));
 }
 
 void BinManager::addBin(PartsBinPaletteWidget* bin) {
@@ -0,0 +1,181 @@
+/*******************************************************************
+
+Part of the Fritzing project - http://fritzing.org
+Copyright (c) 2007-2019 Fritzing
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************/
+
+#include "iconcache.h"
+#include "../utils/folderutils.h"
+#include "../debugdialog.h"
+
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QPainter>
+#include <QSaveFile>
+
+QSize IconCache::IconSize;
+QImage IconCache::Atlas;
+QHash<QString, int> IconCache::Index;
+QHash<QString, QImage> IconCache::Inserted;
+QHash<QString, QString> IconCache::ModuleKeys;
+int IconCache::Hits = 0;
+int IconCache::Misses = 0;
+
+QString IconCache::cacheFilename() {
+	return FolderUtils::getTopLevelUserDataStorePath() + "/iconcache/icons.fzic";
+}
+
+QRect IconCache::cell(int index) {
+	return QRect((index % AtlasColumns) * IconSize.width(), (index / AtlasColumns) * IconSize.height(), IconSize.width(), IconSize.height());
+}
+
+void IconCache::load(const QSize & iconSize) {
+	IconSize = iconSize;
+	Atlas = QImage();
+	Index.clear();
+	Inserted.clear();
+	ModuleKeys.clear();
+
+	QFile file(cacheFilename());
+	if (!file.open(QIODevice::ReadOnly)) return;
+
+	QDataStream in(&file);
+	in.setVersion(QDataStream::Qt_5_12);
+	quint32 magic = 0;
+	quint32 version = 0;
+	QSize size;
+	in >> magic >> version >> size;
+	if (magic != Magic || version != Version || size != IconSize) {
+		DebugDialog::debug(QString("icon cache %1 is out of date").arg(file.fileName()));
+		return;
+	}
+
+	QHash<QString, int> index;
+	QImage atlas;
+	in >> index >> atlas;
+	if (in.status() != QDataStream::Ok || atlas.isNull()) {
+		DebugDialog::debug(QString("icon cache %1 is unreadable").arg(file.fileName()));
+		return;
+	}
+
+	Index = index;
+	Atlas = atlas;
+	DebugDialog::debug(QString("icon cache loaded %1 icons").arg(Index.count()));
+}
+
+void IconCache::save() {
+	// drop icons whose svg file has changed since they were cached
+	QStringList keys;
+	bool dropped = false;
+	Q_FOREACH (QString key, Index.keys() + Inserted.keys()) {
+		QString moduleID = key.left(key.lastIndexOf('|'));
+		QString current = ModuleKeys.value(moduleID, key);
+		if (current != key) {
+			dropped = true;
+			continue;
+		}
+		keys.append(key);
+	}
+
+	DebugDialog::debug(QString("icon cache hits:%1 misses:%2").arg(Hits).arg(Misses));
+	if (Inserted.isEmpty() && !dropped) return;
+	if (keys.isEmpty() || IconSize.isEmpty()) return;
+
+	int rows = (keys.count() + AtlasColumns - 1) / AtlasColumns;
+	QImage atlas(AtlasColumns * IconSize.width(), rows * IconSize.height(), QImage::Format_ARGB32_Premultiplied);
+	atlas.fill(Qt::transparent);
+	QHash<QString, int> index;
+	QPainter painter(&atlas);
+	painter.setCompositionMode(QPainter::CompositionMode_Source);
+	for (int i = 0; i < keys.count(); i++) {
+		const QString & key = keys.at(i);
+		QRect target = cell(i);
+		if (Inserted.contains(key)) {
+			painter.drawImage(target, Inserted.value(key));
+		}
+		else {
+			painter.drawImage(target, Atlas, cell(Index.value(key)));
+		}
+		index.insert(key, i);
+	}
+	painter.end();
+
+	QDir().mkpath(QFileInfo(cacheFilename()).absolutePath());
+	QSaveFile file(cacheFilename());
+	if (!file.open(QIODevice::WriteOnly)) {
+		DebugDialog::debug(QString("unable to write icon cache %1").arg(file.fileName()));
+		return;
+	}
+
+	QDataStream out(&file);
+	out.setVersion(QDataStream::Qt_5_12);
+	out << Magic << Version << IconSize << index << atlas;
+	if (out.status() != QDataStream::Ok || !file.commit()) {
+		DebugDialog::debug(QString("unable to write icon cache %1").arg(file.fileName()));
+		return;
+	}
+
+	Atlas = atlas;
+	Index = index;
+	Inserted.clear();
+}
+
+QString IconCache::key(const QString & moduleID, const QString & iconFilename) {
+	QFile file(iconFilename);
+	if (!file.open(QIODevice::ReadOnly)) return QString();
+
+	QCryptographicHash hash(QCryptographicHash::Md5);
+	hash.addData(&file);
+	QString key = moduleID + "|" + QString::fromLatin1(hash.result().toHex());
+	ModuleKeys.insert(moduleID, key);
+	return key;
+}
+
+QPixmap IconCache::icon(const QString & key) {
+	if (!key.isEmpty()) {
+		auto inserted = Inserted.constFind(key);
+		if (inserted != Inserted.constEnd()) {
+			Hits++;
+			return QPixmap::fromImage(inserted.value());
+		}
+		auto cached = Index.constFind(key);
+		if (cached != Index.constEnd()) {
+			Hits++;
+			return QPixmap::fromImage(Atlas.copy(cell(cached.value())));
+		}
+	}
+
+	Misses++;
+	return QPixmap();
+}
+
+void IconCache::insert(const QString & key, const QImage & icon) {
+	if (key.isEmpty() || icon.size() != IconSize) return;
+
+	Inserted.insert(key, icon);
+}
+
+int IconCache::hits() {
+	return Hits;
+}
+
+int IconCache::misses() {
+	return Misses;
+}
@@ -0,0 +1,61 @@
+/*******************************************************************
+
+Part of the Fritzing project - http://fritzing.org
+Copyright (c) 2007-2019 Fritzing
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************/
+
+#ifndef ICONCACHE_H_
+#define ICONCACHE_H_
+
+#include <QHash>
+#include <QImage>
+#include <QPixmap>
+#include <QString>
+
+// Rendered parts bin icons, kept on disk between sessions in a single atlas image.
+// Entries are keyed by moduleID and a hash of the icon svg file, so an edited icon is rendered again.
+class IconCache
+{
+public:
+	static void load(const QSize & iconSize);
+	static void save();
+	static QString key(const QString & moduleID, const QString & iconFilename);
+	static QPixmap icon(const QString & key);
+	static void insert(const QString & key, const QImage & icon);
+	static int hits();
+	static int misses();
+
+public:
+	static constexpr quint32 Magic = 0x46494343;		// "FICC"
+	static constexpr quint32 Version = 1;				// bump when icon rendering changes
+	static constexpr int AtlasColumns = 32;
+
+protected:
+	static QString cacheFilename();
+	static QRect cell(int index);
+
+protected:
+	static QSize IconSize;
+	static QImage Atlas;
+	static QHash<QString, int> Index;			// key -> cell in Atlas
+	static QHash<QString, QImage> Inserted;		// icons rendered this session, not in Atlas yet
+	static QHash<QString, QString> ModuleKeys;	// moduleID -> current key, to drop stale entries on save
+	static int Hits;
+	static int Misses;
+};
+
+#endif /* ICONCACHE_H_ */
@@ -200,12 +200,10 @@ int PartsBinIconView::setItemAux(ModelPart * modelPart, int position) {
 
 	SvgIconWidget* svgicon = nullptr;
 	if (modelPart->itemType() != ModelPart::Space) {
-		ItemBase::PluralType plural;
-		ItemBase * itemBase = loadItemBase(moduleID, plural);
-		svgicon = new SvgIconWidget(modelPart, ViewLayer::IconView, itemBase, plural == ItemBase::Plural);
+		svgicon = new SvgIconWidget(modelPart, ViewLayer::IconView, loadItemBase(moduleID));
 	}
 	else {
-		svgicon = new SvgIconWidget(modelPart, ViewLayer::IconView, nullptr, false);
+		svgicon = new SvgIconWidget(modelPart, ViewLayer::IconView, nullptr);
 	}
 
 
@@ -440,25 +438,32 @@ void PartsBinIconView::reloadPart(const QString & moduleID) {
 
 		if (it->itemBase()->moduleID().compare(moduleID) != 0) continue;
 
-		ItemBase::PluralType plural;
-		ItemBase * itemBase = loadItemBase(moduleID, plural);
+		ItemBase * itemBase = loadItemBase(moduleID);
 
-		it->setItemBase(itemBase, plural != 0u);
+		it->setItemBase(itemBase, pluralType(itemBase) == ItemBase::Plural);
 		return;
 	}
 }
 
-ItemBase * PartsBinIconView::loadItemBase(const QString & moduleID, ItemBase::PluralType & plural) {
+ItemBase * PartsBinIconView::loadItemBase(const QString & moduleID) {
 	ItemBase * itemBase = ItemBaseHash.value(moduleID);
-	ModelPart * modelPart = m_referenceModel->retrieveModelPart(moduleID);
     if (itemBase == nullptr) {
+		ModelPart * modelPart = m_referenceModel->retrieveModelPart(moduleID);
 		itemBase = PartFactory::createPart(modelPart, ViewLayer::NewTop, ViewLayer::IconView, ViewGeometry(), ItemBase::getNextID(), nullptr, nullptr, false);
 		ItemBaseHash.insert(moduleID, itemBase);
 	}
 	m_itemBaseHash.insert(moduleID, itemBase);
+	return itemBase;
+}
 
-	plural = itemBase->isPlural();
+/**
+ * Whether the part's family has more than one value for some property;
+ * this needs a reference model query per property, so icons only ask when they are first painted
+ */
+ItemBase::PluralType PartsBinIconView::pluralType(ItemBase * itemBase) {
+	ItemBase::PluralType plural = itemBase->isPlural();
 	if (plural == ItemBase::NotSure) {
+		ModelPart * modelPart = itemBase->modelPart();
 		QHash<QString,QString> properties = modelPart->properties();
 		QString family = properties.value("family", "").toLower();
 		Q_FOREACH (QString key, properties.keys()) {
@@ -470,5 +475,5 @@ ItemBase * PartsBinIconView::loadItemBase(const QString & moduleID, ItemBase::Pl
 		}
 	}
 
-	return itemBase;
+	return plural;
 }
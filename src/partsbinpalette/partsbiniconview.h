@@ -54,6 +54,7 @@ public:
 
 	QList<QObject*> orderedChildren();
 	void reloadPart(const QString & moduleID);
+	ItemBase::PluralType pluralType(ItemBase *);
 
 	static const int PARTSBIN_ICON_IMG_WIDTH;
 	static const int PARTSBIN_ICON_IMG_HEIGHT;
@@ -80,7 +81,7 @@ protected:
 	QGraphicsWidget* closestItemTo(const QPoint& pos);
 	SvgIconWidget * svgIconWidgetAt(const QPoint & pos);
 	SvgIconWidget * svgIconWidgetAt(int x, int y);
-	ItemBase * loadItemBase(const QString & moduleID, ItemBase::PluralType &);
+	ItemBase * loadItemBase(const QString & moduleID);
 
 public Q_SLOTS:
 	void setSelected(int position, bool doEmit=false);
@@ -32,6 +32,7 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 
 #include "partsbinlistview.h"
 #include "partsbiniconview.h"
+#include "svgiconwidget.h"
 
 static const QColor SectionHeaderBackgroundColor(128, 128, 128);
 static const QColor SectionHeaderForegroundColor(32, 32, 32);
@@ -377,15 +378,10 @@ void PartsBinListView::loadImage(ModelPart * modelPart, QListWidgetItem * lwi, c
 	if (itemBase == nullptr) {
 		itemBase = PartFactory::createPart(modelPart, ViewLayer::NewTop, ViewLayer::IconView, ViewGeometry(), ItemBase::getNextID(), nullptr, nullptr, false);
 		ItemBaseHash.insert(moduleID, itemBase);
-		LayerAttributes layerAttributes;
-		itemBase->initLayerAttributes(layerAttributes, ViewLayer::IconView, ViewLayer::Icon, itemBase->viewLayerPlacement(), false, false);
-		FSvgRenderer * renderer = itemBase->setUpImage(modelPart, layerAttributes);
-		if (renderer != nullptr) {
-			if (itemBase != nullptr) {
-				itemBase->setFilename(renderer->filename());
-			}
-			itemBase->setSharedRendererEx(renderer);
-		}
+	}
+	if (!itemBase->hasFsvgRenderer()) {
+		// shared with the icon view, which may not have painted (and so not loaded) this icon yet
+		SvgIconWidget::setUpRenderer(itemBase, ViewLayer::IconView);
 	}
 	lwi->setData(Qt::UserRole, QVariant::fromValue( itemBase ) );
 	QSize size(PartsBinIconView::PARTSBIN_ICON_IMG_WIDTH,
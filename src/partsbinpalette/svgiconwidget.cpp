@@ -27,8 +27,10 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include "../fsvgrenderer.h"
 #include "../items/moduleidnames.h"
 #include "../layerattributes.h"
+#include "../items/partfactory.h"
 
-#include "partsbinview.h"
+#include "partsbiniconview.h"
+#include "iconcache.h"
 
 #define SELECTED_STYLE "background-color: white;"
 #define NON_SELECTED_STYLE "background-color: #C2C2C2;"
@@ -80,11 +82,12 @@ void SvgIconPixmapItem::paint(QPainter *painter, const QStyleOptionGraphicsItem
 
 ////////////////////////////////////////////////////////////
 
-SvgIconWidget::SvgIconWidget(ModelPart * modelPart, ViewLayer::ViewID viewID, ItemBase * itemBase, bool plural)
+SvgIconWidget::SvgIconWidget(ModelPart * modelPart, ViewLayer::ViewID viewID, ItemBase * itemBase)
 	: QGraphicsWidget()
 {
 	m_moduleId = modelPart->moduleID();
 	m_itemBase = itemBase;
+	m_viewID = viewID;
 
 	if (modelPart->itemType() == ModelPart::Space) {
 		m_moduleId = ModuleIDNames::SpacerModuleIDName;
@@ -104,7 +107,8 @@ SvgIconWidget::SvgIconWidget(ModelPart * modelPart, ViewLayer::ViewID viewID, It
 		this->setMaximumSize(PluralImage->size());
 		setAcceptHoverEvents(true);
 		setFlags(QGraphicsItem::ItemIsSelectable);
-		setupImage(plural, viewID);
+		// the icon is rendered the first time it is painted, so only icons scrolled into view cost anything
+		m_pixmapItem = new SvgIconPixmapItem(*SingularImage, this, false);
 	}
 }
 
@@ -119,9 +123,11 @@ void SvgIconWidget::initNames() {
 		SingularImage = new QPixmap(r, r);
 		SingularImage->fill(QColorConstants::White);
 	}
+	IconCache::load(QSize(ICON_SIZE, ICON_SIZE));
 }
 
 void SvgIconWidget::cleanup() {
+	IconCache::save();
 	if (PluralImage != nullptr) {
 		delete PluralImage;
 		PluralImage = nullptr;
@@ -182,60 +188,98 @@ void SvgIconWidget::paint(QPainter *painter, const QStyleOptionGraphicsItem *opt
 		return;
 	}
 
+	if (!m_imageReady && m_itemBase != nullptr) {
+		m_imageReady = true;
+		bool plural = false;
+		auto * partsBinIconView = qobject_cast<PartsBinIconView *>(InfoGraphicsView::getInfoGraphicsView(this));
+		if (partsBinIconView != nullptr) {
+			plural = partsBinIconView->pluralType(m_itemBase) == ItemBase::Plural;
+		}
+		setupImage(plural, m_viewID);
+	}
+
 	QGraphicsWidget::paint(painter, option, widget);
 }
 
 void SvgIconWidget::setItemBase(ItemBase * itemBase, bool plural)
 {
 	m_itemBase = itemBase;
-	setupImage(plural, itemBase->viewID());
+	m_viewID = itemBase->viewID();
+	m_imageReady = true;
+	// the part has been reloaded, so its svg may have changed
+	setUpRenderer(m_itemBase, m_viewID);
+	setupImage(plural, m_viewID);
 }
 
-void SvgIconWidget::setupImage(bool plural, ViewLayer::ViewID viewID)
+/**
+ * Load the icon svg into itemBase's renderer.
+ * Icons found in the IconCache never need the renderer, so it is only set up on demand.
+ */
+FSvgRenderer * SvgIconWidget::setUpRenderer(ItemBase * itemBase, ViewLayer::ViewID viewID)
 {
 	LayerAttributes layerAttributes;
-	m_itemBase->initLayerAttributes(layerAttributes, viewID, ViewLayer::Icon, ViewLayer::NewTop, false, false);
-	ModelPart * modelPart = m_itemBase->modelPart();
+	itemBase->initLayerAttributes(layerAttributes, viewID, ViewLayer::Icon, ViewLayer::NewTop, false, false);
+	ModelPart * modelPart = itemBase->modelPart();
 	FSvgRenderer * renderer = nullptr;
 	if (modelPart != nullptr) {
-			renderer = m_itemBase->setUpImage(modelPart, layerAttributes);
+			renderer = itemBase->setUpImage(modelPart, layerAttributes);
 	}
 	if (renderer == nullptr) {
 		if (modelPart != nullptr) {
 			DebugDialog::debug(QString("missing renderer for icon %1").arg(modelPart->moduleID()));
 		} else {
-			DebugDialog::debug(QString("error icon %1").arg(m_itemBase->filename()));
-			DebugDialog::debug(QString("error icon %1").arg(m_itemBase->id()));
+			DebugDialog::debug(QString("error icon %1").arg(itemBase->filename()));
+			DebugDialog::debug(QString("error icon %1").arg(itemBase->id()));
 		}
+		return nullptr;
 	}
-	if ((renderer != nullptr) && (m_itemBase != nullptr)) {
-		m_itemBase->setFilename(renderer->filename());
+
+	itemBase->setFilename(renderer->filename());
+	itemBase->setSharedRendererEx(renderer);
+	return renderer;
+}
+
+void SvgIconWidget::setupImage(bool plural, ViewLayer::ViewID viewID)
+{
+	QString key;
+	ModelPart * modelPart = m_itemBase->modelPart();
+	if (modelPart != nullptr && modelPart->modelPartShared() != nullptr) {
+		QString imageFilename = modelPart->modelPartShared()->imageFileName(viewID, ViewLayer::Icon);
+		key = IconCache::key(m_moduleId, PartFactory::getSvgFilename(modelPart, imageFilename, true, true));
 	}
 
 	QPixmap pixmap(plural ? *PluralImage : *SingularImage);
-	QPixmap * icon = (renderer == nullptr) ? nullptr : FSvgRenderer::getPixmap(renderer, QSize(ICON_SIZE, ICON_SIZE));
-	if (icon != nullptr) {
+	QPixmap icon = IconCache::icon(key);
+	if (icon.isNull()) {
+		FSvgRenderer * renderer = m_itemBase->hasFsvgRenderer() ? m_itemBase->fsvgRenderer() : setUpRenderer(m_itemBase, viewID);
+		QPixmap * rendered = (renderer == nullptr) ? nullptr : FSvgRenderer::getPixmap(renderer, QSize(ICON_SIZE, ICON_SIZE));
+		if (rendered != nullptr) {
+			icon = *rendered;
+			delete rendered;
+			IconCache::insert(key, icon.toImage());
+		}
+	}
+
+	if (!icon.isNull()) {
 		QPainter painter;
 		painter.begin(&pixmap);
 		if (plural) {
-			painter.drawPixmap(PLURAL_OFFSET, PLURAL_OFFSET, *icon);
+			painter.drawPixmap(PLURAL_OFFSET, PLURAL_OFFSET, icon);
 		}
 		else {
-			painter.drawPixmap(SINGULAR_OFFSET, SINGULAR_OFFSET, *icon);
+			painter.drawPixmap(SINGULAR_OFFSET, SINGULAR_OFFSET, icon);
 		}
 		painter.end();
-		delete icon;
 	}
 
-    /// @todo make sure this doesn't leak if this function is called multiple times on the same object.
-	m_pixmapItem = new SvgIconPixmapItem(pixmap, this, plural);
-
-	if (m_itemBase != nullptr) {
-		m_itemBase->setTooltip();
-		setToolTip(m_itemBase->toolTip());
+	if (m_pixmapItem == nullptr) {
+		m_pixmapItem = new SvgIconPixmapItem(pixmap, this, plural);
 	}
-
-	if (renderer != nullptr) {
-		m_itemBase->setSharedRendererEx(renderer);
+	else {
+		m_pixmapItem->setPixmap(pixmap);
+		m_pixmapItem->setPlural(plural);
 	}
+
+	m_itemBase->setTooltip();
+	setToolTip(m_itemBase->toolTip());
 }
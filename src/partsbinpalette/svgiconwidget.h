@@ -48,7 +48,7 @@ class SvgIconWidget : public QGraphicsWidget
 {
 	Q_OBJECT
 public:
-	SvgIconWidget(ModelPart *, ViewLayer::ViewID, ItemBase *, bool plural);
+	SvgIconWidget(ModelPart *, ViewLayer::ViewID, ItemBase *);
 	~SvgIconWidget() = default;
 	ItemBase * itemBase() const noexcept;
 	ModelPart * modelPart() const noexcept;
@@ -57,6 +57,7 @@ public:
 
 	static void initNames();
 	static void cleanup();
+	static FSvgRenderer * setUpRenderer(ItemBase *, ViewLayer::ViewID);
 
 protected:
 	void hoverEnterEvent ( QGraphicsSceneHoverEvent * event );
@@ -68,6 +69,8 @@ protected:
 	QPointer<ItemBase> m_itemBase;
 	SvgIconPixmapItem * m_pixmapItem = nullptr;
 	QString m_moduleId;
+	ViewLayer::ViewID m_viewID = ViewLayer::IconView;
+	bool m_imageReady = false;
 };
 
 
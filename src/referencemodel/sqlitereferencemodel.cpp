@@ -28,6 +28,9 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include <QSqlDriver>
 #include <QDebug>
 #include <QtGlobal>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QUrl>
 #include <limits>
 
 #include "sqlitereferencemodel.h"
@@ -45,6 +48,10 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 
 static const qulonglong NO_ID = std::numeric_limits<qulonglong>::max();
 
+static const qlonglong MmapSize = 512 * 1024 * 1024;
+
+bool SqliteReferenceModel::s_sharedDatabase = false;
+
 void debugError(bool result, QSqlQuery & query) {
 	if (result) return;
 
@@ -88,6 +95,24 @@ void killBuses(QVector<BusShared *> & buses) {
 QStringList FailurePartMessages;
 QStringList FailurePropertyMessages;
 
+// resident memory of this process in kB, and the part of it that is anonymous (not file backed, so never shared
+// with another process); only available on Linux
+void residentMemory(qint64 & resident, qint64 & anonymous)
+{
+	resident = anonymous = 0;
+	QFile file("/proc/self/status");
+	if (!file.open(QFile::ReadOnly | QFile::Text)) return;
+
+	Q_FOREACH (QByteArray line, file.readAll().split('\n')) {
+		if (line.startsWith("VmRSS:")) {
+			resident = line.mid(6).trimmed().split(' ').first().toLongLong();
+		}
+		else if (line.startsWith("RssAnon:")) {
+			anonymous = line.mid(8).trimmed().split(' ').first().toLongLong();
+		}
+	}
+}
+
 void noSwappingMessage(int n)
 {
 	FMessageBox::warning(nullptr,
@@ -102,6 +127,7 @@ void noSwappingMessage(int n)
 SqliteReferenceModel::SqliteReferenceModel() {
 	m_swappingEnabled = false;
 	m_lastWasExactMatch = true;
+	m_attachedMaxPartID = 0;
 }
 
 bool SqliteReferenceModel::loadAll(const QString & databaseName, bool fullLoad, bool dbExists)
@@ -168,8 +194,16 @@ bool SqliteReferenceModel::loadAll(const QString & databaseName, bool fullLoad,
 
 bool SqliteReferenceModel::loadFromDB(const QString & databaseName)
 {
+	QElapsedTimer timer;
+	timer.start();
+	qint64 residentBefore, anonymousBefore;
+	residentMemory(residentBefore, anonymousBefore);
+
 	QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", "temporary");
 	db.setDatabaseName(databaseName);
+	if (s_sharedDatabase) {
+		db.setConnectOptions("QSQLITE_OPEN_READONLY");
+	}
 
 	/*
 	QVariant v = m_database.driver()->handle();
@@ -189,6 +223,16 @@ bool SqliteReferenceModel::loadFromDB(const QString & databaseName)
 		killParts();
 		noSwappingMessage(2);
 	}
+	else if (s_sharedDatabase && !attachDatabase(databaseName)) {
+		m_swappingEnabled = false;
+		noSwappingMessage(3);
+	}
+
+	qint64 resident, anonymous;
+	residentMemory(resident, anonymous);
+	DebugDialog::debug(QString("SqliteReferenceModel::loadFromDB %1 parts in %2 ms%3, resident %4 -> %5 kB, anonymous %6 -> %7 kB")
+	                   .arg(m_partHash.count()).arg(timer.elapsed()).arg(s_sharedDatabase ? " (shared)" : "")
+	                   .arg(residentBefore).arg(resident).arg(anonymousBefore).arg(anonymous));
 
 	return m_swappingEnabled;
 }
@@ -207,6 +251,13 @@ bool SqliteReferenceModel::loadFromDB(QSqlDatabase & keep_db, QSqlDatabase & db)
 		return false;
 	}
 
+	if (s_sharedDatabase) {
+		// read straight from the file mapping, which the OS shares between processes, rather than
+		// through a private page cache
+		QSqlQuery pragma = db.exec(QString("PRAGMA mmap_size=%1").arg(MmapSize));
+		debugError(pragma.isActive(), pragma);
+	}
+
 	m_sha = "";
 	QSqlQuery  query = db.exec("SELECT sha FROM lastcommit where id=0");
 	debugError(query.isActive(), query);
@@ -289,6 +340,8 @@ bool SqliteReferenceModel::loadFromDB(QSqlDatabase & keep_db, QSqlDatabase & db)
 		m_partHash.insert(modelPartShared->moduleID(), modelPart);
 		parts[dbid] = modelPart;
 
+		if (s_sharedDatabase) continue;
+
 		q2.bindValue(":moduleID", modelPartShared->moduleID());
 		q2.bindValue(":family", family);
 		q2.bindValue(":core", "1");
@@ -351,6 +404,8 @@ bool SqliteReferenceModel::loadFromDB(QSqlDatabase & keep_db, QSqlDatabase & db)
 		ModelPart * modelPart = parts.at(dbid);
 		if (modelPart != nullptr) {
 			parts.at(dbid)->setProperty(name, value, showInLabel != 0);
+			if (s_sharedDatabase) continue;
+
 			q3.bindValue(":name", name.toLower().trimmed());
 			q3.bindValue(":value", value);
 			q3.bindValue(":part_id", oldToNew[dbid]);
@@ -518,6 +573,80 @@ bool SqliteReferenceModel::loadFromDB(QSqlDatabase & keep_db, QSqlDatabase & db)
 	return true;
 }
 
+bool SqliteReferenceModel::attachDatabase(const QString & databaseName)
+{
+	// instead of the in-memory copies of the parts and properties tables, the swapping queries go through
+	// temporary views joining the parts added in memory with parts.db; a part added in memory
+	// overrides the parts.db part with the same moduleID, as in the copy
+	QSqlQuery query(m_database);
+	bool result = query.prepare("ATTACH DATABASE :uri AS partsdb");
+	debugError(result, query);
+	query.bindValue(":uri", QUrl::fromLocalFile(databaseName).toString(QUrl::FullyEncoded) + "?mode=ro");
+	if (!query.exec()) {
+		debugExec("unable to attach parts database", query);
+		return false;
+	}
+
+	// the views pass the ids of both databases through unchanged, so the indexes on them still apply;
+	// to keep them apart, the parts added in memory are renumbered above the largest parts.db ids,
+	// and sqlite_sequence is raised so that parts added later are numbered above them too
+	if (!query.exec("SELECT (SELECT coalesce(max(id), 0) FROM partsdb.parts), (SELECT coalesce(max(id), 0) FROM partsdb.properties)") || !query.next()) {
+		debugExec("unable to read parts database ids", query);
+		return false;
+	}
+	m_attachedMaxPartID = query.value(0).toULongLong();
+	qulonglong maxPropertyID = query.value(1).toULongLong();
+
+	QStringList statements;
+	statements << QString("PRAGMA partsdb.mmap_size=%1").arg(MmapSize);
+	// negate first, so no row takes an id another row still has
+	statements << "UPDATE main.parts SET id = -id"
+	           << QString("UPDATE main.parts SET id = %1 - id").arg(m_attachedMaxPartID)
+	           << QString("UPDATE main.properties SET id = -id, part_id = part_id + %1").arg(m_attachedMaxPartID)
+	           << QString("UPDATE main.properties SET id = %1 - id").arg(maxPropertyID);
+	Q_FOREACH (QString table, QStringList() << "viewimages" << "connectors" << "buses" << "schematic_subparts" << "tags") {
+		statements << QString("UPDATE main.%1 SET part_id = part_id + %2").arg(table).arg(m_attachedMaxPartID);
+	}
+	Q_FOREACH (QString table, QStringList() << "parts" << "properties") {
+		statements << QString("INSERT INTO main.sqlite_sequence(name, seq) SELECT '%1', 0 \n"
+		                      "WHERE NOT EXISTS (SELECT * FROM main.sqlite_sequence WHERE name = '%1')").arg(table);
+	}
+	statements << QString("UPDATE main.sqlite_sequence SET seq = seq + %1 WHERE name = 'parts'").arg(m_attachedMaxPartID)
+	           << QString("UPDATE main.sqlite_sequence SET seq = seq + %1 WHERE name = 'properties'").arg(maxPropertyID);
+	// parts.db is read-only, so its removed parts are hidden by id
+	statements << "CREATE TEMP TABLE removedparts (id INTEGER PRIMARY KEY NOT NULL)"
+	           << QString("CREATE TEMP VIEW parts AS \n"
+	                      "SELECT id, moduleID, family, core FROM main.parts \n"
+	                      "UNION ALL SELECT id, moduleID, family, '1' FROM partsdb.parts \n"
+	                      "WHERE moduleID NOT IN (SELECT moduleID FROM main.parts) AND id NOT IN (SELECT id FROM removedparts)")
+	           << QString("CREATE TEMP VIEW properties AS \n"
+	                      "SELECT id, name, value, show_in_label, part_id FROM main.properties \n"
+	                      "UNION ALL SELECT id, name, value, show_in_label, part_id FROM partsdb.properties \n"
+	                      "WHERE part_id NOT IN (SELECT id FROM removedparts)");
+	Q_FOREACH (QString statement, statements) {
+		if (!query.exec(statement)) {
+			debugExec("unable to set up parts database views", query);
+			return false;
+		}
+	}
+
+	if (!query.exec("SELECT id, moduleID FROM main.parts")) {
+		debugExec("unable to read renumbered parts", query);
+		return false;
+	}
+	while (query.next()) {
+		ModelPart * modelPart = m_partHash.value(query.value(1).toString(), nullptr);
+		if (modelPart != nullptr) {
+			modelPart->setDBID(query.value(0).toULongLong());
+		}
+	}
+
+	return true;
+}
+
+void SqliteReferenceModel::setSharedDatabase(bool shared) {
+	s_sharedDatabase = shared;
+}
 
 SqliteReferenceModel::~SqliteReferenceModel() {
 	deleteConnection();
@@ -530,20 +659,40 @@ void SqliteReferenceModel::initParts(bool dbExists) {
 }
 
 bool SqliteReferenceModel::createDatabase(const QString & databaseName, bool fullLoad) {
+	QElapsedTimer timer;
+	timer.start();
+
+	clearPreparedQueries();
 	m_swappingEnabled = true;
 	m_database = QSqlDatabase::addDatabase("QSQLITE");
 	m_database.setDatabaseName(databaseName.isEmpty() ? ":memory:" : databaseName);
+	if (s_sharedDatabase && !fullLoad) {
+		// so parts.db can be attached later with a read-only file: uri
+		m_database.setConnectOptions("QSQLITE_OPEN_URI");
+	}
 	if (!m_database.open()) {
 		m_swappingEnabled = false;
 	}
 	else {
 		m_keepGoing = false;
+
+		bool result = true;
+		if (fullLoad) {
+			// parts.db is built from scratch in one go (-db), so if anything fails it is simply rebuilt;
+			// no need for a rollback journal or for syncing to disk after every write
+			QSqlQuery pragma(m_database);
+			result = pragma.exec("PRAGMA journal_mode=OFF");
+			debugError(result, pragma);
+			result = pragma.exec("PRAGMA synchronous=OFF");
+			debugError(result, pragma);
+		}
+
 		bool gotTransaction = m_database.transaction();
 		if(!gotTransaction) {
 			DebugDialog::debug("Database does not support transactions", DebugDialog::Warning);
 		}
 
-		bool result = createParts(m_database, fullLoad);
+		result = createParts(m_database, fullLoad);
 
 		if (!result) {
 			DebugDialog::debug("SqliteReferenceModel::createParts failed.");
@@ -650,23 +799,51 @@ bool SqliteReferenceModel::createDatabase(const QString & databaseName, bool ful
 			}
 		}
 
+		qint64 setupTime = timer.restart();
+
 		Q_FOREACH(ModelPart* mp, m_partHash.values()) {
 			addPartAux(mp, fullLoad);
 		}
 
+		qint64 insertTime = timer.restart();
+
 		createIndexes();
 		createMoreIndexes(m_database);
 
 		m_database.commit();
 
+		DebugDialog::debug(QString("SqliteReferenceModel::createDatabase %1 parts: setup %2 ms, insert %3 ms, indexes and commit %4 ms")
+		                   .arg(m_partHash.count()).arg(setupTime).arg(insertTime).arg(timer.elapsed()));
 	}
 	return m_swappingEnabled;
 }
 
 void SqliteReferenceModel::deleteConnection() {
+	clearPreparedQueries();
 	QSqlDatabase::removeDatabase("SQLITE");
 }
 
+QSqlQuery & SqliteReferenceModel::preparedQuery(const QString & statement) {
+	// a part insert runs half a dozen statements per property, connector, layer, etc.,
+	// so prepare each statement once and rebind it, rather than re-preparing per row
+	QSqlQuery * query = m_preparedQueries.value(statement, nullptr);
+	if (query == nullptr) {
+		query = new QSqlQuery(m_database);
+		bool result = query->prepare(statement);
+		debugError(result, *query);
+		m_preparedQueries.insert(statement, query);
+	}
+
+	return *query;
+}
+
+void SqliteReferenceModel::clearPreparedQueries() {
+	Q_FOREACH (QSqlQuery * query, m_preparedQueries) {
+		delete query;
+	}
+	m_preparedQueries.clear();
+}
+
 ModelPart *SqliteReferenceModel::loadPart(const QString & path, bool update) {
 	ModelPart *modelPart = PaletteModel::loadPart(path, update);
 	if (modelPart == nullptr) return modelPart;
@@ -900,7 +1077,6 @@ bool SqliteReferenceModel::insertPart(ModelPart * modelPart, bool fullLoad) {
 	DebugModelPart = modelPart;
 
 	QHash<QString, QString> properties = modelPart->properties();
-	QSqlQuery query;
 	QString fields;
 	QString values;
 	if (fullLoad) {
@@ -911,7 +1087,7 @@ bool SqliteReferenceModel::insertPart(ModelPart * modelPart, bool fullLoad) {
 		fields =  " core";
 		values = " :core";
 	}
-	query.prepare(QString("INSERT INTO parts(moduleID, family, %1) VALUES (:moduleID, :family, %2)").arg(fields).arg(values));
+	QSqlQuery & query = preparedQuery(QString("INSERT INTO main.parts(moduleID, family, %1) VALUES (:moduleID, :family, %2)").arg(fields).arg(values));
 	query.bindValue(":moduleID", modelPart->moduleID());
 	query.bindValue(":family", properties.value("family").toLower().trimmed());
 	if (fullLoad) {
@@ -1010,8 +1186,7 @@ bool SqliteReferenceModel::insertPart(ModelPart * modelPart, bool fullLoad) {
 }
 
 bool SqliteReferenceModel::insertProperty(const QString & name, const QString & value, qulonglong id, bool showInLabel) {
-	QSqlQuery query;
-	query.prepare("INSERT INTO properties(name, value, part_id, show_in_label) VALUES (:name, :value, :part_id, :show_in_label)");
+	QSqlQuery & query = preparedQuery("INSERT INTO main.properties(name, value, part_id, show_in_label) VALUES (:name, :value, :part_id, :show_in_label)");
 	query.bindValue(":name", name.toLower().trimmed());
 	query.bindValue(":value", value);
 	query.bindValue(":part_id", id);
@@ -1028,8 +1203,7 @@ bool SqliteReferenceModel::insertProperty(const QString & name, const QString &
 
 bool SqliteReferenceModel::insertTag(const QString & tag, qulonglong id)
 {
-	QSqlQuery query;
-	query.prepare("INSERT INTO tags(tag, part_id) VALUES (:tag, :part_id)");
+	QSqlQuery & query = preparedQuery("INSERT INTO tags(tag, part_id) VALUES (:tag, :part_id)");
 	query.bindValue(":tag", tag.toLower().trimmed());
 	query.bindValue(":part_id", id);
 	if(!query.exec()) {
@@ -1046,8 +1220,7 @@ bool SqliteReferenceModel::insertViewImage(const ViewImage * viewImage, qulonglo
 {
 	if (viewImage->image.isEmpty() && viewImage->layers == 0) return true;
 
-	QSqlQuery query;
-	query.prepare("INSERT INTO viewimages(viewid, image, layers, sticky, flipvertical, fliphorizontal, part_id) "
+	QSqlQuery & query = preparedQuery("INSERT INTO viewimages(viewid, image, layers, sticky, flipvertical, fliphorizontal, part_id) "
 	              "VALUES (:viewid, :image, :layers, :sticky, :flipvertical, :fliphorizontal, :part_id)");
 	query.bindValue(":viewid", viewImage->viewID);
 	query.bindValue(":image", viewImage->image);
@@ -1068,8 +1241,7 @@ bool SqliteReferenceModel::insertViewImage(const ViewImage * viewImage, qulonglo
 
 bool SqliteReferenceModel::insertBus(const Bus * bus, qulonglong id)
 {
-	QSqlQuery query;
-	query.prepare("INSERT INTO buses(name, part_id) VALUES (:name, :part_id)");
+	QSqlQuery & query = preparedQuery("INSERT INTO buses(name, part_id) VALUES (:name, :part_id)");
 	query.bindValue(":name", bus->id());
 	query.bindValue(":part_id", id);
 	if(!query.exec()) {
@@ -1087,8 +1259,7 @@ bool SqliteReferenceModel::insertBus(const Bus * bus, qulonglong id)
 
 bool SqliteReferenceModel::insertBusMember(const Connector * connector, qulonglong id)
 {
-	QSqlQuery query;
-	query.prepare("INSERT INTO busmembers(connectorid, bus_id) VALUES (:connectorid, :bus_id)");
+	QSqlQuery & query = preparedQuery("INSERT INTO busmembers(connectorid, bus_id) VALUES (:connectorid, :bus_id)");
 	query.bindValue(":connectorid", connector->connectorSharedID());
 	query.bindValue(":bus_id", id);
 	if(!query.exec()) {
@@ -1103,8 +1274,7 @@ bool SqliteReferenceModel::insertBusMember(const Connector * connector, qulonglo
 
 bool SqliteReferenceModel::insertConnector(const Connector * connector, qulonglong id)
 {
-	QSqlQuery query;
-	query.prepare("INSERT INTO connectors(connectorid, type, name, description, replacedby, part_id) VALUES (:connectorid, :type, :name, :description, :replacedby, :part_id)");
+	QSqlQuery & query = preparedQuery("INSERT INTO connectors(connectorid, type, name, description, replacedby, part_id) VALUES (:connectorid, :type, :name, :description, :replacedby, :part_id)");
 	query.bindValue(":connectorid", connector->connectorSharedID());
 	query.bindValue(":type", (int) connector->connectorType());
 	query.bindValue(":name", connector->connectorSharedName());
@@ -1128,8 +1298,7 @@ bool SqliteReferenceModel::insertConnector(const Connector * connector, qulonglo
 bool SqliteReferenceModel::insertConnectorLayer(const SvgIdLayer * svgIdLayer, qulonglong id)
 {
 
-	QSqlQuery query;
-	query.prepare("INSERT INTO connectorLayers(view, layer, svgid, hybrid, terminalid, legid, connector_id) VALUES "
+	QSqlQuery & query = preparedQuery("INSERT INTO connectorLayers(view, layer, svgid, hybrid, terminalid, legid, connector_id) VALUES "
 	              "(:view, :layer, :svgid, :hybrid, :terminalid, :legid, :connector_id)");
 	query.bindValue(":view", svgIdLayer->m_viewID);
 	query.bindValue(":layer", svgIdLayer->m_svgViewLayerID);
@@ -1239,11 +1408,32 @@ qulonglong SqliteReferenceModel::partId(QString moduleID) {
 }
 
 bool SqliteReferenceModel::removePart(qulonglong partId) {
-	return removex(partId, "parts", "id");
+	if (partId <= m_attachedMaxPartID) {
+		return hideAttachedPart(partId);
+	}
+
+	return removex(partId, "main.parts", "id");
 }
 
 bool SqliteReferenceModel::removeProperties(qulonglong partId) {
-	return removex(partId, "properties", "part_id");
+	if (partId <= m_attachedMaxPartID) {
+		// the properties view leaves out the properties of hidden parts
+		return hideAttachedPart(partId);
+	}
+
+	return removex(partId, "main.properties", "part_id");
+}
+
+bool SqliteReferenceModel::hideAttachedPart(qulonglong partId) {
+	QSqlQuery query;
+	query.prepare("INSERT OR IGNORE INTO removedparts(id) VALUES (:id)");
+	query.bindValue(":id", partId);
+	if (!query.exec()) {
+		debugExec("couldn't hide attached part", query);
+		return false;
+	}
+
+	return true;
 }
 
 QString SqliteReferenceModel::partTitle(const QString & moduleID) {
@@ -1315,8 +1505,7 @@ bool SqliteReferenceModel::createParts(QSqlDatabase & db, bool fullLoad)
 
 bool SqliteReferenceModel::insertSubpart(ModelPartShared * mps, qulonglong id)
 {
-	QSqlQuery query;
-	query.prepare("INSERT INTO schematic_subparts(label, subpart_id, part_id) VALUES (:label, :subpart_id, :part_id)");
+	QSqlQuery & query = preparedQuery("INSERT INTO schematic_subparts(label, subpart_id, part_id) VALUES (:label, :subpart_id, :part_id)");
 	query.bindValue(":label", mps->label());
 	query.bindValue(":subpart_id", mps->subpartID());
 	query.bindValue(":part_id", id);
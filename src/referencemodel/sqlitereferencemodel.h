@@ -60,6 +60,8 @@ public:
 	const QString & sha() const;
 	const QString error() const;
 
+	static void setSharedDatabase(bool);
+
 protected:
 	void initParts(bool dbExists);
 	void killParts();
@@ -84,7 +86,9 @@ protected:
 	qulonglong partId(QString moduleID);
 	bool removePart(qulonglong partId);
 	bool removeProperties(qulonglong partId);
+	bool hideAttachedPart(qulonglong partId);
 	bool loadFromDB(QSqlDatabase & keep_db, QSqlDatabase & db);
+	bool attachDatabase(const QString & databaseName);
 	bool createProperties(QSqlDatabase &);
 	bool createParts(QSqlDatabase &, bool fullLoad);
 	bool insertSubpart(ModelPartShared *, qulonglong id);
@@ -99,6 +103,8 @@ protected:
 	bool removex(qulonglong id, const QString & tableName, const QString & idName);
 	bool removePart(const QString & moduleId);
 	bool removePartFromDataBase(const QString & moduleId);
+	QSqlQuery & preparedQuery(const QString & statement);
+	void clearPreparedQueries();
 
 protected:
 	volatile bool m_swappingEnabled;
@@ -108,6 +114,10 @@ protected:
 	QSqlDatabase m_database;
 	QMultiHash<QString /*name*/, QString /*value*/> m_recordedProperties;
 	QString m_sha;
+	QHash<QString, QSqlQuery *> m_preparedQueries;   // statement -> query prepared once on m_database and reused for bulk inserts
+	qulonglong m_attachedMaxPartID;                  // parts.db ids go up to here when it is attached; the parts added in memory are numbered above
+
+	static bool s_sharedDatabase;		// query parts.db in place (read-only, memory mapped) rather than copying it into m_database
 };
 
 #endif /* SQLITEREFERENCEMODEL_H_ */
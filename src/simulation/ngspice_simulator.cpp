@@ -42,6 +42,7 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 NgSpiceSimulator::NgSpiceSimulator()
 	: m_isInitialized(false)
 	, m_isBGThreadRunning(false)
+	, m_circuitOwner(nullptr)
 	, m_errorTitle(std::nullopt) {
 }
 
@@ -122,7 +123,18 @@ bool NgSpiceSimulator::isBGThreadRunning() {
 	return m_isBGThreadRunning;
 }
 
-void NgSpiceSimulator::loadCircuit(const std::string& netList) {
+void NgSpiceSimulator::setBGThreadFinishedCallback(const void * owner, std::function<void()> callback) {
+	std::lock_guard<std::mutex> lock(m_callbackMutex);
+	m_bgThreadFinishedCallbacks[owner] = callback;
+}
+
+void NgSpiceSimulator::removeBGThreadFinishedCallback(const void * owner) {
+	std::lock_guard<std::mutex> lock(m_callbackMutex);
+	m_bgThreadFinishedCallbacks.erase(owner);
+}
+
+void NgSpiceSimulator::loadCircuit(const std::string& netList, const void * owner) {
+	m_circuitOwner = owner;
 	std::stringstream stream(netList);
 	std::string component;
 	std::vector<char *> components;
@@ -140,6 +152,10 @@ void NgSpiceSimulator::loadCircuit(const std::string& netList) {
 	setlocale(LC_NUMERIC, previousLocale.c_str());
 }
 
+const void * NgSpiceSimulator::circuitOwner() const {
+	return m_circuitOwner;
+}
+
 void NgSpiceSimulator::command(const std::string& command) {
 	if (!m_isInitialized) {
 		init();
@@ -240,5 +256,11 @@ int NgSpiceSimulator::BGThreadRunningFunc(bool notRunning, int libId, void*) {
 	std::cout << "BGThreadRunningFunc (libId:" << libId << "): " << std::endl;
 	auto simulator = getInstance();
 	simulator->m_isBGThreadRunning = !notRunning;
+	if (notRunning) {
+		std::lock_guard<std::mutex> lock(simulator->m_callbackMutex);
+		for (auto & callback : simulator->m_bgThreadFinishedCallbacks) {
+			callback.second();
+		}
+	}
 	return 0;
 }
@@ -23,8 +23,11 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 
 #include <ngspice/sharedspice.h>
 
+#include <atomic>
+#include <functional>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 
 #pragma once
@@ -99,11 +102,41 @@ public:
 	 */
 	void resetIsBGThreadRunning();
 
+	/**
+	 * @brief Set the function to be called for the given owner each time the ngspice library background thread stops.
+	 *
+	 * The library is shared by all windows, so each owner has its own function and setting one does not
+	 * replace another owner's. The function is called from the ngspice background thread, so it should
+	 * only post an event to the thread that needs the results.
+	 * @param[in] owner object the function belongs to, usually the caller
+	 * @param[in] callback function to call when the background thread stops
+	 */
+	void setBGThreadFinishedCallback(const void * owner, std::function<void()> callback);
+
+	/**
+	 * @brief Remove the function set for the given owner.
+	 *
+	 * Waits for the function to return if the background thread is calling it, so the owner can be
+	 * destroyed afterwards.
+	 * @param[in] owner object the function was set for
+	 */
+	void removeBGThreadFinishedCallback(const void * owner);
+
 	/**
 	 * @brief Load a circuit given as a netlist into the ngspice library.
 	 * @param[in] netList netlist that represents the circuit to be loaded into ngspice library
+	 * @param[in] owner object the circuit belongs to, usually the caller
+	 */
+	void loadCircuit(const std::string& netList, const void * owner = nullptr);
+
+	/**
+	 * @brief Return the owner given to the last loadCircuit() call.
+	 *
+	 * The library is shared by all windows, so a window that alters its circuit in place
+	 * must check that the loaded circuit is still its own.
+	 * @return owner of the loaded circuit
 	 */
-	void loadCircuit(const std::string& netList);
+	const void * circuitOwner() const;
 
 	/**
 	 * @brief Call the ngspice library ngSpice_Command function with the given command.
@@ -183,8 +216,27 @@ private:
 
 	/**
 	 * @brief Flag that indicates if the ngspice library background thread is running.
+	 *
+	 * Written from the ngspice background thread.
+	 */
+	std::atomic<bool> m_isBGThreadRunning;
+
+	/**
+	 * @brief Functions called from BGThreadRunningFunc when the background thread stops, by owner.
+	 *
+	 * Guarded by m_callbackMutex, since the background thread reads them.
+	 */
+	std::map<const void *, std::function<void()>> m_bgThreadFinishedCallbacks;
+
+	/**
+	 * @brief Mutex for m_bgThreadFinishedCallbacks.
+	 */
+	std::mutex m_callbackMutex;
+
+	/**
+	 * @brief Owner of the circuit loaded by loadCircuit().
 	 */
-	bool m_isBGThreadRunning;
+	const void * m_circuitOwner;
 
 	/**
 	 * @brief Current error title if an error occurred and otherwise std::nullopt.
@@ -43,6 +43,7 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include "../utils/fmessagebox.h"
 #include "../utils/textutils.h"
 #include "../simulation/ngspice_simulator.h"
+#include "../mainwindow/getspice.h"
 #include "../items/led.h"
 #include "../items/wire.h"
 #include "../items/breadboard.h"
@@ -50,6 +51,7 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include "../items/symbolpaletteitem.h"
 #include "../items/perfboard.h"
 #include "../items/partlabel.h"
+#include "../testing/FProbeTiming.h"
 
 #include <ngspice/sharedspice.h>
 
@@ -67,6 +69,13 @@ Simulator::Simulator(MainWindow *mainWindow) : QObject(mainWindow) {
 	m_simTimer->setSingleShot(true);
 	connect(m_simTimer, &QTimer::timeout, this, &Simulator::simulate);
 
+	m_timeoutTimer = new QTimer(this);
+	m_timeoutTimer->setSingleShot(true);
+	connect(m_timeoutTimer, &QTimer::timeout, this, &Simulator::simulationTimedOut);
+
+	//Emitted from the ngspice background thread; the results are collected in the GUI thread
+	connect(this, &Simulator::backgroundThreadFinished, this, &Simulator::collectResults, Qt::QueuedConnection);
+
 	QSettings settings;
 	int enabled = settings.value("simulatorEnabled", 0).toInt();
 	enable(enabled);
@@ -75,6 +84,10 @@ Simulator::Simulator(MainWindow *mainWindow) : QObject(mainWindow) {
 }
 
 Simulator::~Simulator() {
+	if (m_simulator) {
+		m_simulator->removeBGThreadFinishedCallback(this);
+	}
+	clearCircuit();
 }
 
 /**
@@ -85,6 +98,21 @@ Simulator::~Simulator() {
  */
 void Simulator::triggerSimulation()
 {
+	m_fullRebuild = true;
+	if(m_simulating) {
+		resetTimer();
+	}
+}
+
+/**
+ * Triggers a simulation after a property value of a single part has changed. If nothing else
+ * changes before the simulation runs, the new values are applied to the circuit already loaded
+ * in ngspice instead of generating and loading the netlist again.
+ * @param[in] itemID id of the part whose property has changed
+ */
+void Simulator::triggerSimulation(long itemID)
+{
+	m_changedItemIDs.insert(itemID);
 	if(m_simulating) {
 		resetTimer();
 	}
@@ -131,6 +159,7 @@ void Simulator::enable(bool enable) {
 void Simulator::startSimulation()
 {
 	m_simulating = true;
+	m_fullRebuild = true;
 	emit simulationStartedOrStopped(m_simulating);
 	simulate();
 }
@@ -142,6 +171,13 @@ void Simulator::startSimulation()
  */
 void Simulator::stopSimulation() {
 	m_simulating = false;
+	m_fullRebuild = true;
+	if (m_waitingForResults) {
+		m_waitingForResults = false;
+		m_rerunPending = false;
+		m_timeoutTimer->stop();
+		m_simulator->command("bg_halt");
+	}
 	removeSimItems();
 	emit simulationStartedOrStopped(m_simulating);
 }
@@ -154,13 +190,17 @@ void Simulator::stopSimulation() {
  * - Gets the current spice netlist
  * - Loads the netlist in Ngspice
  * - Runs a operating point analysis in a background thread
- * - Remove all previous items placed by the simulator (smokes, messages in the multimeters, etc.)
- * - Grey out the parts that are not being simulated
- * - Wait until the simulation has finished (timeout of 3s)
- * - Iterate for all parts being simulated to
- *     - Check if they work within specifications, add smoke if needed
- *     - Update display messages in the multimeters
- *     - Update LEDs colours
+ * - Returns without waiting; when the background thread finishes, collectResults() is called
+ *   in the GUI thread (timeout of 3s) to:
+ *     - Remove all previous items placed by the simulator (smokes, messages in the multimeters, etc.)
+ *     - Grey out the parts that are not being simulated
+ *     - Iterate for all parts being simulated to
+ *         - Check if they work within specifications, add smoke if needed
+ *         - Update display messages in the multimeters
+ *         - Update LEDs colours
+ *
+ * If the circuit changes while it is being simulated, a single new simulation with all the
+ * changes runs when the current one finishes.
  *
  * Excludes all the parts that don not have spice models or that they are not connected to other parts
  * @brief Simulate the current circuit and check for components working out of specifications
@@ -171,6 +211,14 @@ void Simulator::simulate() {
 		return;
 	}
 
+	if (m_waitingForResults) {
+		//The circuit is being simulated; run again with all the changes made meanwhile when it finishes
+		m_rerunPending = true;
+		return;
+	}
+
+	m_latencyTimer.start();
+
 	m_simulator = NgSpiceSimulator::getInstance();
 	try {
 		m_simulator->init();
@@ -190,77 +238,82 @@ void Simulator::simulate() {
 	//Empty the stderr and stdout buffers
 	m_simulator->clearLog();
 
-	QList< QList<ConnectorItem *>* > netList;
-	QSet<ItemBase *> itemBases;
-	QString spiceNetlist = m_mainWindow->getSpiceNetlist("Simulator Netlist", netList, itemBases);
-
-	std::cout << "Netlist: " << spiceNetlist.toStdString() << std::endl;
-
-	//std::cout << "-----------------------------------" <<std::endl;
-	std::cout << "Running command(remcirc):" <<std::endl;
-	m_simulator->command("remcirc");
-	//std::cout << "-----------------------------------" <<std::endl;
-	std::cout << "Running m_simulator->command('reset'):" <<std::endl;
-	m_simulator->command("reset");
-	m_simulator->clearLog();
-
-	std::cout << "-----------------------------------" <<std::endl;
-	std::cout << "Running LoadNetlist:" <<std::endl;
-
-	m_simulator->loadCircuit(spiceNetlist.toStdString());
-
-	if (QString::fromStdString(m_simulator->getLog(false)).toLower().contains("error") || // "error on line"
-		QString::fromStdString(m_simulator->getLog(true)).toLower().contains("warning")) { // "warning, can't find model"
-		//Ngspice found an error, do not continue
-		std::cout << "Error loading the netlist. Probably some SPICE field is wrong, check them." <<std::endl;
-		//TODO: Create copy to clipboard button o make this selectable ans resizeable!
-		FMessageBox::warning(nullptr, tr("Simulator Error"),
-								 tr("The simulator gave an error when loading the netlist. "
-									"Probably some SPICE field is wrong, please, check them.\n"
-									"If the parts are from the simulation bin, report the bug in GitHub.\n\nErrors:\n") +
-								QString::fromStdString(m_simulator->getLog(false)) +
-								QString::fromStdString(m_simulator->getLog(true)) +
-								 "\n\nNetlist:\n" + spiceNetlist);
-		stopSimulation();
+	//If only property values of simulated parts have changed, alter the circuit already loaded in ngspice.
+	//Otherwise, generate the netlist again and reload the circuit.
+	m_incremental = !m_fullRebuild && alterCircuit();
+	m_fullRebuild = false;
+	m_changedItemIDs.clear();
+	if (!m_incremental && !loadCircuit()) {
 		return;
 	}
-	std::cout << "-----------------------------------" <<std::endl;
-	std::cout << "Running command(listing):" <<std::endl;
-	m_simulator->command("listing");
+
 	std::cout << "-----------------------------------" <<std::endl;
 	std::cout << "Running m_simulator->command(bg_run):" <<std::endl;
+	//The ngspice background thread notifies the end of the simulation
+	m_simulator->setBGThreadFinishedCallback(this, [this]() {
+		emit backgroundThreadFinished();
+	});
+	m_waitingForResults = true;
 	m_simulator->resetIsBGThreadRunning();
 	m_simulator->command("bg_run");
+	m_timeoutTimer->start(SimTimeOut);
 	std::cout << "-----------------------------------" <<std::endl;
-	std::cout << "Generating a hash table to find the net of specific connectors:" <<std::endl;
 	//While the spice simulator runs, we will perform some tasks:
 
-	//Generate a hash table to find the net of specific connectors
-	std::cout << "Generate a hash table to find the net of specific connectors" <<std::endl;
-	m_connector2netHash.clear();
-	for (int i=0; i<netList.size(); i++) {
-		QList<ConnectorItem *> * net = netList.at(i);
-		foreach (ConnectorItem * ci, *net) {
-			m_connector2netHash.insert(ci, i);
+	if (!m_incremental) {
+		//Generate a hash table to find the net of specific connectors
+		std::cout << "Generate a hash table to find the net of specific connectors" <<std::endl;
+		m_connector2netHash.clear();
+		for (int i=0; i<m_netList.size(); i++) {
+			QList<ConnectorItem *> * net = m_netList.at(i);
+			foreach (ConnectorItem * ci, *net) {
+				m_connector2netHash.insert(ci, i);
+			}
 		}
-	}
-	std::cout << "-----------------------------------" <<std::endl;
-	std::cout << "Generating a hash table to find the breadboard parts from parts in the schematic view:" <<std::endl;
-
-	//Generate a hash table to find the breadboard parts from parts in the schematic view
-	std::cout << "Generate a hash table to find the breadboard parts from parts in the schematic view" <<std::endl;
-	m_sch2bbItemHash.clear();
-	foreach (ItemBase* schPart, itemBases) {
-		m_instanceTitleSim->append(schPart->instanceTitle());
-		foreach (QGraphicsItem * bbItem, m_breadboardGraphicsView->scene()->items()) {
-			ItemBase * bbPart = dynamic_cast<ItemBase *>(bbItem);
-			if (!bbPart) continue;
-			if (schPart->instanceTitle().compare(bbPart->instanceTitle()) == 0) {
-				m_sch2bbItemHash.insert(schPart, bbPart);
+		std::cout << "-----------------------------------" <<std::endl;
+
+		//Generate a hash table to find the breadboard parts from parts in the schematic view
+		std::cout << "Generate a hash table to find the breadboard parts from parts in the schematic view" <<std::endl;
+		m_sch2bbItemHash.clear();
+		foreach (ItemBase* schPart, m_itemBases) {
+			m_instanceTitleSim->append(schPart->instanceTitle());
+			foreach (QGraphicsItem * bbItem, m_breadboardGraphicsView->scene()->items()) {
+				ItemBase * bbPart = dynamic_cast<ItemBase *>(bbItem);
+				if (!bbPart) continue;
+				if (schPart->instanceTitle().compare(bbPart->instanceTitle()) == 0) {
+					m_sch2bbItemHash.insert(schPart, bbPart);
+				}
 			}
 		}
+		std::cout << "-----------------------------------" <<std::endl;
 	}
+}
+
+/**
+ * Called in the GUI thread when the ngspice background thread has finished the simulation
+ * started by simulate(). Updates the parts with the results, unless the circuit has been
+ * modified while it was being simulated; in that case the results are discarded and the
+ * circuit is simulated again with all the pending changes.
+ */
+void Simulator::collectResults() {
+	if (!m_waitingForResults || m_simulator->isBGThreadRunning()) return;
+
+	m_waitingForResults = false;
+	m_timeoutTimer->stop();
+	std::cout << "The spice simulator has finished." <<std::endl;
 	std::cout << "-----------------------------------" <<std::endl;
+
+	if (!m_enabled || !m_simulating) return;
+
+	// m_itemBases and the netlist belong to the circuit that was simulated: if anything has changed
+	// since (and the timer has not fired yet), parts may have been deleted, so don't touch them
+	if (m_rerunPending || m_simTimer->isActive() || m_fullRebuild || !m_changedItemIDs.isEmpty()) {
+		m_rerunPending = false;
+		m_simTimer->stop();
+		simulate();
+		return;
+	}
+
 	std::cout << "Removing the items added by the simulator last time it run (smoke, displayed text in multimeters, etc.):" <<std::endl;
 
 	//Removes the items added by the simulator last time it run (smoke, displayed text in multimeters, etc.)
@@ -271,23 +324,7 @@ void Simulator::simulate() {
 
 	//If there are parts that are not being simulated, grey them out
 	std::cout << "greyOutNonSimParts(itemBases);" <<std::endl;
-	greyOutNonSimParts(itemBases);
-	std::cout << "-----------------------------------" <<std::endl;
-
-	std::cout << "Waiting for simulator thread to stop" <<std::endl;
-	int elapsedTime = 0, simTimeOut = 3000; // in ms
-	while (m_simulator->isBGThreadRunning() && elapsedTime < simTimeOut) {
-		QThread::usleep(1000);
-		elapsedTime++;
-	}
-	if (elapsedTime >= simTimeOut) {
-		m_simulator->command("bg_halt");
-		stopSimulation();
-		FMessageBox::warning(m_mainWindow, tr("Simulator Timeout"), tr("The spice simulator did not finish after %1 ms. Aborting simulation.").arg(simTimeOut));
-		return;
-	} else {
-		std::cout << "The spice simulator has finished." <<std::endl;
-	}
+	greyOutNonSimParts(m_itemBases);
 	std::cout << "-----------------------------------" <<std::endl;
 
 	if (m_simulator->errorOccured() ||
@@ -295,13 +332,14 @@ void Simulator::simulate() {
 		//Ngspice found an error, do not continue
 		std::cout << "Fatal error found, stopping the simulation." <<std::endl;
 		removeSimItems();
+		m_fullRebuild = true;
 		QWidget * tempWidget = new QWidget();
 		QMessageBox::warning(tempWidget, tr("Simulator Error"),
 								 tr("The simulator gave an error when trying to simulate this circuit. "
 									"Please, check the wiring and try again. \n\nErrors:\n") +
 								QString::fromStdString(m_simulator->getLog(false)) +
 								QString::fromStdString(m_simulator->getLog(true)) +
-								 "\n\nNetlist:\n" + spiceNetlist);
+								 "\n\nNetlist:\n" + m_spiceNetlist);
 		delete tempWidget;
 		return;
 	}
@@ -312,7 +350,7 @@ void Simulator::simulate() {
 	// * update the multimeters screen
 	// * add smoke to a part if something is out of its specifications
 	// * update the brightness of the LEDs
-	foreach (ItemBase * part, itemBases){
+	foreach (ItemBase * part, m_itemBases){
 		//Remove the effects, if any
 		part->setGraphicsEffect(nullptr);
 		m_sch2bbItemHash.value(part)->setGraphicsEffect(nullptr);
@@ -362,11 +400,195 @@ void Simulator::simulate() {
 
 	}
 
-	//Delete the pointers
-	foreach (QList<ConnectorItem *> * net, netList) {
+	FProbeTiming::probe("Simulation")->record(m_latencyTimer.nsecsElapsed());
+	std::cout << "Simulation latency: " << m_latencyTimer.elapsed() << " ms ("
+			  << (m_incremental ? "altered circuit" : "reloaded circuit") << ")" << std::endl;
+}
+
+/**
+ * Aborts the simulation if the ngspice background thread has not finished after SimTimeOut ms.
+ */
+void Simulator::simulationTimedOut() {
+	if (!m_waitingForResults) return;
+
+	m_waitingForResults = false;
+	m_rerunPending = false;
+	m_simulator->command("bg_halt");
+	stopSimulation();
+	FMessageBox::warning(m_mainWindow, tr("Simulator Timeout"), tr("The spice simulator did not finish after %1 ms. Aborting simulation.").arg(SimTimeOut));
+}
+
+/**
+ * Generates the spice netlist of the current circuit and loads it in ngspice, replacing
+ * the circuit loaded before. The netlist, the parts being simulated and the spice lines of
+ * each part are kept so that later value changes can be applied with alterCircuit().
+ * @returns true if the circuit was loaded, false if ngspice reported an error (the simulation is stopped)
+ */
+bool Simulator::loadCircuit() {
+	clearCircuit();
+
+	m_spiceNetlist = m_mainWindow->getSpiceNetlist("Simulator Netlist", m_netList, m_itemBases);
+	foreach (ItemBase * part, m_itemBases) {
+		m_partSpice.insert(part->id(), GetSpice::getSpice(part, m_netList));
+	}
+
+	std::cout << "Netlist: " << m_spiceNetlist.toStdString() << std::endl;
+
+	//std::cout << "-----------------------------------" <<std::endl;
+	std::cout << "Running command(remcirc):" <<std::endl;
+	m_simulator->command("remcirc");
+	//std::cout << "-----------------------------------" <<std::endl;
+	std::cout << "Running m_simulator->command('reset'):" <<std::endl;
+	m_simulator->command("reset");
+	m_simulator->clearLog();
+
+	std::cout << "-----------------------------------" <<std::endl;
+	std::cout << "Running LoadNetlist:" <<std::endl;
+
+	m_simulator->loadCircuit(m_spiceNetlist.toStdString(), this);
+
+	if (QString::fromStdString(m_simulator->getLog(false)).toLower().contains("error") || // "error on line"
+		QString::fromStdString(m_simulator->getLog(true)).toLower().contains("warning")) { // "warning, can't find model"
+		//Ngspice found an error, do not continue
+		std::cout << "Error loading the netlist. Probably some SPICE field is wrong, check them." <<std::endl;
+		//TODO: Create copy to clipboard button o make this selectable ans resizeable!
+		FMessageBox::warning(nullptr, tr("Simulator Error"),
+								 tr("The simulator gave an error when loading the netlist. "
+									"Probably some SPICE field is wrong, please, check them.\n"
+									"If the parts are from the simulation bin, report the bug in GitHub.\n\nErrors:\n") +
+								QString::fromStdString(m_simulator->getLog(false)) +
+								QString::fromStdString(m_simulator->getLog(true)) +
+								 "\n\nNetlist:\n" + m_spiceNetlist);
+		stopSimulation();
+		return false;
+	}
+	std::cout << "-----------------------------------" <<std::endl;
+	std::cout << "Running command(listing):" <<std::endl;
+	m_simulator->command("listing");
+
+	m_circuitLoaded = true;
+	return true;
+}
+
+/**
+ * Applies the property changes recorded by triggerSimulation(long) to the circuit that is
+ * loaded in ngspice, using the alter and alterparam commands. The netlist is not generated
+ * again; only the spice lines of the changed parts are, using the nets of the loaded circuit.
+ * @returns true if the loaded circuit has been updated, false if the circuit needs to be reloaded
+ */
+bool Simulator::alterCircuit() {
+	if (!m_circuitLoaded || m_changedItemIDs.isEmpty()) return false;
+
+	// ngspice is shared by all windows; another window may have loaded its circuit since
+	if (m_simulator->circuitOwner() != this) return false;
+
+	QStringList commands;
+	QHash<long, QString> changedSpice;
+	foreach (long id, m_changedItemIDs) {
+		if (!m_partSpice.contains(id)) {
+			//Parts that are not being simulated (not connected or without spice lines) do not affect the results
+			continue;
+		}
+		ItemBase * part = m_schematicGraphicsView->findItem(id);
+		if (!part || !m_itemBases.contains(part)) return false;
+
+		QString spice = GetSpice::getSpice(part, m_netList);
+		if (!alterCommands(m_partSpice.value(id), spice, commands)) {
+			std::cout << "The change in " << part->instanceTitle().toStdString() << " can not be altered, reloading the circuit" << std::endl;
+			return false;
+		}
+		changedSpice.insert(id, spice);
+	}
+
+	bool alterParam = false;
+	foreach (QString command, commands) {
+		std::cout << "Running command(" << command.toStdString() << "):" << std::endl;
+		m_simulator->command(command.toStdString());
+		alterParam = alterParam || command.startsWith("alterparam");
+	}
+	if (alterParam) {
+		//New parameter values take effect after the circuit is reset
+		m_simulator->command("reset");
+	}
+
+	if (m_simulator->errorOccured() || QString::fromStdString(m_simulator->getLog(true)).toLower().contains("error")) {
+		m_simulator->clearLog();
+		return false;
+	}
+
+	foreach (long id, changedSpice.keys()) {
+		m_spiceNetlist.replace(m_partSpice.value(id), changedSpice.value(id));
+		m_partSpice.insert(id, changedSpice.value(id));
+	}
+	return true;
+}
+
+/**
+ * Compares the spice lines of a part before and after a property change and, if only device
+ * values or parameters differ, generates the ngspice commands that apply the new values.
+ * Only resistors, capacitors, inductors, dc sources and .param lines can be altered.
+ * @param[in] oldSpice spice lines of the part in the loaded circuit
+ * @param[in] newSpice spice lines of the part after the change
+ * @param[out] commands the alter and alterparam commands are appended here
+ * @returns false if the change affects anything other than values (the circuit needs to be reloaded)
+ */
+bool Simulator::alterCommands(const QString & oldSpice, const QString & newSpice, QStringList & commands) {
+	static const QRegularExpression whitespace("\\s+");
+	static const QRegularExpression number("^[-+]?(\\d+\\.?\\d*|\\.\\d+)(e[-+]?\\d+)?[a-z]*$", QRegularExpression::CaseInsensitiveOption);
+	static const QRegularExpression param("^\\.param\\s+(\\w+)\\s*=\\s*(\\S+)$", QRegularExpression::CaseInsensitiveOption);
+
+	if (oldSpice == newSpice) return true;
+
+	QStringList oldLines = oldSpice.split("\n", Qt::SkipEmptyParts);
+	QStringList newLines = newSpice.split("\n", Qt::SkipEmptyParts);
+	if (oldLines.count() != newLines.count()) return false;
+
+	for (int i = 0; i < oldLines.count(); i++) {
+		QString oldLine = oldLines.at(i).trimmed();
+		QString newLine = newLines.at(i).trimmed();
+		if (oldLine == newLine) continue;
+
+		QRegularExpressionMatch oldParam = param.match(oldLine);
+		QRegularExpressionMatch newParam = param.match(newLine);
+		if (oldParam.hasMatch() && newParam.hasMatch()) {
+			if (oldParam.captured(1).compare(newParam.captured(1), Qt::CaseInsensitive) != 0) return false;
+			commands.append(QString("alterparam %1 = %2").arg(newParam.captured(1), newParam.captured(2)));
+			continue;
+		}
+
+		//Device lines: name, two nodes and the value. The name and the nodes must not change.
+		QStringList oldTokens = oldLine.split(whitespace, Qt::SkipEmptyParts);
+		QStringList newTokens = newLine.split(whitespace, Qt::SkipEmptyParts);
+		if (oldTokens.count() < 4 || newTokens.count() != oldTokens.count()) return false;
+		for (int t = 0; t < 3; t++) {
+			if (oldTokens.at(t).compare(newTokens.at(t), Qt::CaseInsensitive) != 0) return false;
+		}
+
+		QChar deviceType = newTokens.at(0).at(0).toUpper();
+		QStringList valueTokens = newTokens.mid(3);
+		if ((deviceType == 'V' || deviceType == 'I') && valueTokens.count() == 2 && valueTokens.at(0).compare("dc", Qt::CaseInsensitive) == 0) {
+			valueTokens.removeFirst();
+		}
+		if (QString("RCLVI").indexOf(deviceType) < 0 || valueTokens.count() != 1) return false;
+		if (!number.match(valueTokens.at(0)).hasMatch()) return false;
+
+		commands.append(QString("alter %1 = %2").arg(newTokens.at(0), valueTokens.at(0)));
+	}
+	return true;
+}
+
+/**
+ * Forgets the circuit loaded in ngspice and deletes the nets it was built from.
+ */
+void Simulator::clearCircuit() {
+	foreach (QList<ConnectorItem *> * net, m_netList) {
 		delete net;
 	}
-	netList.clear();
+	m_netList.clear();
+	m_itemBases.clear();
+	m_partSpice.clear();
+	m_spiceNetlist.clear();
+	m_circuitLoaded = false;
 }
 
 /**
@@ -25,6 +25,8 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include "../items/itembase.h"
 #include "../simulation/ngspice_simulator.h"
 
+#include <QElapsedTimer>
+
 enum TransistorLeg { BASE, COLLECTOR, EMITER };
 
 class Simulator : public QObject
@@ -37,6 +39,7 @@ public:
 	bool isEnabled();
 	bool isSimulating();
 	void triggerSimulation();
+	void triggerSimulation(long itemID);
 	void simulate();
 
 private:
@@ -47,9 +50,14 @@ public slots:
 	void stopSimulation();
 	void startSimulation();
 
+protected slots:
+	void collectResults();
+	void simulationTimedOut();
+
 signals:
 	void simulationStartedOrStopped(bool running);
 	void simulationEnabled(bool enabled);
+	void backgroundThreadFinished();
 
 protected:	
 	void drawSmoke(ItemBase* part);
@@ -61,6 +69,11 @@ protected:
 	void greyOutParts(const QList<QGraphicsItem *> &);
 	void removeItemsToBeSimulated(QList<QGraphicsItem*> &);
 
+	bool loadCircuit();
+	bool alterCircuit();
+	bool alterCommands(const QString & oldSpice, const QString & newSpice, QStringList & commands);
+	void clearCircuit();
+
 	QChar getDeviceType (ItemBase*);
 	double getMaxPropValue(ItemBase*, QString);
 	QString getSymbol(ItemBase*, QString);
@@ -92,9 +105,24 @@ protected:
 	QHash<ItemBase *, ItemBase *> m_sch2bbItemHash;
 	QHash<ConnectorItem *, int> m_connector2netHash;
 
+	//State of the circuit currently loaded in ngspice, kept to apply value-only changes with alter
+	bool m_circuitLoaded = false;
+	bool m_fullRebuild = true;
+	QSet<long> m_changedItemIDs;
+	QList< QList<ConnectorItem *>* > m_netList;
+	QSet<ItemBase *> m_itemBases;
+	QHash<long, QString> m_partSpice;
+	QString m_spiceNetlist;
+
 	QList<QString>* m_instanceTitleSim;
 	QTimer *m_simTimer;
+	QTimer *m_timeoutTimer;
+	QElapsedTimer m_latencyTimer;
+	bool m_incremental = false;
+	bool m_waitingForResults = false;
+	bool m_rerunPending = false;
 	static constexpr int SimDelay = 200;
+	static constexpr int SimTimeOut = 3000; // in ms
 	static constexpr double HarmfulNegativeVoltage = -0.5;
 
 };
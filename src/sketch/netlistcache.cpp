@@ -0,0 +1,194 @@
+/*******************************************************************
+
+Part of the Fritzing project - http://fritzing.org
+Copyright (c) 2007-2019 Fritzing
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************/
+
+#include "netlistcache.h"
+#include "sketchwidget.h"
+#include "../connectors/connectoritem.h"
+#include "../items/itembase.h"
+#include "../items/wire.h"
+
+NetlistCache::NetlistCache(QObject * parent) : QObject(parent)
+{
+}
+
+NetlistCache::~NetlistCache()
+{
+	invalidate();
+}
+
+void NetlistCache::invalidate()
+{
+	Q_FOREACH (Graph * graph, m_graphs) {
+		delete graph;
+	}
+	m_graphs.clear();
+	m_revisions.clear();
+}
+
+NetlistCache::Graph * NetlistCache::graph(SketchWidget * sketchWidget)
+{
+	Graph * graph = m_graphs.value(sketchWidget, nullptr);
+	if (graph != nullptr && m_revisions.value(sketchWidget) == ItemBase::ConnectivityRevision) {
+		m_hits++;
+		return graph;
+	}
+
+	m_misses++;
+	delete graph;
+	graph = new Graph;
+	m_graphs.insert(sketchWidget, graph);
+	m_revisions.insert(sketchWidget, ItemBase::ConnectivityRevision);
+
+	// the connectors in the scene come first, in scene order, since nets are started from them in that order
+	Q_FOREACH (QGraphicsItem * item, sketchWidget->scene()->items()) {
+		auto * connectorItem = dynamic_cast<ConnectorItem *>(item);
+		if (connectorItem == nullptr) continue;
+
+		graph->nodes[addNode(graph, connectorItem)].inScene = true;
+	}
+
+	// connected items outside the scene are appended as they turn up
+	for (int i = 0; i < graph->nodes.count(); i++) {
+		ConnectorItem * connectorItem = graph->nodes.at(i).connectorItem;
+		ConnectorItem * crossConnectorItem = connectorItem->getCrossLayerConnectorItem();
+		int crossLayer = (crossConnectorItem == nullptr) ? -1 : addNode(graph, crossConnectorItem);
+
+		QList<int> connectedTo;
+		Q_FOREACH (ConnectorItem * toConnectorItem, connectorItem->connectedToItems()) {
+			connectedTo.append(addNode(graph, toConnectorItem));
+		}
+
+		QList<int> busMates;
+		Bus * bus = connectorItem->bus();
+		if (bus != nullptr) {
+			QList<ConnectorItem *> busConnectedItems;
+			connectorItem->attachedTo()->busConnectorItems(bus, connectorItem, busConnectedItems);
+			Q_FOREACH (ConnectorItem * busConnectedItem, busConnectedItems) {
+				busMates.append(addNode(graph, busConnectedItem));
+			}
+		}
+
+		Node & node = graph->nodes[i];
+		node.crossLayer = crossLayer;
+		node.connectedTo = connectedTo;
+		node.busMates = busMates;
+	}
+
+	sketchWidget->collectParts(graph->parts);
+	return graph;
+}
+
+int NetlistCache::addNode(Graph * graph, ConnectorItem * connectorItem)
+{
+	int ix = graph->index.value(connectorItem, -1);
+	if (ix >= 0) return ix;
+
+	Node node;
+	node.connectorItem = connectorItem;
+	if (connectorItem->attachedToItemType() == ModelPart::Wire) {
+		node.wire = qobject_cast<Wire *>(connectorItem->attachedTo());
+	}
+	node.copper1 = (connectorItem->attachedToViewLayerID() == ViewLayer::Copper1);
+
+	ix = graph->nodes.count();
+	graph->nodes.append(node);
+	graph->index.insert(connectorItem, ix);
+	return ix;
+}
+
+void NetlistCache::collectAllNets(
+    SketchWidget * sketchWidget,
+    QHash<ConnectorItem *, int> & indexer,
+    QList< QList<ConnectorItem *>* > & allPartConnectorItems,
+    bool includeSingletons,
+    bool bothSides,
+    ViewGeometry::WireFlags skipFlags,
+    bool skipBuses)
+{
+	if (sketchWidget == nullptr) return;
+
+	// the same walk as SketchWidget::collectAllNets and ConnectorItem::collectEqualPotential, over the cached graph
+	const QVector<Node> & nodes = graph(sketchWidget)->nodes;
+	QVector<bool> done(nodes.count(), false);
+	QVector<int> queuedFor(nodes.count(), -1);
+	for (int start = 0; start < nodes.count(); start++) {
+		if (done.at(start) || !nodes.at(start).inScene) continue;
+		if (!bothSides && nodes.at(start).copper1) continue;
+
+		done[start] = true;
+		QList<int> pending;
+		pending.append(start);
+		queuedFor[start] = start;
+		auto enqueue = [&pending, &queuedFor, start](int n) {
+			if (queuedFor.at(n) == start) return;
+			queuedFor[n] = start;
+			pending.append(n);
+		};
+
+		QList<ConnectorItem *> connectorItems;
+		for (int i = 0; i < pending.count(); i++) {
+			const Node & node = nodes.at(pending.at(i));
+			if (node.wire != nullptr) {
+				if (node.wire->hasAnyFlag(skipFlags)) continue;
+			}
+			else if (bothSides && node.crossLayer >= 0) {
+				enqueue(node.crossLayer);
+			}
+
+			connectorItems.append(node.connectorItem);
+			done[pending.at(i)] = true;
+
+			Q_FOREACH (int to, node.connectedTo) {
+				if ((skipFlags & ViewGeometry::NormalFlag) && (node.wire == nullptr) && (nodes.at(to).wire == nullptr)) {
+					// direct (part-to-part) connections not allowed
+					continue;
+				}
+				enqueue(to);
+			}
+
+			if (!skipBuses) {
+				Q_FOREACH (int mate, node.busMates) {
+					enqueue(mate);
+				}
+			}
+		}
+
+		if (connectorItems.isEmpty()) continue;
+
+		sketchWidget->collectNetParts(connectorItems, indexer, allPartConnectorItems, includeSingletons);
+	}
+}
+
+void NetlistCache::collectParts(SketchWidget * sketchWidget, QList<ItemBase *> & partList)
+{
+	if (sketchWidget == nullptr) return;
+
+	partList.append(graph(sketchWidget)->parts);
+}
+
+int NetlistCache::hits() const
+{
+	return m_hits;
+}
+
+int NetlistCache::misses() const
+{
+	return m_misses;
+}
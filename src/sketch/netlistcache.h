@@ -0,0 +1,89 @@
+/*******************************************************************
+
+Part of the Fritzing project - http://fritzing.org
+Copyright (c) 2007-2019 Fritzing
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************/
+
+#ifndef NETLISTCACHE_H
+#define NETLISTCACHE_H
+
+#include <QObject>
+#include <QHash>
+#include <QList>
+#include <QVector>
+
+#include "../viewgeometry.h"
+
+// Caches the connectivity graph of each view (every connector with its connections, cross-layer twin and
+// bus mates) so that the SPICE, XML netlist, IPC-D-356 and BOM exporters and the simulator share one walk
+// over the scene, whatever collection flags each of them asks for; the nets are then traced over the
+// cached graph in the same order SketchWidget::collectAllNets would give.  A view's graph is dropped
+// whenever the undo stack moves or ItemBase::ConnectivityRevision changes (items or connectors created or
+// deleted, or connections made or broken, including while loading a sketch).
+
+class NetlistCache : public QObject
+{
+	Q_OBJECT
+
+public:
+	NetlistCache(QObject * parent = nullptr);
+	~NetlistCache();
+
+	// same contract as SketchWidget::collectAllNets: the caller owns the returned nets and must delete them
+	void collectAllNets(
+	    class SketchWidget *,
+	    QHash<class ConnectorItem *, int> & indexer,
+	    QList< QList<class ConnectorItem *>* > & allPartConnectorItems,
+	    bool includeSingletons,
+	    bool bothSides,
+	    ViewGeometry::WireFlags skipFlags = ViewGeometry::NoFlag,
+	    bool skipBuses = false);
+	void collectParts(class SketchWidget *, QList<class ItemBase *> & partList);
+	int hits() const;
+	int misses() const;
+
+public Q_SLOTS:
+	void invalidate();
+
+protected:
+	struct Node {
+		class ConnectorItem * connectorItem = nullptr;
+		class Wire * wire = nullptr;
+		int crossLayer = -1;
+		bool copper1 = false;
+		bool inScene = false;
+		QList<int> connectedTo;
+		QList<int> busMates;
+	};
+
+	struct Graph {
+		QVector<Node> nodes;
+		QHash<class ConnectorItem *, int> index;
+		QList<class ItemBase *> parts;
+	};
+
+	Graph * graph(class SketchWidget *);
+	int addNode(Graph *, class ConnectorItem *);
+
+protected:
+	QHash<class SketchWidget *, Graph *> m_graphs;
+	QHash<class SketchWidget *, quint64> m_revisions;
+	int m_hits = 0;
+	int m_misses = 0;
+};
+
+#endif
@@ -32,6 +32,7 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include "../items/partlabel.h"
 #include "../autoroute/drc.h"
 #include "../autoroute/binpacking/GuillotineBinPack.h"
+#include "../autoroute/autoplacer.h"
 #include "../items/groundplane.h"
 #include "../items/jumperitem.h"
 #include "../utils/graphicsutils.h"
@@ -1310,12 +1311,139 @@ ItemBase * PCBSketchWidget::placePartDroppedInOtherView(ModelPart * modelPart, V
 	return newItem;
 }
 
+// moves the unlocked parts onto the board, placing connected parts close together;
+// returns false if some parts could not be placed without overlapping
+bool PCBSketchWidget::autoPlace(ItemBase * board) {
+	QRectF area = board->sceneBoundingRect();
+	double keepout = getKeepout();
+	area.adjust(keepout, keepout, -keepout, -keepout);
+
+	QList<ItemBase *> itemBases;
+	QList<AutoPlacer::Part> parts;
+	QHash<ItemBase *, int> indexes;
+	Q_FOREACH (QGraphicsItem * item, scene()->items()) {
+		auto * itemBase = dynamic_cast<ItemBase *>(item);
+		if (itemBase == nullptr) continue;
+		if (itemBase != itemBase->layerKinChief()) continue;
+		if (!itemBase->isEverVisible()) continue;
+		if (Board::isBoard(itemBase)) continue;
+
+		switch (itemBase->itemType()) {
+		case ModelPart::Part:
+		case ModelPart::Jumper:
+		case ModelPart::Logo:
+		case ModelPart::Hole:
+		case ModelPart::Via:
+			break;
+		default:
+			continue;
+		}
+
+		QRectF r = itemBase->sceneBoundingRect();
+		Q_FOREACH (ItemBase * lkpi, itemBase->layerKin()) {
+			r |= lkpi->sceneBoundingRect();
+		}
+
+		AutoPlacer::Part part;
+		part.fixed = itemBase->moveLock() || itemBase->itemType() != ModelPart::Part;
+		if (part.fixed && !r.intersects(board->sceneBoundingRect())) continue;
+
+		// parts already on another board stay there
+		bool onThisBoard = false;
+		bool onOtherBoard = false;
+		Q_FOREACH (QGraphicsItem * colliding, scene()->collidingItems(itemBase)) {
+			auto * other = dynamic_cast<ItemBase *>(colliding);
+			if (other == nullptr || !Board::isBoard(other)) continue;
+
+			if (other == board) onThisBoard = true;
+			else onOtherBoard = true;
+		}
+		if (onOtherBoard && !onThisBoard) continue;
+
+		// half the keepout on each side keeps neighboring parts a keepout apart
+		part.size = QSizeF(r.width() + keepout, r.height() + keepout);
+		part.center = r.center();
+		indexes.insert(itemBase, parts.count());
+		itemBases.append(itemBase);
+		parts.append(part);
+	}
+
+	QList<AutoPlacer::Net> nets;
+	QSet<ConnectorItem *> visited;
+	Q_FOREACH (ItemBase * itemBase, itemBases) {
+		Q_FOREACH (ConnectorItem * connectorItem, itemBase->cachedConnectorItems()) {
+			if (visited.contains(connectorItem)) continue;
+
+			QList<ConnectorItem *> connectorItems;
+			connectorItems.append(connectorItem);
+			ConnectorItem::collectEqualPotential(connectorItems, true, ViewGeometry::RatsnestFlag);
+			Q_FOREACH (ConnectorItem * ci, connectorItems) visited.insert(ci);
+
+			QList<ConnectorItem *> partConnectorItems;
+			ConnectorItem::collectParts(connectorItems, partConnectorItems, includeSymbols(), ViewLayer::NewTopAndBottom);
+
+			AutoPlacer::Net net;
+			Q_FOREACH (ConnectorItem * ci, partConnectorItems) {
+				int index = indexes.value(ci->attachedTo()->layerKinChief(), -1);
+				if (index < 0) continue;
+
+				AutoPlacer::Pin pin;
+				pin.part = index;
+				pin.offset = ci->sceneAdjustedTerminalPoint(nullptr) - parts.at(index).center;
+				net.append(pin);
+			}
+			if (net.count() > 1) nets.append(net);
+		}
+	}
+
+	AutoPlacer placer(area, parts, nets);
+	QApplication::setOverrideCursor(Qt::WaitCursor);
+	placer.place();
+	QApplication::restoreOverrideCursor();
+	DebugDialog::debug(QString("auto place %1 parts %2 nets: wirelength %3 -> %4, %5 overlapping")
+	                   .arg(parts.count()).arg(nets.count())
+	                   .arg(placer.initialWirelength()).arg(placer.wirelength()).arg(placer.overlaps()));
+
+	QHash<ItemBase *, QPointF> offsets;
+	QList<QPointF> centers = placer.centers();
+	for (int i = 0; i < parts.count(); i++) {
+		if (parts.at(i).fixed) continue;
+
+		offsets.insert(itemBases.at(i), centers.at(i) - parts.at(i).center);
+	}
+	if (offsets.isEmpty()) return true;
+
+	// the move works on the selection, which is put back afterwards
+	QList<QGraphicsItem *> selectedItems = scene()->selectedItems();
+	scene()->clearSelection();
+	Q_FOREACH (ItemBase * itemBase, offsets.keys()) {
+		itemBase->setSelected(true);
+	}
+
+	// move the selection the way alignItems() does, so the whole placement is one undoable move
+	m_dragBendpointWire = nullptr;
+	clearHoldingSelectItem();
+	m_savedItems.clear();
+	m_savedWires.clear();
+	m_moveEventCount = 0;
+	prepMove(nullptr, false, true);
+	moveSavedItemsBy(offsets, QMultiHash<Wire *, ConnectorItem *>(), false);
+
+	scene()->clearSelection();
+	Q_FOREACH (QGraphicsItem * item, selectedItems) {
+		item->setSelected(true);
+	}
+
+	return placer.overlaps() == 0;
+}
+
 void PCBSketchWidget::autorouterSettings() {
 	// initialize settings values if they haven't already been initialized
 	getKeepout();
 	QString ringThickness, holeSize;
 	getDefaultViaSize(ringThickness, holeSize);
 	getAutorouterTraceWidth();
+	getAutorouterNegotiate();
 
 	AutorouterSettingsDialog dialog(m_autorouterSettings);
 	if (QDialog::Accepted == dialog.exec()) {
@@ -1382,6 +1510,18 @@ double PCBSketchWidget::getAutorouterTraceWidth() {
 	return GraphicsUtils::SVGDPI * traceWidthString.toInt() / 1000.0;  // traceWidthString is in mils
 }
 
+bool PCBSketchWidget::getAutorouterNegotiate() {
+	QString negotiateString = m_autorouterSettings.value(AutorouterSettingsDialog::AutorouteNegotiate, "");
+	if (negotiateString.isEmpty()) {
+		QSettings settings;
+		negotiateString = settings.value(AutorouterSettingsDialog::AutorouteNegotiate, "0").toString();
+	}
+
+	m_autorouterSettings.insert(AutorouterSettingsDialog::AutorouteNegotiate, negotiateString);
+
+	return negotiateString == "1";
+}
+
 void PCBSketchWidget::getBendpointWidths(Wire * wire, double width, double & bendpointWidth, double & bendpoint2Width, bool & negativeOffsetRect)
 {
 	Q_UNUSED(wire);
@@ -1482,7 +1622,10 @@ bool PCBSketchWidget::groundFill(bool fillGroundTraces, ViewLayer::ViewLayerID v
 	QStringList exceptions;
 	exceptions << "none" << "" << background().name();    // the color of holes in the board
 
+	// the two sides only share the rendered svgs, so generate them side by side
+	QList< QFuture<bool> > futures;
 	GroundPlaneGenerator gpg0;
+	QFuture<bool> future0;
 	if (!svg0.isEmpty()) {
 		gpg0.setLayerName("groundplane");
 		gpg0.setStrokeWidthIncrement(StrokeWidthIncrement);
@@ -1493,16 +1636,15 @@ bool PCBSketchWidget::groundFill(bool fillGroundTraces, ViewLayer::ViewLayerID v
 			        Qt::DirectConnection);
 		}
 
-		bool result = gpg0.generateGroundPlane(boardSvg, boardImageRect.size(), svg0, copperImageRect.size(), exceptions, board, GraphicsUtils::StandardFritzingDPI / 2.0  /* 2 MIL */,
-		                                       ViewLayer::Copper0Color, getKeepoutMils());
-		if (result == false) {
-			QMessageBox::critical(this, tr("Fritzing"), tr("Fritzing error: unable to write copper fill (1)."));
-			return false;
-		}
+		future0 = gpg0.startGroundPlane(boardSvg, boardImageRect.size(), svg0, copperImageRect.size(), exceptions, board, GraphicsUtils::StandardFritzingDPI / 2.0  /* 2 MIL */,
+		                                ViewLayer::Copper0Color, getKeepoutMils());
+		futures << future0;
 	}
 
 	GroundPlaneGenerator gpg1;
-	if (boardLayers() > 1 && !svg1.isEmpty()) {
+	QFuture<bool> future1;
+	bool fill1 = boardLayers() > 1 && !svg1.isEmpty();
+	if (fill1) {
 		gpg1.setLayerName("groundplane1");
 		gpg1.setStrokeWidthIncrement(StrokeWidthIncrement);
 		gpg1.setMinRunSize(10, 10);
@@ -1511,12 +1653,19 @@ bool PCBSketchWidget::groundFill(bool fillGroundTraces, ViewLayer::ViewLayerID v
 			        this, SLOT(postImageSlot(GroundPlaneGenerator *, QImage *, QImage *, QGraphicsItem *, QList<QRectF> *)),
 			        Qt::DirectConnection);
 		}
-		bool result = gpg1.generateGroundPlane(boardSvg, boardImageRect.size(), svg1, copperImageRect.size(), exceptions, board, GraphicsUtils::StandardFritzingDPI / 2.0  /* 2 MIL */,
-		                                       ViewLayer::Copper1Color, getKeepoutMils());
-		if (result == false) {
-			QMessageBox::critical(this, tr("Fritzing"), tr("Fritzing error: unable to write copper fill (2)."));
-			return false;
-		}
+		future1 = gpg1.startGroundPlane(boardSvg, boardImageRect.size(), svg1, copperImageRect.size(), exceptions, board, GraphicsUtils::StandardFritzingDPI / 2.0  /* 2 MIL */,
+		                                ViewLayer::Copper1Color, getKeepoutMils());
+		futures << future1;
+	}
+
+	GroundPlaneGenerator::waitForGroundPlanes(futures);
+	if (!svg0.isEmpty() && !future0.result()) {
+		QMessageBox::critical(this, tr("Fritzing"), tr("Fritzing error: unable to write copper fill (1)."));
+		return false;
+	}
+	if (fill1 && !future1.result()) {
+		QMessageBox::critical(this, tr("Fritzing"), tr("Fritzing error: unable to write copper fill (2)."));
+		return false;
 	}
 
 
@@ -1833,6 +1982,9 @@ void PCBSketchWidget::postImageSlot(GroundPlaneGenerator * gpg, QImage * copperI
 
 	if (m_groundFillSeeds == nullptr) return;
 
+	// called from the ground plane worker threads; both sides query the scene
+	QMutexLocker locker(&m_postImageMutex);
+
 	ViewLayer::ViewLayerID viewLayerID = (gpg->layerName() == "groundplane") ? ViewLayer::Copper0 : ViewLayer::Copper1;
 
 	QRectF boardRect = board->sceneBoundingRect();
@@ -2588,7 +2740,7 @@ QHash<QString, QString> PCBSketchWidget::getAutorouterSettings() {
 
 void PCBSketchWidget::setAutorouterSettings(QHash<QString, QString> & autorouterSettings) {
 	QList<QString> keys;
-	keys << DRC::KeepoutSettingName << AutorouterSettingsDialog::AutorouteTraceWidth << Via::AutorouteViaHoleSize << Via::AutorouteViaRingThickness << GroundPlaneGenerator::KeepoutSettingName;
+	keys << DRC::KeepoutSettingName << AutorouterSettingsDialog::AutorouteTraceWidth << AutorouterSettingsDialog::AutorouteNegotiate << Via::AutorouteViaHoleSize << Via::AutorouteViaRingThickness << GroundPlaneGenerator::KeepoutSettingName;
 	Q_FOREACH (QString key, keys) {
 		m_autorouterSettings.insert(key, autorouterSettings.value(key, ""));
 	}
@@ -26,6 +26,7 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include <QVector>
 #include <QNetworkReply>
 #include <QDialog>
+#include <QMutex>
 
 ///////////////////////////////////////////////
 
@@ -80,11 +81,13 @@ public:
 	void changeLayerForCommand(long id, double z, ViewLayer::ViewLayerID viewLayerID);
 	bool acceptsTrace(const ViewGeometry & viewGeometry);
 	ItemBase * placePartDroppedInOtherView(ModelPart *, ViewLayer::ViewLayerPlacement, const ViewGeometry & viewGeometry, long id, SketchWidget * dropOrigin);
+	bool autoPlace(ItemBase * board);
 	void autorouterSettings();
 	void getViaSize(double & ringThickness, double & holeSize);
 	void deleteItem(ItemBase *, bool deleteModelPart, bool doEmit, bool later);
 	double getTraceWidth();
 	virtual double getAutorouterTraceWidth();
+	bool getAutorouterNegotiate();
 	void getBendpointWidths(class Wire *, double w, double & w1, double & w2, bool & negativeOffsetRect);
 	double getSmallerTraceWidth(double minDim);
 	bool groundFill(bool fillGroundTraces, ViewLayer::ViewLayerID, QUndoCommand * parentCommand);
@@ -208,6 +211,7 @@ protected:
 	QPointF m_jumperDragOffset;
 	QPointer<class JumperItem> m_resizingJumperItem;
 	QList<ConnectorItem *> * m_groundFillSeeds;
+	QMutex m_postImageMutex;			// postImageSlot runs on the ground plane worker threads
 	QHash<QString, QString> m_autorouterSettings;
 	QPointer<class QuoteDialog> m_quoteDialog;
 	QPointer<class QuoteDialog> m_rolloverQuoteDialog;
@@ -89,6 +89,7 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include "../items/schematicframe.h"
 #include "../utils/graphutils.h"
 #include "../utils/ratsnestcolors.h"
+#include "../testing/FProbeTiming.h"
 #include "../utils/cursormaster.h"
 
 /////////////////////////////////////////////////////////////////////
@@ -220,6 +221,19 @@ WaitPushUndoStack* SketchWidget::undoStack() {
 
 void SketchWidget::setUndoStack(WaitPushUndoStack * undoStack) {
 	m_undoStack = undoStack;
+	if (m_undoStack != nullptr) {
+		// not every change that shows in an export clears the item's fragments itself, but they all go through the undo stack
+		connect(m_undoStack, SIGNAL(indexChanged(int)), this, SLOT(clearRenderSvgFragments()), Qt::UniqueConnection);
+	}
+}
+
+void SketchWidget::clearRenderSvgFragments() {
+	Q_FOREACH (QGraphicsItem * item, scene()->items()) {
+		auto * itemBase = dynamic_cast<ItemBase *>(item);
+		if (itemBase == nullptr) continue;
+
+		itemBase->clearRenderSvgFragments();
+	}
 }
 
 void SketchWidget::loadFromModelParts(QList<ModelPart *> & modelParts, BaseCommand::CrossViewType crossViewType, QUndoCommand * parentCommand, bool offsetPaste, const QRectF * boundingRect, bool seekOutsideConnections, QList<long> & newIDs) {
@@ -5897,10 +5911,26 @@ void SketchWidget::cleanUpWiresForCommand(bool doEmit, CleanUpWiresCommand * com
 }
 
 void SketchWidget::cleanUpWiresSlot(CleanUpWiresCommand * command) {
+	if (!m_current) {
+		// an edit in another view: the changed connectors are already collected by ratsnestConnect(),
+		// so the ratsnest and routing status of this view are brought up to date once, when it is shown or rendered
+		m_deferredRoutingStatus++;
+		return;
+	}
+
 	RoutingStatus routingStatus;
 	updateRoutingStatus(command, routingStatus, false);
 }
 
+void SketchWidget::updateDeferredRoutingStatus() {
+	if (m_deferredRoutingStatus == 0) return;
+
+	DebugDialog::debug(QString("%1: applying %2 deferred routing status updates").arg(m_viewName).arg(m_deferredRoutingStatus));
+	m_deferredRoutingStatus = 0;
+	RoutingStatus routingStatus;
+	updateRoutingStatus(nullptr, routingStatus, false);
+}
+
 void SketchWidget::noteChanged(ItemBase * item, const QString &oldText, const QString & newText, QSizeF oldSize, QSizeF newSize) {
 	auto * command = new ChangeNoteTextCommand(this, item->id(), oldText, newText, oldSize, newSize, nullptr);
 	command->setText(tr("Note text change"));
@@ -6769,6 +6799,7 @@ void SketchWidget::updateRoutingStatus(CleanUpWiresCommand* command, RoutingStat
 
 void SketchWidget::updateRoutingStatus(RoutingStatus & routingStatus, bool manual)
 {
+	FProbeTimer probeTimer("UpdateRoutingStatus");
 	//DebugDialog::debug(QString("update routing status %1 %2 %3")
 	//	.arg(m_viewID)
 	//	.arg(m_ratsnestUpdateConnect.count())
@@ -7238,6 +7269,9 @@ void SketchWidget::movePartLabelForCommand(long itemID, QPointF newPos, QPointF
 
 void SketchWidget::setCurrent(bool current) {
 	m_current = current;
+	if (current) {
+		updateDeferredRoutingStatus();
+	}
 }
 
 void SketchWidget::partLabelMoved(ItemBase * itemBase, QPointF oldPos, QPointF oldOffset, QPointF newPos, QPointF newOffset)
@@ -7324,6 +7358,8 @@ QString SketchWidget::renderToSVG(RenderThing & renderThing, QGraphicsItem * boa
 
 QList<QGraphicsItem *> SketchWidget::getVisibleItemsAndLabels(RenderThing & renderThing, const LayerList & layers)
 {
+	updateDeferredRoutingStatus();				// before collecting, since this adds and deletes ratsnest wires
+
 	QList<QGraphicsItem *> itemsAndLabels;
 	QRectF itemsBoundingRect;
 	QList<QGraphicsItem *> items = renderThing.getItems(scene());
@@ -7371,6 +7407,7 @@ QString translateSVG(QString & svg, QPointF loc, double dpi, double printerScale
 
 QString SketchWidget::renderToSVG(RenderThing & renderThing, QList<QGraphicsItem *> & itemsAndLabels, bool applyViewFromBelow)
 {
+	FProbeTimer probeTimer("RenderToSVG");
 	renderThing.empty = true;
 
 	double width = renderThing.itemsBoundingRect.width();
@@ -7396,6 +7433,8 @@ QString SketchWidget::renderToSVG(RenderThing & renderThing, QList<QGraphicsItem
 	std::sort(itemsAndLabels.begin(), itemsAndLabels.end(), zLessThan);
 
 	QList<ItemBase *> gotLabel;
+	int reusedCount = 0;
+	int renderedCount = 0;
 	Q_FOREACH (QGraphicsItem * item, itemsAndLabels) {
 		auto * itemBase = dynamic_cast<ItemBase *>(item);
 		if (!itemBase) {
@@ -7414,53 +7453,44 @@ QString SketchWidget::renderToSVG(RenderThing & renderThing, QList<QGraphicsItem
 		}
 
 		if (itemBase->itemType() != ModelPart::Wire) {
-			double factor;
-			QString itemSvg = itemBase->retrieveSvg(itemBase->viewLayerID(), svgHash, renderThing.blackOnly, renderThing.dpi, factor);
-			if (itemSvg.isEmpty()) continue;
+			bool blocker = false;
+			if (renderThing.renderBlocker) {
+				Pad * pad = qobject_cast<Pad *>(itemBase);
+				blocker = pad && pad->copperBlocker();
+			}
 
-			TextUtils::fixMuch(itemSvg, false);
+			// unchanged items are rendered the same way by consecutive exports, so reuse the transformed svg;
+			// they are cleared whenever the item's svg or properties change and whenever the undo stack moves
+			QTransform t = itemBase->transform();
+			QStringList keyParts;
+			keyParts << QString::number(itemBase->viewLayerID()) << QString::number(itemBase->viewLayerPlacement())
+			         << QString::number(int(smdOrientation())) << QString::number(renderThing.dpi)
+			         << QString::number(int(renderThing.blackOnly)) << QString::number(int(renderThing.hideTerminalPoints)) << QString::number(int(blocker))
+			         << QString::number(t.m11()) << QString::number(t.m12()) << QString::number(t.m21()) << QString::number(t.m22())
+			         << QString::number(t.dx()) << QString::number(t.dy()) << itemBase->filename();
+			QString fragmentKey = keyParts.join(' ');
+
+			QString itemSvg = itemBase->renderSvgFragment(fragmentKey);
+			if (itemSvg.isEmpty()) {
+				itemSvg = makeSvgFragment(itemBase, renderThing, svgHash, blocker);
+				if (itemSvg.isEmpty()) continue;
+
+				itemSvg = TextUtils::svgTransform(itemSvg, t, false, QString());
+				itemBase->setRenderSvgFragment(fragmentKey, itemSvg);
+				renderedCount++;
+			}
+			else {
+				reusedCount++;
+			}
 
 			QString legSvg;
-			QDomDocument doc;
-			QString errorStr;
-			int errorLine;
-			int errorColumn;
-			if (doc.setContent(itemSvg, &errorStr, &errorLine, &errorColumn)) {
-				bool changed = false;
-				if (renderThing.renderBlocker) {
-					Pad * pad = qobject_cast<Pad *>(itemBase);
-					if (pad && pad->copperBlocker()) {
-						QDomNodeList nodeList = doc.documentElement().elementsByTagName("rect");
-						for (int n = 0; n < nodeList.count(); n++) {
-							QDomElement element = nodeList.at(n).toElement();
-							element.setAttribute("fill-opacity", 1);
-							changed = true;
-						}
-					}
-				}
-
-				Q_FOREACH (ConnectorItem * ci, itemBase->cachedConnectorItems()) {
-					SvgIdLayer * svgIdLayer = ci->connector()->fullPinInfo(itemBase->viewID(), itemBase->viewLayerID());
-					if (renderThing.hideTerminalPoints && !svgIdLayer->m_terminalId.isEmpty()) {
-						// these tend to be degenerate shapes and can cause trouble at gerber export time
-						if (hideTerminalID(doc, svgIdLayer->m_terminalId)) changed = true;
-					}
-
-					if (ensureStrokeWidth(doc, svgIdLayer->m_svgId, factor)) changed = true;
+			Q_FOREACH (ConnectorItem * ci, itemBase->cachedConnectorItems()) {
+				if (!ci->hasRubberBandLeg()) continue;
 
-					if (!ci->hasRubberBandLeg()) continue;
-
-					// at the moment, the legs don't get a partID, but since there are no legs in PCB view, we don't care
-					legSvg.append(ci->makeLegSvg(offset, renderThing.dpi, renderThing.printerScale, renderThing.blackOnly));
-				}
-
-				if (changed) {
-					itemSvg = doc.toString(0);
-				}
+				// at the moment, the legs don't get a partID, but since there are no legs in PCB view, we don't care
+				legSvg.append(ci->makeLegSvg(offset, renderThing.dpi, renderThing.printerScale, renderThing.blackOnly));
 			}
 
-			QTransform t = itemBase->transform();
-			itemSvg = TextUtils::svgTransform(itemSvg, t, false, QString());
 			itemSvg = translateSVG(itemSvg, itemBase->scenePos() - offset, renderThing.dpi, renderThing.printerScale);
 			itemSvg =  QString("<g partID='%1'>%2</g>").arg(itemBase->id()).arg(itemSvg);
 			outputSVG.append(itemSvg);
@@ -7503,9 +7533,55 @@ QString SketchWidget::renderToSVG(RenderThing & renderThing, QList<QGraphicsItem
 
 	outputSVG += "</svg>";
 
+	DebugDialog::debug(QString("renderToSVG: %1 fragments reused, %2 rendered").arg(reusedCount).arg(renderedCount));
+
 	return outputSVG;
 }
 
+/**
+ * The svg of itemBase's layer as it is exported, before it is transformed and moved to the item's position
+ */
+QString SketchWidget::makeSvgFragment(ItemBase * itemBase, RenderThing & renderThing, QHash<QString, QString> & svgHash, bool blocker)
+{
+	double factor;
+	QString itemSvg = itemBase->retrieveSvg(itemBase->viewLayerID(), svgHash, renderThing.blackOnly, renderThing.dpi, factor);
+	if (itemSvg.isEmpty()) return itemSvg;
+
+	TextUtils::fixMuch(itemSvg, false);
+
+	QDomDocument doc;
+	QString errorStr;
+	int errorLine;
+	int errorColumn;
+	if (!doc.setContent(itemSvg, &errorStr, &errorLine, &errorColumn)) return itemSvg;
+
+	bool changed = false;
+	if (blocker) {
+		QDomNodeList nodeList = doc.documentElement().elementsByTagName("rect");
+		for (int n = 0; n < nodeList.count(); n++) {
+			QDomElement element = nodeList.at(n).toElement();
+			element.setAttribute("fill-opacity", 1);
+			changed = true;
+		}
+	}
+
+	Q_FOREACH (ConnectorItem * ci, itemBase->cachedConnectorItems()) {
+		SvgIdLayer * svgIdLayer = ci->connector()->fullPinInfo(itemBase->viewID(), itemBase->viewLayerID());
+		if (renderThing.hideTerminalPoints && !svgIdLayer->m_terminalId.isEmpty()) {
+			// these tend to be degenerate shapes and can cause trouble at gerber export time
+			if (hideTerminalID(doc, svgIdLayer->m_terminalId)) changed = true;
+		}
+
+		if (ensureStrokeWidth(doc, svgIdLayer->m_svgId, factor)) changed = true;
+	}
+
+	if (changed) {
+		itemSvg = doc.toString(0);
+	}
+
+	return itemSvg;
+}
+
 void SketchWidget::extraRenderSvgStep(ItemBase * itemBase, QPointF offset, double dpi, double printerScale, QString & outputSvg)
 {
 	Q_UNUSED(itemBase);
@@ -8591,51 +8667,60 @@ void SketchWidget::collectAllNets(
 			allConnectors.removeOne(ci);
 		}
 
-		if (!includeSingletons && (connectorItems.count() <= 1)) {
-			continue;
-		}
+		collectNetParts(connectorItems, indexer, allPartConnectorItems, includeSingletons);
+	}
+}
 
-		auto * partConnectorItems = new QList<ConnectorItem *>;
-		ConnectorItem::collectParts(connectorItems, *partConnectorItems, includeSymbols(), ViewLayer::NewTopAndBottom);
+void SketchWidget::collectNetParts(
+		QList<ConnectorItem *> & connectorItems,
+		QHash<ConnectorItem *, int> & indexer,
+		QList< QList<class ConnectorItem *>* > & allPartConnectorItems,
+		bool includeSingletons)
+{
+	if (!includeSingletons && (connectorItems.count() <= 1)) {
+		return;
+	}
 
-		for (int i = partConnectorItems->count() - 1; i >= 0; i--) {
-			if (!partConnectorItems->at(i)->attachedTo()->isEverVisible()) {
-				partConnectorItems->removeAt(i);
-			}
-		}
+	auto * partConnectorItems = new QList<ConnectorItem *>;
+	ConnectorItem::collectParts(connectorItems, *partConnectorItems, includeSymbols(), ViewLayer::NewTopAndBottom);
 
-		if ((partConnectorItems->count() <= 0) || (!includeSingletons && (partConnectorItems->count() <= 1))) {
-			delete partConnectorItems;
-			continue;
+	for (int i = partConnectorItems->count() - 1; i >= 0; i--) {
+		if (!partConnectorItems->at(i)->attachedTo()->isEverVisible()) {
+			partConnectorItems->removeAt(i);
 		}
+	}
 
-		Q_FOREACH (ConnectorItem * ci, *partConnectorItems) {
-			//if (partConnectorItems->count(ci) > 1) {
-			//DebugDialog::debug("collect Parts bug");
-			//}
-			if (!connectorItems.contains(ci)) {
-				// crossed layer: toss it
-				//DebugDialog::debug(QString("not in equal potential '%1' '%2' %3")
-				//	.arg(ci->connectorSharedName())
-				//	.arg(ci->attachedToInstanceTitle())
-				//	.arg(ci->attachedToViewLayerID()));
-				continue;
-			}
-			//if (indexer.keys().contains(ci)) {
-			//DebugDialog::debug(QString("connector item already indexed %1 %2").arg(ci->connectorSharedName()).arg(ci->attachedToInstanceTitle()));
-			//}
-			//int c = indexer.count();
-			//DebugDialog::debug(QString("insert indexer %1 '%2' '%3' %4")
-			//.arg(c)
-			//.arg(ci->connectorSharedName())
-			//.arg(ci->attachedToInstanceTitle())
-			//.arg(ci->attachedToViewLayerID()));
-			indexer.insert(ci, indexer.count());
-		}
+	if ((partConnectorItems->count() <= 0) || (!includeSingletons && (partConnectorItems->count() <= 1))) {
+		delete partConnectorItems;
+		return;
+	}
 
-		//DebugDialog::debug("________________");
-		allPartConnectorItems.append(partConnectorItems);
+	Q_FOREACH (ConnectorItem * ci, *partConnectorItems) {
+		//if (partConnectorItems->count(ci) > 1) {
+		//DebugDialog::debug("collect Parts bug");
+		//}
+		if (!connectorItems.contains(ci)) {
+			// crossed layer: toss it
+			//DebugDialog::debug(QString("not in equal potential '%1' '%2' %3")
+			//	.arg(ci->connectorSharedName())
+			//	.arg(ci->attachedToInstanceTitle())
+			//	.arg(ci->attachedToViewLayerID()));
+			continue;
+		}
+		//if (indexer.keys().contains(ci)) {
+		//DebugDialog::debug(QString("connector item already indexed %1 %2").arg(ci->connectorSharedName()).arg(ci->attachedToInstanceTitle()));
+		//}
+		//int c = indexer.count();
+		//DebugDialog::debug(QString("insert indexer %1 '%2' '%3' %4")
+		//.arg(c)
+		//.arg(ci->connectorSharedName())
+		//.arg(ci->attachedToInstanceTitle())
+		//.arg(ci->attachedToViewLayerID()));
+		indexer.insert(ci, indexer.count());
 	}
+
+	//DebugDialog::debug("________________");
+	allPartConnectorItems.append(partConnectorItems);
 }
 
 ViewLayer::ViewLayerPlacement SketchWidget::getViewLayerPlacement(ModelPart * modelPart, QDomElement & instance, QDomElement & view, ViewGeometry & viewGeometry)
@@ -8804,11 +8889,10 @@ void SketchWidget::ratsnestConnect(ConnectorItem * c1, ConnectorItem * c2, bool
 }
 
 void SketchWidget::ratsnestConnect(ConnectorItem * connectorItem, bool connect) {
-	if (connect) {
-		m_ratsnestUpdateConnect << connectorItem;
-	}
-	else {
-		m_ratsnestUpdateDisconnect << connectorItem;
+	// a hidden view can collect these over many edits, so keep each connector once
+	QList< QPointer<ConnectorItem> > & update = connect ? m_ratsnestUpdateConnect : m_ratsnestUpdateDisconnect;
+	if (!update.contains(connectorItem)) {
+		update << connectorItem;
 	}
 
 	//connectorItem->debugInfo(QString("rat connect %1").arg(connect));
@@ -9844,17 +9928,7 @@ void SketchWidget::alignItems(Qt::Alignment alignment) {
 	hcTotal /= count;
 	vcTotal /= count;
 
-	if (m_moveEventCount == 0) {
-		// first time
-		m_moveDisconnectedFromFemale.clear();
-		Q_FOREACH (ItemBase * item, m_savedItems) {
-			if (item->itemType() == ModelPart::Wire) continue;
-
-			//DebugDialog::debug(QString("disconnecting from female %1").arg(item->instanceTitle()));
-			disconnectFromFemale(item, m_savedItems, m_moveDisconnectedFromFemale, false, rubberBandLegEnabled, nullptr);
-		}
-	}
-
+	QHash<ItemBase *, QPointF> offsets;
 	Q_FOREACH (ItemBase * itemBase, m_savedItems) {
 		if (itemBase->itemType() == ModelPart::Wire) continue;
 
@@ -9892,6 +9966,30 @@ void SketchWidget::alignItems(Qt::Alignment alignment) {
 			break;
 		}
 
+		offsets.insert(itemBase, dp);
+	}
+
+	moveSavedItemsBy(offsets, unsaved, rubberBandLegEnabled);
+}
+
+// moves each of m_savedItems by its offset, after prepMove(), and pushes the move onto the undo stack
+void SketchWidget::moveSavedItemsBy(const QHash<ItemBase *, QPointF> & offsets, const QMultiHash<Wire *, ConnectorItem *> & unsaved, bool rubberBandLegEnabled) {
+	if (m_moveEventCount == 0) {
+		// first time
+		m_moveDisconnectedFromFemale.clear();
+		Q_FOREACH (ItemBase * item, m_savedItems) {
+			if (item->itemType() == ModelPart::Wire) continue;
+
+			//DebugDialog::debug(QString("disconnecting from female %1").arg(item->instanceTitle()));
+			disconnectFromFemale(item, m_savedItems, m_moveDisconnectedFromFemale, false, rubberBandLegEnabled, nullptr);
+		}
+	}
+
+	Q_FOREACH (ItemBase * itemBase, m_savedItems) {
+		if (itemBase->itemType() == ModelPart::Wire) continue;
+		if (!offsets.contains(itemBase)) continue;
+
+		QPointF dp = offsets.value(itemBase);
 		itemBase->setPos(itemBase->getViewGeometry().loc() + dp);
 		Q_FOREACH (ConnectorItem * connectorItem, m_stretchingLegs.values(itemBase)) {
 			connectorItem->stretchBy(dp);
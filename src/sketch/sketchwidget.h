@@ -199,6 +199,7 @@ public:
 	void restoreLayerVisibility();
 	void updateRoutingStatus(CleanUpWiresCommand*, RoutingStatus &, bool manual);
 	void updateRoutingStatus(RoutingStatus &, bool manual);
+	void updateDeferredRoutingStatus();
 	virtual bool hasAnyNets();
 	void ensureLayerVisible(ViewLayer::ViewLayerID);
 
@@ -271,6 +272,11 @@ public:
 			bool bothSides,
 			ViewGeometry::WireFlags skipFlag = ViewGeometry::NoFlag,
 			bool skipBuses = false);
+	void collectNetParts(
+			QList<class ConnectorItem *> & connectorItems,
+			QHash<class ConnectorItem *, int> & indexer,
+			QList< QList<class ConnectorItem *>* > & allPartConnectorItems,
+			bool includeSingletons);
 	virtual bool routeBothSides();
 	virtual void changeLayerForCommand(long id, double z, ViewLayer::ViewLayerID viewLayerID);
 	void ratsnestConnect(ConnectorItem * connectorItem, bool connect);
@@ -448,6 +454,7 @@ protected:
 	void categorizeDragWires(QSet<Wire *> & wires, QList<ItemBase *> & freeWires);
 	void categorizeDragLegs(bool rubberBandLegEnabled);
 	void prepMove(ItemBase * originatingItem, bool rubberBandLegEnabled, bool includeRatsnest);
+	void moveSavedItemsBy(const QHash<ItemBase *, QPointF> & offsets, const QMultiHash<Wire *, ConnectorItem *> & unsaved, bool rubberBandLegEnabled);
 	void initBackgroundColor();
 	QPointF calcNewLoc(ItemBase * moveBase, ItemBase * detachFrom);
 	long findPartOrWire(long itemID);
@@ -484,6 +491,7 @@ protected:
 	virtual ItemBase * placePartDroppedInOtherView(ModelPart *, ViewLayer::ViewLayerPlacement, const ViewGeometry & viewGeometry, long id, SketchWidget * dropOrigin);
 	void showPartLabelsAux(bool show, QList<ItemBase *> & itemBases);
 	virtual void extraRenderSvgStep(ItemBase *, QPointF offset, double dpi, double printerScale, QString & outputSvg);
+	QString makeSvgFragment(ItemBase *, RenderThing &, QHash<QString, QString> & svgHash, bool blocker);
 	virtual ViewLayer::ViewLayerPlacement createWireViewLayerPlacement(ConnectorItem * from, ConnectorItem * to);
 	virtual Wire * createTempWireForDragging(Wire * fromWire, ModelPart * wireModel, ConnectorItem * connectorItem, ViewGeometry & viewGeometry, ViewLayer::ViewLayerPlacement);
 	virtual void prereleaseTempWireForDragging(Wire*);
@@ -589,6 +597,7 @@ protected Q_SLOTS:
 	void wireJoinSlot(class Wire*, ConnectorItem * clickedConnectorItem);
 	void toggleLayerVisibility();
 	void wireConnectedSlot(long fromID, QString fromConnectorID, long toID, QString toConnectorID);
+	void clearRenderSvgFragments();
 	void wireDisconnectedSlot(long fromID, QString fromConnectorID);
 	void changeConnectionSlot(long fromID, QString fromConnectorID, long toID, QString toConnectorID, ViewLayer::ViewLayerPlacement, bool connect, bool updateConnections);
 	void restartPasteCount();
@@ -697,6 +706,7 @@ protected:
 	QList<ItemBase *> m_additionalSavedItems;
 	int m_ignoreSelectionChangeEvents = 0;
 	bool m_current = false;
+	int m_deferredRoutingStatus = 0;			// routing status updates skipped while this view was hidden
 
 	QString m_lastColorSelected;
 
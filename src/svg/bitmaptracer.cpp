@@ -0,0 +1,406 @@
+/*******************************************************************
+
+Part of the Fritzing project - http://fritzing.org
+Copyright (c) 2007-2019 Fritzing
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************/
+
+#include "bitmaptracer.h"
+#include "scanlinetracer.h"
+#include "../utils/textutils.h"
+
+#include <QPointF>
+#include <QPolygon>
+#include <QVector>
+
+#include <algorithm>
+#include <cmath>
+
+/*
+The boundary loops come from ScanLineTracer, with only their corner points.  Each loop is simplified
+with Douglas-Peucker, so a staircase along a slanted edge becomes one side.  Then, as in potrace's
+smoothing step, every side is cut at its midpoint and the polygon corner between two midpoints is
+either kept or replaced by a bezier curve, depending on how sharp the corner is relative to its
+neighbors.  The curves are flattened to short line segments, since gerber export can only keep
+polygons as vectors.
+
+Outlines run clockwise and holes counterclockwise.  Each hole belongs to the smallest outline around
+it, and is joined to that outline by a zero-width cut, like ScanLineTracer::trace does, so that every
+piece ends up as one simple polygon.  The cut runs from the hole's rightmost point to the nearest
+outline point it can see to the right (as in Eberly's ear clipping triangulation).
+*/
+
+namespace {
+
+typedef QVector<QPointF> Points;
+
+double cross(const QPointF & a, const QPointF & b, const QPointF & c) {
+	return (b.x() - a.x()) * (c.y() - a.y()) - (b.y() - a.y()) * (c.x() - a.x());
+}
+
+double polygonArea(const Points & points) {
+	double area = 0;
+	for (int i = 0, j = points.count() - 1; i < points.count(); j = i++) {
+		area += points.at(j).x() * points.at(i).y() - points.at(i).x() * points.at(j).y();
+	}
+	return area / 2;
+}
+
+double distance(const QPointF & p, const QPointF & a, const QPointF & b) {
+	double dx = b.x() - a.x();
+	double dy = b.y() - a.y();
+	double length = std::sqrt(dx * dx + dy * dy);
+	if (length == 0) {
+		return std::hypot(p.x() - a.x(), p.y() - a.y());
+	}
+	return std::fabs(cross(a, b, p)) / length;
+}
+
+// Douglas-Peucker on points[from..to] (indexes wrap), marking the points to keep
+void simplify(const Points & points, int from, int to, double tolerance, QVector<bool> & keep) {
+	int count = points.count();
+	const QPointF & a = points.at(from % count);
+	const QPointF & b = points.at(to % count);
+	double farthest = 0;
+	int index = -1;
+	for (int i = from + 1; i < to; i++) {
+		double d = distance(points.at(i % count), a, b);
+		if (d > farthest) {
+			farthest = d;
+			index = i;
+		}
+	}
+	if (index < 0 || farthest <= tolerance) return;
+
+	keep[index % count] = true;
+	simplify(points, from, index, tolerance, keep);
+	simplify(points, index, to, tolerance, keep);
+}
+
+Points simplifyLoop(const Points & points, double tolerance) {
+	int count = points.count();
+	if (count <= 4) return points;
+
+	// split the loop at the first point and the point farthest from it
+	int opposite = 0;
+	double farthest = -1;
+	for (int i = 1; i < count; i++) {
+		double d = std::hypot(points.at(i).x() - points.first().x(), points.at(i).y() - points.first().y());
+		if (d > farthest) {
+			farthest = d;
+			opposite = i;
+		}
+	}
+
+	QVector<bool> keep(count, false);
+	keep[0] = keep[opposite] = true;
+	simplify(points, 0, opposite, tolerance, keep);
+	simplify(points, opposite, count, tolerance, keep);
+
+	Points result;
+	for (int i = 0; i < count; i++) {
+		if (keep.at(i)) result.append(points.at(i));
+	}
+
+	// thin pieces (a one pixel wide slanted line, say) can collapse to almost nothing
+	if (result.count() < 3 || std::fabs(polygonArea(result)) * 2 < std::fabs(polygonArea(points))) {
+		return points;
+	}
+
+	return result;
+}
+
+QPointF interval(double lambda, const QPointF & a, const QPointF & b) {
+	return a + lambda * (b - a);
+}
+
+double sign(double x) {
+	return (x > 0) ? 1 : (x < 0) ? -1 : 0;
+}
+
+// potrace's ddenom: the largest cross product, over points at unit "corner" distance from the
+// line a-b, normalizing how far a corner between a and b sticks out
+double ddenom(const QPointF & a, const QPointF & b) {
+	double rx = -sign(b.y() - a.y());
+	double ry = sign(b.x() - a.x());
+	return ry * (b.x() - a.x()) - rx * (b.y() - a.y());
+}
+
+// appends the bezier from the last point in points, in as many segments as keep it within CurveTolerance
+void appendCurve(const QPointF & c1, const QPointF & c2, const QPointF & end, Points & points) {
+	QPointF start = points.last();
+	double bulge = qMax(distance(c1, start, end), distance(c2, start, end));
+	int segments = qBound(1, int(std::ceil(std::sqrt(bulge / BitmapTracer::CurveTolerance))), 16);
+	for (int i = 1; i < segments; i++) {
+		double t = double(i) / segments;
+		double u = 1 - t;
+		points.append(u * u * u * start + 3 * u * u * t * c1 + 3 * u * t * t * c2 + t * t * t * end);
+	}
+	points.append(end);
+}
+
+Points smoothLoop(const Points & vertex) {
+	int count = vertex.count();
+	Points points;
+	points.append(interval(0.5, vertex.last(), vertex.first()));
+	for (int j = 0; j < count; j++) {
+		const QPointF & previous = vertex.at((j + count - 1) % count);
+		const QPointF & current = vertex.at(j);
+		const QPointF & next = vertex.at((j + 1) % count);
+		QPointF end = interval(0.5, current, next);
+
+		double alpha = 4.0 / 3;
+		double denom = ddenom(previous, next);
+		if (denom != 0) {
+			double dd = std::fabs(cross(previous, current, next) / denom);
+			alpha = (dd > 1) ? (1 - 1.0 / dd) : 0;
+			alpha = alpha / 0.75;
+		}
+
+		if (alpha >= BitmapTracer::AlphaMax) {
+			points.append(current);
+			points.append(end);
+			continue;
+		}
+
+		alpha = qBound(0.55, alpha, 1.0);
+		appendCurve(interval(0.5 + 0.5 * alpha, previous, current), interval(0.5 + 0.5 * alpha, next, current), end, points);
+	}
+	points.removeLast();		// back at the start
+	return points;
+}
+
+// even-odd test; the point is never on the boundary, since it is a pixel center and loops run along pixel edges
+bool contains(const QPolygon & polygon, const QPointF & p) {
+	bool inside = false;
+	for (int i = 0, j = polygon.count() - 1; i < polygon.count(); j = i++) {
+		const QPoint & a = polygon.at(i);
+		const QPoint & b = polygon.at(j);
+		if ((a.y() > p.y()) != (b.y() > p.y()) &&
+		    p.x() < a.x() + (p.y() - a.y()) * (b.x() - a.x()) / double(b.y() - a.y()))
+		{
+			inside = !inside;
+		}
+	}
+	return inside;
+}
+
+bool inTriangle(const QPointF & p, const QPointF & a, const QPointF & b, const QPointF & c) {
+	double d1 = cross(a, b, p);
+	double d2 = cross(b, c, p);
+	double d3 = cross(c, a, p);
+	return !(((d1 < 0) || (d2 < 0) || (d3 < 0)) && ((d1 > 0) || (d2 > 0) || (d3 > 0)));
+}
+
+int rightmost(const Points & points) {
+	int index = 0;
+	for (int i = 1; i < points.count(); i++) {
+		if (points.at(i).x() > points.at(index).x()) index = i;
+	}
+	return index;
+}
+
+// splices the hole into the outline: ... p, m, round the hole back to m, p, ...
+void joinHole(Points & outline, const Points & hole) {
+	int count = outline.count();
+	int m = rightmost(hole);
+	QPointF mp = hole.at(m);
+
+	// the nearest outline edge hit by a ray going right from m
+	double hitX = 0;
+	int edge = -1;
+	for (int i = 0; i < count; i++) {
+		const QPointF & a = outline.at(i);
+		const QPointF & b = outline.at((i + 1) % count);
+		if ((a.y() > mp.y()) == (b.y() > mp.y())) continue;
+
+		double x = a.x() + (mp.y() - a.y()) * (b.x() - a.x()) / (b.y() - a.y());
+		if (x < mp.x()) continue;
+		if (edge < 0 || x < hitX) {
+			hitX = x;
+			edge = i;
+		}
+	}
+
+	int p = 0;
+	if (edge < 0) {
+		// smoothing moved the hole out of its outline; any cut will do
+		double nearest = -1;
+		for (int i = 0; i < count; i++) {
+			double d = std::hypot(outline.at(i).x() - mp.x(), outline.at(i).y() - mp.y());
+			if (nearest < 0 || d < nearest) {
+				nearest = d;
+				p = i;
+			}
+		}
+	}
+	else {
+		// the end of the edge farther right, unless another outline point inside the triangle m, hit, p
+		// blocks the view; then the one of those closest in angle to the ray
+		int next = (edge + 1) % count;
+		p = (outline.at(edge).x() > outline.at(next).x()) ? edge : next;
+		QPointF hit(hitX, mp.y());
+		QPointF pp = outline.at(p);
+		int farther = p;
+		double bestAngle = -1;
+		double bestDistance = 0;
+		for (int i = 0; i < count && pp.y() != mp.y(); i++) {		// p on the ray is always visible
+			const QPointF & q = outline.at(i);
+			if (i == farther || q.x() < mp.x() || !inTriangle(q, mp, hit, pp)) continue;
+
+			double dx = q.x() - mp.x();
+			double dy = q.y() - mp.y();
+			double angle = std::atan2(std::fabs(dy), dx);
+			double d = std::hypot(dx, dy);
+			if (bestAngle < 0 || angle < bestAngle || (angle == bestAngle && d < bestDistance)) {
+				bestAngle = angle;
+				bestDistance = d;
+				p = i;
+			}
+		}
+	}
+
+	Points joined;
+	joined.reserve(count + hole.count() + 2);
+	for (int i = 0; i <= p; i++) joined.append(outline.at(i));
+	for (int i = 0; i <= hole.count(); i++) joined.append(hole.at((m + i) % hole.count()));
+	for (int i = p; i < count; i++) joined.append(outline.at(i));
+	outline = joined;
+}
+
+QString number(double value) {
+	QString string = QString::number(value, 'f', 2);
+	while (string.endsWith('0')) string.chop(1);
+	if (string.endsWith('.')) string.chop(1);
+	if (string == "-0") string = "0";
+	return string;
+}
+
+}
+
+QList<QRect> BitmapTracer::runs(const QImage & image)
+{
+	QImage mono = (image.format() == QImage::Format_Mono) ? image : image.convertToFormat(QImage::Format_Mono);
+
+	QList<QRect> rects;
+	for (int y = 0; y < mono.height(); y++) {
+		const uchar * s = mono.constScanLine(y);
+		int start = -1;
+		for (int x = 0; x < mono.width(); x++) {
+			bool set = (*(s + (x >> 3)) >> (~x & 7)) & 1;
+			if (set) {
+				if (start < 0) start = x;
+			}
+			else if (start >= 0) {
+				rects.append(QRect(start, y, x - start, 1));
+				start = -1;
+			}
+		}
+		if (start >= 0) {
+			rects.append(QRect(start, y, mono.width() - start, 1));
+		}
+	}
+
+	return rects;
+}
+
+QList<QPolygonF> BitmapTracer::polygons(const QList<QRect> & runs)
+{
+	QList<QPolygon> outlines;
+	QList<QPolygon> holes;
+	Q_FOREACH (QPolygon loop, ScanLineTracer::loops(runs)) {
+		Points points;
+		Q_FOREACH (QPoint p, loop) {
+			points.append(p);
+		}
+		double area = polygonArea(points);
+		if (std::fabs(area) <= TurdSize) continue;
+
+		if (area > 0) outlines.append(loop);
+		else holes.append(loop);
+	}
+
+	// smallest first, so a hole goes to the innermost outline around it
+	std::sort(outlines.begin(), outlines.end(), [](const QPolygon & a, const QPolygon & b) {
+		QRect ra = a.boundingRect();
+		QRect rb = b.boundingRect();
+		return qint64(ra.width()) * ra.height() < qint64(rb.width()) * rb.height();
+	});
+	QVector<QRect> bounds;
+	Q_FOREACH (QPolygon outline, outlines) {
+		bounds.append(outline.boundingRect());
+	}
+
+	QVector<QList<Points> > pieceHoles(outlines.count());
+	Q_FOREACH (QPolygon hole, holes) {
+		// the pixel just above the hole's top left corner belongs to the piece the hole is in
+		QPoint topLeft = hole.first();
+		Q_FOREACH (QPoint p, hole) {
+			if (p.y() < topLeft.y() || (p.y() == topLeft.y() && p.x() < topLeft.x())) topLeft = p;
+		}
+		QPointF inside(topLeft.x() + 0.5, topLeft.y() - 0.5);
+		for (int i = 0; i < outlines.count(); i++) {
+			if (!bounds.at(i).contains(topLeft.x(), topLeft.y() - 1)) continue;
+			if (!contains(outlines.at(i), inside)) continue;
+
+			Points points;
+			Q_FOREACH (QPoint p, hole) {
+				points.append(p);
+			}
+			pieceHoles[i].append(smoothLoop(simplifyLoop(points, Tolerance)));
+			break;
+		}
+	}
+
+	QList<QPolygonF> polygons;
+	for (int i = 0; i < outlines.count(); i++) {
+		Points outline;
+		Q_FOREACH (QPoint p, outlines.at(i)) {
+			outline.append(p);
+		}
+		outline = smoothLoop(simplifyLoop(outline, Tolerance));
+
+		QList<Points> & joining = pieceHoles[i];
+		std::sort(joining.begin(), joining.end(), [](const Points & a, const Points & b) {
+			return a.at(rightmost(a)).x() > b.at(rightmost(b)).x();
+		});
+		Q_FOREACH (Points hole, joining) {
+			joinHole(outline, hole);
+		}
+
+		polygons.append(QPolygonF(outline));
+	}
+
+	return polygons;
+}
+
+QString BitmapTracer::traceSvg(const QImage & image, double res, const QString & colorString, const QString & layerName)
+{
+	QList<QPolygonF> pieces = polygons(runs(image));
+	if (pieces.isEmpty()) return "";
+
+	QString svg = TextUtils::makeSVGHeader(res, res, image.width(), image.height()) + QString("<g id='%1'>\n").arg(layerName);
+	Q_FOREACH (QPolygonF piece, pieces) {
+		QString points;
+		Q_FOREACH (QPointF p, piece) {
+			points += number(p.x()) + ',' + number(p.y()) + ' ';
+		}
+		points.chop(1);
+		svg += QString("<polygon fill='%1' stroke='none' stroke-width='0' points='%2'/>\n").arg(colorString, points);
+	}
+	svg += "</g>\n</svg>\n";
+	return svg;
+}
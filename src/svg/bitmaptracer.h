@@ -0,0 +1,49 @@
+/*******************************************************************
+
+Part of the Fritzing project - http://fritzing.org
+Copyright (c) 2007-2019 Fritzing
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************/
+
+#ifndef BITMAPTRACER_H
+#define BITMAPTRACER_H
+
+#include <QImage>
+#include <QList>
+#include <QPolygonF>
+#include <QRect>
+#include <QString>
+
+// vectorizes a one bit image along the lines of potrace: the pixel boundary loops are simplified to
+// polygons and the polygon corners are then rounded off with bezier curves, except where the angle is
+// sharp enough to stay a corner.  The curves are flattened and each piece is written as one <polygon>,
+// with its holes joined in by zero-width cuts, so gerber export keeps it as vectors.  Used for raster
+// logo images, where writing out every pixel run makes very large svgs.
+class BitmapTracer
+{
+public:
+	static QList<QRect> runs(const QImage & image);				// the one pixel high runs of set pixels in a Format_Mono image
+	static QList<QPolygonF> polygons(const QList<QRect> & runs);	// one simple polygon per piece, in pixel coordinates
+	static QString traceSvg(const QImage & image, double res, const QString & colorString, const QString & layerName);
+
+public:
+	static constexpr int TurdSize = 2;					// pieces and holes of this many pixels or fewer are dropped
+	static constexpr double Tolerance = 1.0;			// how far (in pixels) a polygon side may cut across the pixel boundary
+	static constexpr double AlphaMax = 1.0;				// corner threshold; 0 keeps every corner sharp, above 4/3 rounds them all
+	static constexpr double CurveTolerance = 0.5;		// how far (in pixels) the line segments of a flattened curve may stray from it
+};
+
+#endif
@@ -38,6 +38,7 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include "groundplanegenerator.h"
 #include "svgfilesplitter.h"
 #include "svgpathregex.h"
+#include "../testing/FProbeTiming.h"
 
 const QString GerberGenerator::SilkTopSuffix = "_silkTop.gto";
 const QString GerberGenerator::SilkBottomSuffix = "_silkBottom.gbo";
@@ -78,6 +79,7 @@ bool pixelsCollide(QImage * image1, QImage * image2, int x1, int y1, int x2, int
 
 void GerberGenerator::exportToGerber(const QString & prefix, const QString & exportDir, ItemBase * board, PCBSketchWidget * sketchWidget, bool displayMessageBoxes)
 {
+	FProbeTimer probeTimer("GerberExport");
 	if (board == nullptr) {
 		int boardCount = 0;
 		board = sketchWidget->findSelectedBoard(boardCount);
@@ -332,6 +334,7 @@ int GerberGenerator::doEnd(const QString & svg, int boardLayers, const QString &
 {
 	// create mask gerber from svg
 	SVG2gerber gerber;
+	gerber.setSpooling(true);
 	int invalidCount = gerber.convert(svg, boardLayers == 2, layerName, forWhy, svgSize);
 
 	saveEnd(layerName, exportDir, prefix, suffix, displayMessageBoxes, gerber);
@@ -349,11 +352,12 @@ bool GerberGenerator::saveEnd(const QString & layerName, const QString & exportD
 		return false;
 	}
 
-	QTextStream stream(&out);
-	stream << gerber.getGerber();
-	stream.flush();
+	bool result = gerber.writeGerber(out);
 	out.close();
-	return true;
+	if (!result) {
+		displayMessage(QObject::tr("%1 layer: unable to save to '%2'").arg(layerName, outname), displayMessageBoxes);
+	}
+	return result;
 
 }
 
@@ -0,0 +1,123 @@
+/*******************************************************************
+
+Part of the Fritzing project - http://fritzing.org
+Copyright (c) 2007-2019 Fritzing
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************/
+
+#include "gerberwriter.h"
+#include "../debugdialog.h"
+
+#include <QTemporaryFile>
+#include <QDir>
+
+GerberWriter::~GerberWriter()
+{
+	delete m_spool;
+}
+
+void GerberWriter::setSpooling(bool spooling)
+{
+	m_spooling = spooling;
+}
+
+GerberWriter & GerberWriter::operator+=(const QString & string)
+{
+	append(string.toLatin1());
+	return *this;
+}
+
+GerberWriter & GerberWriter::operator+=(const char * string)
+{
+	append(QByteArray(string));
+	return *this;
+}
+
+void GerberWriter::append(const QByteArray & bytes)
+{
+	m_buffer.append(bytes);
+	if (m_buffer.size() > m_peakBufferSize) {
+		m_peakBufferSize = m_buffer.size();
+	}
+
+	if (m_spooling && m_buffer.size() >= ChunkSize) {
+		flush();
+	}
+}
+
+bool GerberWriter::flush()
+{
+	if (m_buffer.isEmpty()) return true;
+
+	if (m_spool == nullptr) {
+		m_spool = new QTemporaryFile(QDir::temp().absoluteFilePath("fritzing_gerber_XXXXXX"));
+		if (!m_spool->open()) {
+			// keep everything in memory instead
+			DebugDialog::debug(QString("unable to open gerber spool file %1").arg(m_spool->fileName()));
+			delete m_spool;
+			m_spool = nullptr;
+			m_spooling = false;
+			return false;
+		}
+	}
+
+	if (m_spool->write(m_buffer) != m_buffer.size()) {
+		DebugDialog::debug(QString("unable to write gerber spool file %1").arg(m_spool->fileName()));
+		return false;
+	}
+
+	m_spooled += m_buffer.size();
+	m_buffer.clear();
+	return true;
+}
+
+bool GerberWriter::writeTo(QIODevice & device)
+{
+	if (m_spool != nullptr) {
+		if (!flush()) return false;
+
+		m_spool->seek(0);
+		while (!m_spool->atEnd()) {
+			QByteArray chunk = m_spool->read(ChunkSize);
+			if (device.write(chunk) != chunk.size()) return false;
+		}
+		m_spool->seek(m_spool->size());
+		return true;
+	}
+
+	return device.write(m_buffer) == m_buffer.size();
+}
+
+QByteArray GerberWriter::toByteArray()
+{
+	if (m_spool == nullptr) return m_buffer;
+
+	flush();
+	m_spool->seek(0);
+	QByteArray bytes = m_spool->readAll();
+	m_spool->seek(m_spool->size());
+	return bytes;
+}
+
+qint64 GerberWriter::size() const
+{
+	return m_spooled + m_buffer.size();
+}
+
+qint64 GerberWriter::peakBufferSize() const
+{
+	return m_peakBufferSize;
+}
@@ -0,0 +1,64 @@
+/*******************************************************************
+
+Part of the Fritzing project - http://fritzing.org
+Copyright (c) 2007-2019 Fritzing
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************/
+
+#ifndef GERBERWRITER_H
+#define GERBERWRITER_H
+
+#include <QByteArray>
+#include <QString>
+
+class QIODevice;
+class QTemporaryFile;
+
+// Collects the body (draw commands, drill hits) of a gerber or excellon file as it is produced.
+// Gerber output is plain ASCII, so it is kept as bytes rather than as a UTF-16 QString.
+// With spooling on, the body is flushed to a temporary file in small chunks and later copied
+// to the output file, so a large copper fill never has to be held in memory as a whole.
+
+class GerberWriter
+{
+public:
+	GerberWriter() = default;
+	~GerberWriter();
+
+	void setSpooling(bool);
+	GerberWriter & operator+=(const QString &);
+	GerberWriter & operator+=(const char *);
+	bool writeTo(QIODevice &);
+	QByteArray toByteArray();
+	qint64 size() const;
+	qint64 peakBufferSize() const;
+
+public:
+	static constexpr int ChunkSize = 64 * 1024;
+
+protected:
+	void append(const QByteArray &);
+	bool flush();
+
+protected:
+	QByteArray m_buffer;
+	QTemporaryFile * m_spool = nullptr;
+	bool m_spooling = false;
+	qint64 m_spooled = 0;
+	qint64 m_peakBufferSize = 0;
+};
+
+#endif // GERBERWRITER_H
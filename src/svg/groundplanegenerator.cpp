@@ -19,6 +19,7 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 ********************************************************************/
 
 #include "groundplanegenerator.h"
+#include "scanlinetracer.h"
 #include "svgfilesplitter.h"
 #include "../fsvgrenderer.h"
 #include "../debugdialog.h"
@@ -248,6 +249,15 @@ bool GroundPlaneGenerator::generateGroundPlaneUnit(const QString & boardSvg, QSi
 bool GroundPlaneGenerator::generateGroundPlane(const QString & boardSvg, QSizeF boardImageSize, const QString & svg, QSizeF copperImageSize,
 		QStringList & exceptions, QGraphicsItem * board, double res, const QString & color, double keepoutMils)
 {
+	QFuture<bool> future = startGroundPlane(boardSvg, boardImageSize, svg, copperImageSize, exceptions, board, res, color, keepoutMils);
+	waitForGroundPlanes(QList< QFuture<bool> >() << future);
+	return future.result();
+}
+
+QFuture<bool> GroundPlaneGenerator::startGroundPlane(const QString & boardSvg, QSizeF boardImageSize, const QString & svg, QSizeF copperImageSize,
+		QStringList & exceptions, QGraphicsItem * board, double res, const QString & color, double keepoutMils)
+{
+	// the generator must outlive the returned future
 	GPGParams params;
 	params.boardSvg = boardSvg;
 	params.keepoutMils = keepoutMils;
@@ -259,14 +269,19 @@ bool GroundPlaneGenerator::generateGroundPlane(const QString & boardSvg, QSizeF
 	params.res = res;
 	params.color = color;
 #if QT_VERSION < QT_VERSION_CHECK(6, 0, 0)
-	QFuture<bool> future = QtConcurrent::run(this, &GroundPlaneGenerator::generateGroundPlaneFn, params);
+	return QtConcurrent::run(this, &GroundPlaneGenerator::generateGroundPlaneFn, params);
 #else
-	QFuture<bool> future = QtConcurrent::run(&GroundPlaneGenerator::generateGroundPlaneFn, this, params);
+	return QtConcurrent::run(&GroundPlaneGenerator::generateGroundPlaneFn, this, params);
 #endif
-	while (!future.isFinished()) {
-		ProcessEventBlocker::processEvents(200);
+}
+
+void GroundPlaneGenerator::waitForGroundPlanes(const QList< QFuture<bool> > & futures)
+{
+	Q_FOREACH (QFuture<bool> future, futures) {
+		while (!future.isFinished()) {
+			ProcessEventBlocker::processEvents(200);
+		}
 	}
-	return future.result();
 }
 
 bool GroundPlaneGenerator::generateGroundPlaneFn(const GPGParams &constParams)
@@ -356,7 +371,7 @@ QImage * GroundPlaneGenerator::generateGroundPlaneAux(GPGParams & params, double
 	painter.end();
 
 #ifndef QT_NO_DEBUG
-	image->save(FolderUtils::getTopLevelUserDataStorePath() + "/testGroundFillBoard.png");
+	image->save(FolderUtils::getTopLevelUserDataStorePath() + "/testGroundFillBoard_" + m_layerName + ".png");
 #endif
 
 	DRC::extendBorder(BORDERINCHES * params.res, image);
@@ -391,7 +406,7 @@ QImage * GroundPlaneGenerator::generateGroundPlaneAux(GPGParams & params, double
 	*/
 
 #ifndef QT_NO_DEBUG
-	image->save(FolderUtils::getTopLevelUserDataStorePath() + "/testGroundFillBoardBorder.png");
+	image->save(FolderUtils::getTopLevelUserDataStorePath() + "/testGroundFillBoardBorder_" + m_layerName + ".png");
 #endif
 
 	QSvgRenderer renderer2(copperByteArray);
@@ -403,7 +418,7 @@ QImage * GroundPlaneGenerator::generateGroundPlaneAux(GPGParams & params, double
 	painter.end();
 
 #ifndef QT_NO_DEBUG
-	image->save(FolderUtils::getTopLevelUserDataStorePath() + "/testGroundFillCopper.png");
+	image->save(FolderUtils::getTopLevelUserDataStorePath() + "/testGroundFillCopper_" + m_layerName + ".png");
 #endif
 
 	Q_EMIT postImageSignal(this, image, &boardImage, params.board, &rects);
@@ -417,18 +432,16 @@ void GroundPlaneGenerator::scanImage(QImage & image, double bWidth, double bHeig
 {
 	QList<QRect> rects;
 	scanLines(image, bWidth, bHeight, rects);
-	QList< QList<int> * > pieces;
-	splitScanLines(rects, pieces);
-	Q_FOREACH (QList<int> * piece, pieces) {
-		QList<QPolygon> polygons;
-		QList<QRect> newRects;
-		Q_FOREACH (int i, *piece) {
-			QRect r = rects.at(i);
-			newRects.append(QRect(r.x() * pixelFactor, r.y() * pixelFactor, (r.width() * pixelFactor) + 1, pixelFactor + 1));    // + 1 is for off-by-one converting rects to polys
+
+	// one polygon per piece, with its holes cut in
+	Q_FOREACH (QPolygon polygon, ScanLineTracer::trace(rects)) {
+		for (int i = 0; i < polygon.count(); i++) {
+			QPoint p = polygon.at(i);
+			polygon[i] = QPoint(qRound(p.x() * pixelFactor), qRound(p.y() * pixelFactor));
 		}
 
-		// note: there is always one
-		joinScanLines(newRects, polygons);
+		QList<QPolygon> polygons;
+		polygons.append(polygon);
 		makePolySvg(polygons, res, bWidth, bHeight, pixelFactor, colorString, makeConnectorFlag, makeOffset, minAreaInches, minDimensionInches, polygonOffset);
 	}
 }
@@ -436,325 +449,7 @@ void GroundPlaneGenerator::scanImage(QImage & image, double bWidth, double bHeig
 
 void GroundPlaneGenerator::scanLines(QImage & image, int bWidth, int bHeight, QList<QRect> & rects)
 {
-	Q_ASSERT(image.format() == QImage::Format_Mono);
-//    Q_ASSERT(image.colorTable()[1] == 0xffffffff);
-
-	int index = 0;
-
-	if (m_minRiseSize > 1) {
-		for (int x = 0; x < bWidth; x++) {
-			bool inWhite = false;
-			int whiteStart = 0;
-			for (int y = 0; y < bHeight; y++) {
-				uchar * s = image.scanLine(y);
-				index = (*(s + (x >> 3)) >> (~x & 7)) & 1;
-
-				if (inWhite) {
-					if (index == 1) {
-						// another white pixel, keep moving
-						continue;
-					}
-
-					// got black: close up this segment;
-					inWhite = false;
-					if (y - whiteStart < m_minRiseSize) {
-						for (int j = whiteStart; j <= y; j++) {
-							uchar * r = image.scanLine(j);
-							*(r + (x >> 3)) &= ~(1 << (7-(x & 7)));  //image.setPixel(x, j, 0);
-						}
-						continue;
-					}
-
-				}
-				else {
-					if (index != 1) {
-						// another black pixel, keep moving
-						continue;
-					}
-
-					inWhite = true;
-					whiteStart = y;
-				}
-			}
-			if (inWhite) {
-				// close up the last segment
-				if (bHeight - whiteStart < m_minRiseSize) {
-					for (int j = whiteStart; j <= bHeight; j++) {
-						uchar * r = image.scanLine(j);
-						*(r + (x >> 3)) &= ~(1 << (7-(x & 7)));  //image.setPixel(x, j, 0);
-					}
-				}
-			}
-		}
-	}
-
-	for (int y = 0; y < bHeight; y++) {
-		uchar * s = image.scanLine(y);
-
-		bool inWhite = false;
-		int whiteStart = 0;
-
-		for (int x = 0; x < bWidth; x++) {
-			index = (*(s + (x >> 3)) >> (~x & 7)) & 1;
-
-			if (inWhite) {
-				if (index == 1) {
-					// another white pixel, keep moving
-					continue;
-				}
-
-				// got black: close up this segment;
-				inWhite = false;
-				if (x - whiteStart < m_minRunSize) {
-					// not a big enough section
-					continue;
-				}
-
-				rects.append(QRect(whiteStart, y, x - whiteStart, 1));
-			}
-			else {
-				if (index != 1) {		// qBlue(current) != 0xff
-					// another black pixel, keep moving
-					continue;
-				}
-
-				inWhite = true;
-				whiteStart = x;
-			}
-		}
-		if (inWhite) {
-			// close up the last segment
-			if (bWidth - whiteStart >= m_minRunSize) {
-				rects.append(QRect(whiteStart, y, bWidth - whiteStart, 1));
-			}
-		}
-	}
-}
-
-void GroundPlaneGenerator::splitScanLines(QList<QRect> & rects, QList< QList<int> * > & pieces)
-{
-	// combines vertically adjacent scanlines into "pieces"
-	int ix = 0;
-	int prevFirst = -1;
-	int prevLast = -1;
-	while (ix < rects.count()) {
-		int first = ix;
-		QRectF firstR = rects.at(ix);
-		while (++ix < rects.count()) {
-			QRectF nextR = rects.at(ix);
-			if (epsilon_difference(nextR.y(), firstR.y()) > reldif) {
-				break;
-			}
-		}
-		int last = ix - 1;  // this was a lookahead so step back one
-		if (prevFirst >= 0) {
-			for (int i = first; i <= last; i++) {
-				QRectF candidate = rects.at(i);
-				int gotCount = 0;
-				for (int j = prevFirst; j <= prevLast; j++) {
-					QRectF prev = rects.at(j);
-					if (epsilon_difference(prev.y() + 1.0, candidate.y()) > reldif) {
-						// skipped a line; no intersection possible
-						break;
-					}
-
-					if ((prev.x() + prev.width() <= candidate.x()) || (candidate.x() + candidate.width() <= prev.x())) {
-						// candidate and prev didn't intersect
-						continue;
-					}
-
-					if (++gotCount > 1) {
-						QList<int> * piecei = nullptr;
-						QList<int> * piecej = nullptr;
-						Q_FOREACH (QList<int> * piece, pieces) {
-							if (piece->contains(j)) {
-								piecej = piece;
-								break;
-							}
-						}
-						Q_FOREACH (QList<int> * piece, pieces) {
-							if (piece->contains(i)) {
-								piecei = piece;
-								break;
-							}
-						}
-						if (piecei != nullptr && piecej != nullptr) {
-							if (piecei != piecej) {
-								Q_FOREACH (int b, *piecej) {
-									piecei->append(b);
-								}
-								piecej->clear();
-								pieces.removeOne(piecej);
-								delete piecej;
-							}
-							piecei->append(i);
-						}
-						else {
-							DebugDialog::debug("we are really screwed here, what should we do about it?");
-						}
-					}
-					else {
-						// put the candidate (i) in j's piece
-						Q_FOREACH (QList<int> * piece, pieces) {
-							if (piece->contains(j)) {
-								piece->append(i);
-								break;
-							}
-						}
-					}
-				}
-
-				if (gotCount == 0) {
-					// candidate is an orphan line at this point
-					auto * piece = new QList<int>;
-					piece->append(i);
-					pieces.append(piece);
-				}
-
-			}
-		}
-		else {
-			for (int i = first; i <= last; i++) {
-				auto * piece = new QList<int>;
-				piece->append(i);
-				pieces.append(piece);
-			}
-		}
-
-		prevFirst = first;
-		prevLast = last;
-	}
-
-	Q_FOREACH (QList<int> * piece, pieces) {
-		std::sort(piece->begin(), piece->end());
-	}
-}
-
-void GroundPlaneGenerator::joinScanLines(QList<QRect> & rects, QList<QPolygon> & polygons) {
-	QList< QList<int> * > pieces;
-	int ix = 0;
-	int prevFirst = -1;
-	int prevLast = -1;
-	while (ix < rects.count()) {
-		int first = ix;
-		QRectF firstR = rects.at(ix);
-		while (++ix < rects.count()) {
-			QRectF nextR = rects.at(ix);
-			if (epsilon_difference(nextR.y(), firstR.y()) > reldif) {
-				break;
-			}
-		}
-		int last = ix - 1;
-		if (prevFirst >= 0) {
-			QVector<int> holdPrevs(last - first + 1);
-			QVector<int> gotCounts(last - first + 1);
-			for (int i = first; i <= last; i++) {
-				int index = i - first;
-				holdPrevs[index] = 0;
-				gotCounts[index] = 0;
-				QRectF candidate = rects.at(i);
-				for (int j = prevFirst; j <= prevLast; j++) {
-					QRectF prev = rects.at(j);
-
-					if ((prev.x() + prev.width() <= candidate.x()) || (candidate.x() + candidate.width() <= prev.x())) {
-						// candidate and prev didn't intersect
-						continue;
-					}
-
-					holdPrevs[index] = j;
-					gotCounts[index]++;
-				}
-				if (gotCounts[index] > 1) {
-					holdPrevs[index] = -1;			// clear this to allow one of the others in this scanline to capture a previous
-				}
-			}
-			for (int i = first; i <= last; i++) {
-				int index = i - first;
-
-				bool gotOne = false;
-				if (gotCounts[index] == 1) {
-					bool unique = true;
-					for (int j = first; j <= last; j++) {
-						if (j - first == index) continue;			// don't compare against yourself
-
-						if (holdPrevs[index] == holdPrevs[j - first]) {
-							unique = false;
-							break;
-						}
-					}
-
-					if (unique) {
-						// add this to the previous chunk
-						gotOne = true;
-						Q_FOREACH (QList<int> * piece, pieces) {
-							if (piece->contains(holdPrevs[index])) {
-								piece->append(i);
-								break;
-
-							}
-						}
-					}
-				}
-				if (!gotOne) {
-					// start a new chunk
-					holdPrevs[index] = -1;						// allow others to capture the prev
-					auto * piece = new QList<int>;
-					piece->append(i);
-					pieces.append(piece);
-				}
-			}
-		}
-		else {
-			for (int i = first; i <= last; i++) {
-				auto * piece = new QList<int>;
-				piece->append(i);
-				pieces.append(piece);
-			}
-		}
-
-		prevFirst = first;
-		prevLast = last;
-	}
-
-	Q_FOREACH (QList<int> * piece, pieces) {
-		//QPolygon poly(rects.at(piece->at(0)), true);
-		//for (int i = 1; i < piece->length(); i++) {
-		//QPolygon temp(rects.at(piece->at(i)), true);
-		//poly = poly.united(temp);
-		//}
-
-		// no need to close polygon; SVG automatically closes path
-
-		QPolygon poly;
-
-		// left side
-		for (int i : *piece) {
-			QRect r = rects.at(i);
-			if ((poly.count() > 0) && (poly.last().x() == r.left())) {
-				poly.pop_back();
-			}
-			else {
-				poly.append(QPoint(r.left(), r.top()));
-			}
-			poly.append(QPoint(r.left(), r.bottom()));
-		}
-		// right side
-		for (int i = piece->length() - 1; i >= 0; i--) {
-			QRect r = rects.at(piece->at(i));
-			if ((poly.count() > 0) && (poly.last().x() == r.right())) {
-				poly.pop_back();
-			}
-			else {
-				poly.append(QPoint(r.right(), r.bottom()));
-			}
-			poly.append(QPoint(r.right(), r.top()));
-		}
-
-
-
-		polygons.append(poly);
-		delete piece;
-	}
+	ScanLineTracer::scanLines(image, bWidth, bHeight, m_minRunSize, m_minRiseSize, rects);
 }
 
 void GroundPlaneGenerator::makePolySvg(QList<QPolygon> & polygons, double res, double bWidth, double bHeight, double pixelFactor,
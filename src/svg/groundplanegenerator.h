@@ -21,6 +21,7 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #ifndef GROUNDPLANEGENERATOR_H
 #define GROUNDPLANEGENERATOR_H
 
+#include <QFuture>
 #include <QImage>
 #include <QList>
 #include <QRect>
@@ -51,6 +52,8 @@ public:
 
 	bool generateGroundPlane(const QString & boardSvg, QSizeF boardImageSize, const QString & svg, QSizeF copperImageSize, QStringList & exceptions,
 	                         QGraphicsItem * board, double res, const QString & color, double keepoutMils);
+	QFuture<bool> startGroundPlane(const QString & boardSvg, QSizeF boardImageSize, const QString & svg, QSizeF copperImageSize, QStringList & exceptions,
+	                               QGraphicsItem * board, double res, const QString & color, double keepoutMils);
 	bool generateGroundPlaneUnit(const QString & boardSvg, QSizeF boardImageSize, const QString & svg, QSizeF copperImageSize, QStringList & exceptions,
 	                             QGraphicsItem * board, double res, const QString & color, QPointF whereToStart, double keepoutMils);
 	void scanImage(QImage & image, double bWidth, double bHeight, double pixelFactor, double res,
@@ -68,6 +71,9 @@ public:
 	void setMinRunSize(int minRunSize, int minRiseSize);
 	QString mergeSVGs(const QString & initialSVG, const QString & layerName);
 
+public:
+	static void waitForGroundPlanes(const QList< QFuture<bool> > & futures);
+
 public:
 	static QString ConnectorName;
 
@@ -75,8 +81,6 @@ Q_SIGNALS:
 	void postImageSignal(GroundPlaneGenerator *, QImage * copperImage, QImage * boardImage, QGraphicsItem * board, QList<QRectF> *);
 
 protected:
-	void splitScanLines(QList<QRect> & rects, QList< QList<int> * > & pieces);
-	void joinScanLines(QList<QRect> & rects, QList<QPolygon> & polygons);
 	QString makePolySvg(QList<QPolygon> & polygons, double res, double bWidth, double bHeight, double pixelFactor, const QString & colorString,
 	                    bool makeConnectorFlag, QPointF * offset, QSizeF minAreaInches, double minDimensionInches, QPointF polygonOffset);
 	void makePolySvg(QList<QPolygon> & polygons, double res, double bWidth, double bHeight, double pixelFactor,
@@ -31,6 +31,8 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include <QDomDocument>
 #include <QDomElement>
 #include <QDateTime>
+#include <QFuture>
+#include <QtConcurrentRun>
 #include <qmath.h>
 #include <limits>
 
@@ -89,20 +91,13 @@ QStringList KicadModule2Svg::listModules(const QString & filename) {
 
 QString KicadModule2Svg::convert(const QString & filename, const QString & moduleName, bool allowPadsAndPins)
 {
-	m_nonConnectorNumber = 0;
-	initLimits();
-
 	QFile file(filename);
 	if (!file.open(QFile::ReadOnly)) {
 		throw QObject::tr("unable to open %1").arg(filename);
 	}
 
-	QString text;
 	QTextStream textStream(&file);
 
-	QString metadata = makeMetadata(filename, "module", moduleName);
-
-
 	bool gotModule = false;
 	while (true) {
 		QString line = textStream.readLine();
@@ -120,6 +115,78 @@ QString KicadModule2Svg::convert(const QString & filename, const QString & modul
 		throw QObject::tr("footprint %1 not found in %2").arg(moduleName).arg(filename);
 	}
 
+	return convertModule(textStream, filename, moduleName, allowPadsAndPins);
+}
+
+QList<KicadModule2Svg::Module> KicadModule2Svg::splitModules(const QString & filename) {
+	QList<Module> modules;
+
+	QFile file(filename);
+	if (!file.open(QFile::ReadOnly)) return modules;
+
+	QTextStream textStream(&file);
+	Module * module = nullptr;
+	while (true) {
+		QString line = textStream.readLine();
+		if (line.isNull()) break;
+
+		if (module == nullptr) {
+			if (line.startsWith("$MODULE ")) {
+				modules.append(Module());
+				module = &modules.last();
+				module->name = line.mid(8).trimmed();
+			}
+			continue;
+		}
+
+		module->text += line;
+		module->text += '\n';
+		if (line.startsWith("$EndMODULE")) {
+			module = nullptr;
+		}
+	}
+
+	return modules;
+}
+
+QList<KicadModule2Svg::ConvertedModule> KicadModule2Svg::convertLibrary(const QString & filename, bool allowPadsAndPins) {
+	// each module is converted on its own thread from the text split out of a single read of the file
+	QList< QFuture<ConvertedModule> > futures;
+	Q_FOREACH (Module module, splitModules(filename)) {
+		futures << QtConcurrent::run([filename, module, allowPadsAndPins]() {
+			ConvertedModule converted;
+			converted.name = module.name;
+			QString text = module.text;
+			QTextStream textStream(&text, QIODevice::ReadOnly);
+			KicadModule2Svg kicad;
+			try {
+				converted.svg = kicad.convertModule(textStream, filename, module.name, allowPadsAndPins);
+			}
+			catch (const QString & msg) {
+				converted.error = msg;
+			}
+			catch (...) {
+				converted.error = "who knows";
+			}
+			return converted;
+		});
+	}
+
+	QList<ConvertedModule> convertedModules;
+	Q_FOREACH (QFuture<ConvertedModule> future, futures) {
+		convertedModules.append(future.result());
+	}
+	return convertedModules;
+}
+
+// reads a module from textStream, which is positioned just after its $MODULE line
+QString KicadModule2Svg::convertModule(QTextStream & textStream, const QString & filename, const QString & moduleName, bool allowPadsAndPins)
+{
+	m_nonConnectorNumber = 0;
+	initLimits();
+
+	QString metadata = makeMetadata(filename, "module", moduleName);
+
 	bool gotT0;
 	QString line;
 	while (true) {
@@ -21,6 +21,7 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #ifndef KICADMODULE2SVG_H
 #define KICADMODULE2SVG_H
 
+#include <QList>
 #include <QString>
 #include <QStringList>
 #include <QTextStream>
@@ -35,7 +36,20 @@ public:
 	QString convert(const QString & filename, const QString & moduleName, bool allowPadsAndPins);
 
 public:
+	struct Module {
+		QString name;
+		QString text;			// the lines after $MODULE, through $EndMODULE
+	};
+
+	struct ConvertedModule {
+		QString name;
+		QString svg;
+		QString error;
+	};
+
 	static QStringList listModules(const QString & filename);
+	static QList<Module> splitModules(const QString & filename);
+	static QList<ConvertedModule> convertLibrary(const QString & filename, bool allowPadsAndPins);
 
 public:
 	enum PadLayer {
@@ -45,6 +59,7 @@ public:
 	};
 
 protected:
+	QString convertModule(QTextStream &, const QString & filename, const QString & moduleName, bool allowPadsAndPins);
 	KicadModule2Svg::PadLayer convertPad(QTextStream & stream, QString & pad, QList<int> & numbers);
 	int drawDSegment(const QString & ds, QString & line);
 	int drawDArc(const QString & ds, QString & arc);
@@ -0,0 +1,501 @@
+/*******************************************************************
+
+Part of the Fritzing project - http://fritzing.org
+Copyright (c) 2007-2019 Fritzing
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************/
+
+#include "scanlinetracer.h"
+
+#include <QHash>
+#include <QPair>
+#include <QVector>
+
+#include <algorithm>
+
+/*
+The boundary of the covered area is made of unit steps on the pixel grid.  Every step is directed
+so the covered pixels are on its right (y grows downwards): the top of a run goes east, its right
+side south, its bottom west and its left side north.  Walking from step to step, always turning right
+where two pieces touch at a corner, gives one closed loop per outline; outlines go clockwise and
+holes counterclockwise.  Only the points where the direction changes are kept.
+
+Each hole is then cut open from its top left corner straight up to the first boundary above it,
+which belongs to the outline or to a hole of the same piece that has already been joined.
+*/
+
+namespace {
+
+enum Direction {
+	East = 0,
+	South,
+	West,
+	North
+};
+
+struct Edge {
+	QPoint from;
+	QPoint to;
+	int direction;
+	int sibling;			// the other edge leaving the same point, where two pieces touch
+};
+
+struct Node {
+	QPoint point;
+	int next;
+	int loop;
+};
+
+struct Loop {
+	int first;
+	int topLeft;
+	int beforeTopLeft;
+	qint64 area;			// doubled, negative for holes
+	int root;				// the outline loop this loop ends up in
+};
+
+typedef QPair<int, int> Run;		// [left, right)
+typedef QVector<Run> Row;
+
+inline qint64 pointKey(const QPoint & p) {
+	return (qint64(p.y()) << 32) | quint32(p.x());
+}
+
+// the parts of the runs in a not covered by the runs in b
+Row subtract(const Row & a, const Row & b) {
+	Row result;
+	int j = 0;
+	Q_FOREACH (Run run, a) {
+		int left = run.first;
+		while (j < b.count() && b.at(j).second <= left) j++;
+		for (int k = j; k < b.count() && b.at(k).first < run.second; k++) {
+			if (b.at(k).first > left) {
+				result.append(Run(left, b.at(k).first));
+			}
+			left = qMax(left, b.at(k).second);
+		}
+		if (left < run.second) {
+			result.append(Run(left, run.second));
+		}
+	}
+	return result;
+}
+
+bool covered(const QVector<Row> & rows, int top, int x, int y) {
+	int ix = y - top;
+	if (ix < 0 || ix >= rows.count()) return false;
+
+	const Row & row = rows.at(ix);
+	auto it = std::upper_bound(row.begin(), row.end(), x, [](int value, const Run & run) {
+		return value < run.first;
+	});
+	if (it == row.begin()) return false;
+
+	--it;
+	return x < it->second;
+}
+
+bool sameDirection(const QPoint & a, const QPoint & b, const QPoint & c) {
+	if (a.x() == b.x() && b.x() == c.x()) {
+		return (qint64(b.y() - a.y()) * (c.y() - b.y())) > 0;
+	}
+	if (a.y() == b.y() && b.y() == c.y()) {
+		return (qint64(b.x() - a.x()) * (c.x() - b.x())) > 0;
+	}
+	return false;
+}
+
+bool isEast(const QVector<Node> & nodes, int n) {
+	const QPoint & p = nodes.at(n).point;
+	const QPoint & q = nodes.at(nodes.at(n).next).point;
+	return p.y() == q.y() && p.x() < q.x();
+}
+
+// fills rows with the merged runs of each row from top down, and nodes and loops with the boundary
+void traceLoops(const QList<QRect> & runs, QVector<Row> & rows, int & top, QVector<Node> & nodes, QVector<Loop> & loops)
+{
+	if (runs.isEmpty()) return;
+
+	top = runs.first().y();
+	int bottom = top;
+	Q_FOREACH (QRect r, runs) {
+		top = qMin(top, r.y());
+		bottom = qMax(bottom, r.y());
+	}
+
+	rows.resize(bottom - top + 1);
+	Q_FOREACH (QRect r, runs) {
+		if (r.width() <= 0) continue;
+		rows[r.y() - top].append(Run(r.x(), r.x() + r.width()));
+	}
+	for (int i = 0; i < rows.count(); i++) {
+		Row & row = rows[i];
+		std::sort(row.begin(), row.end());
+		// merge touching runs, so that every boundary point has at most two ways out
+		Row merged;
+		Q_FOREACH (Run run, row) {
+			if (!merged.isEmpty() && run.first <= merged.last().second) {
+				merged.last().second = qMax(merged.last().second, run.second);
+			}
+			else {
+				merged.append(run);
+			}
+		}
+		row = merged;
+	}
+
+	// collect the boundary steps; horizontal ones are already as long as they can be
+	QVector<Edge> edges;
+	QHash<qint64, int> outgoing;
+	auto addEdge = [&edges, &outgoing](QPoint from, QPoint to, int direction) {
+		Edge edge;
+		edge.from = from;
+		edge.to = to;
+		edge.direction = direction;
+		edge.sibling = outgoing.value(pointKey(from), -1);
+		outgoing.insert(pointKey(from), edges.count());
+		edges.append(edge);
+	};
+
+	Row none;
+	for (int i = 0; i <= rows.count(); i++) {
+		const Row & above = (i > 0) ? rows.at(i - 1) : none;
+		const Row & below = (i < rows.count()) ? rows.at(i) : none;
+		int y = top + i;
+		Q_FOREACH (Run run, subtract(below, above)) {
+			addEdge(QPoint(run.first, y), QPoint(run.second, y), East);
+		}
+		Q_FOREACH (Run run, subtract(above, below)) {
+			addEdge(QPoint(run.second, y), QPoint(run.first, y), West);
+		}
+		if (i < rows.count()) {
+			Q_FOREACH (Run run, below) {
+				addEdge(QPoint(run.second, y), QPoint(run.second, y + 1), South);
+				addEdge(QPoint(run.first, y + 1), QPoint(run.first, y), North);
+			}
+		}
+	}
+
+	// follow the steps round each loop, keeping the corners
+	QVector<bool> used(edges.count(), false);
+	for (int start = 0; start < edges.count(); start++) {
+		if (used.at(start)) continue;
+
+		int first = nodes.count();
+		int loopIndex = loops.count();
+		int current = start;
+		bool closed = true;
+		do {
+			used[current] = true;
+			const Edge & edge = edges.at(current);
+			int next = -1;
+			int bestRank = 3;
+			for (int o = outgoing.value(pointKey(edge.to), -1); o >= 0; o = edges.at(o).sibling) {
+				int turn = (edges.at(o).direction - edge.direction + 4) % 4;
+				int rank = (turn == 1) ? 0 : (turn == 0) ? 1 : (turn == 3) ? 2 : 3;		// right, straight, left
+				if (rank < bestRank) {
+					bestRank = rank;
+					next = o;
+				}
+			}
+			if (next < 0) {
+				closed = false;
+				break;
+			}
+			if (edges.at(next).direction != edge.direction) {
+				Node node;
+				node.point = edge.to;
+				node.next = nodes.count() + 1;
+				node.loop = loopIndex;
+				nodes.append(node);
+			}
+			current = next;
+		} while (current != start);
+
+		if (!closed || nodes.count() - first < 4) {
+			// shouldn't happen: the steps always close up
+			nodes.resize(first);
+			continue;
+		}
+
+		nodes.last().next = first;
+		Loop loop;
+		loop.first = first;
+		loop.topLeft = first;
+		loop.beforeTopLeft = nodes.count() - 1;
+		loop.area = 0;
+		loop.root = loopIndex;
+		for (int n = first, previous = nodes.count() - 1; n < nodes.count(); previous = n++) {
+			const QPoint & p = nodes.at(n).point;
+			const QPoint & q = nodes.at(nodes.at(n).next).point;
+			loop.area += qint64(p.x()) * q.y() - qint64(q.x()) * p.y();
+			const QPoint & best = nodes.at(loop.topLeft).point;
+			if (p.y() < best.y() || (p.y() == best.y() && p.x() < best.x())) {
+				loop.topLeft = n;
+				loop.beforeTopLeft = previous;
+			}
+		}
+		loops.append(loop);
+	}
+}
+
+}
+
+QList<QPolygon> ScanLineTracer::loops(const QList<QRect> & runs)
+{
+	QVector<Row> rows;
+	int top = 0;
+	QVector<Node> nodes;
+	QVector<Loop> loops;
+	traceLoops(runs, rows, top, nodes, loops);
+
+	QList<QPolygon> polygons;
+	Q_FOREACH (Loop loop, loops) {
+		QPolygon polygon;
+		int n = loop.first;
+		do {
+			polygon.append(nodes.at(n).point);
+			n = nodes.at(n).next;
+		} while (n != loop.first);
+		polygons.append(polygon);
+	}
+	return polygons;
+}
+
+QList<QPolygon> ScanLineTracer::trace(const QList<QRect> & runs)
+{
+	QVector<Row> rows;
+	int top = 0;
+	QVector<Node> nodes;
+	QVector<Loop> loops;
+	traceLoops(runs, rows, top, nodes, loops);
+
+	QList<QPolygon> polygons;
+	if (loops.isEmpty()) return polygons;
+
+	QHash<int, QVector<int> > eastEdges;
+	for (int n = 0; n < nodes.count(); n++) {
+		if (isEast(nodes, n)) {
+			eastEdges[nodes.at(n).point.y()].append(n);
+		}
+	}
+
+	QVector<int> holes;
+	QVector<int> outlines;
+	for (int i = 0; i < loops.count(); i++) {
+		if (loops.at(i).area < 0) holes.append(i);
+		else outlines.append(i);
+	}
+	auto byTopLeft = [&nodes, &loops](int a, int b) {
+		const QPoint & p = nodes.at(loops.at(a).topLeft).point;
+		const QPoint & q = nodes.at(loops.at(b).topLeft).point;
+		if (p.y() != q.y()) return p.y() < q.y();
+		return p.x() < q.x();
+	};
+	std::sort(holes.begin(), holes.end(), byTopLeft);
+	std::sort(outlines.begin(), outlines.end(), byTopLeft);
+
+	// cut each hole open to the boundary above it; holes higher up are joined first,
+	// so whatever the cut runs into is already part of the polygon
+	Q_FOREACH (int h, holes) {
+		int v = loops.at(h).topLeft;
+		QPoint vp = nodes.at(v).point;
+		int x = vp.x();
+		int y = vp.y() - 1;
+		while (covered(rows, top, x - 1, y - 1) && covered(rows, top, x, y - 1)) y--;
+
+		int found = -1;
+		QVector<int> & bucket = eastEdges[y];
+		Q_FOREACH (int n, bucket) {
+			if (nodes.at(n).point.x() <= x && x <= nodes.at(nodes.at(n).next).point.x()) {
+				found = n;
+				break;
+			}
+		}
+		Q_ASSERT(found >= 0);
+		if (found < 0) continue;
+
+		int q;
+		int after = nodes.at(found).next;
+		if (nodes.at(found).point.x() == x) {
+			q = found;
+		}
+		else if (nodes.at(after).point.x() == x) {
+			q = after;
+		}
+		else {
+			Node node;
+			node.point = QPoint(x, y);
+			node.next = after;
+			node.loop = nodes.at(found).loop;
+			q = nodes.count();
+			nodes.append(node);
+			nodes[found].next = q;
+		}
+
+		// q -> v -> round the hole -> v2 -> q2 -> on along the boundary
+		Node q2;
+		q2.point = nodes.at(q).point;
+		q2.next = nodes.at(q).next;
+		q2.loop = nodes.at(q).loop;
+		int q2Index = nodes.count();
+		nodes.append(q2);
+
+		Node v2;
+		v2.point = vp;
+		v2.next = q2Index;
+		v2.loop = h;
+		int v2Index = nodes.count();
+		nodes.append(v2);
+
+		nodes[loops.at(h).beforeTopLeft].next = v2Index;
+		nodes[q].next = v;
+
+		bucket.removeOne(q);
+		if (isEast(nodes, q2Index)) {
+			bucket.append(q2Index);
+		}
+
+		loops[h].root = loops.at(nodes.at(q).loop).root;
+	}
+
+	Q_FOREACH (int o, outlines) {
+		QPolygon polygon;
+		int n = loops.at(o).first;
+		for (int guard = 0; guard < nodes.count(); guard++) {
+			const QPoint & p = nodes.at(n).point;
+			if (polygon.isEmpty() || polygon.last() != p) {
+				while (polygon.count() >= 2 && sameDirection(polygon.at(polygon.count() - 2), polygon.last(), p)) {
+					polygon.removeLast();
+				}
+				polygon.append(p);
+			}
+			n = nodes.at(n).next;
+			if (n == loops.at(o).first) break;
+		}
+
+		while (polygon.count() >= 3 && polygon.last() == polygon.first()) {
+			polygon.removeLast();
+		}
+		while (polygon.count() >= 3 && sameDirection(polygon.at(polygon.count() - 2), polygon.last(), polygon.first())) {
+			polygon.removeLast();
+		}
+		while (polygon.count() >= 3 && sameDirection(polygon.last(), polygon.first(), polygon.at(1))) {
+			polygon.remove(0);
+		}
+
+		polygons.append(polygon);
+	}
+
+	return polygons;
+}
+
+void ScanLineTracer::scanLines(QImage & image, int bWidth, int bHeight, int minRunSize, int minRiseSize, QList<QRect> & rects)
+{
+	Q_ASSERT(image.format() == QImage::Format_Mono);
+//    Q_ASSERT(image.colorTable()[1] == 0xffffffff);
+
+	int index = 0;
+
+	if (minRiseSize > 1) {
+		for (int x = 0; x < bWidth; x++) {
+			bool inWhite = false;
+			int whiteStart = 0;
+			for (int y = 0; y < bHeight; y++) {
+				uchar * s = image.scanLine(y);
+				index = (*(s + (x >> 3)) >> (~x & 7)) & 1;
+
+				if (inWhite) {
+					if (index == 1) {
+						// another white pixel, keep moving
+						continue;
+					}
+
+					// got black: close up this segment;
+					inWhite = false;
+					if (y - whiteStart < minRiseSize) {
+						for (int j = whiteStart; j <= y; j++) {
+							uchar * r = image.scanLine(j);
+							*(r + (x >> 3)) &= ~(1 << (7-(x & 7)));  //image.setPixel(x, j, 0);
+						}
+						continue;
+					}
+
+				}
+				else {
+					if (index != 1) {
+						// another black pixel, keep moving
+						continue;
+					}
+
+					inWhite = true;
+					whiteStart = y;
+				}
+			}
+			if (inWhite) {
+				// close up the last segment
+				if (bHeight - whiteStart < minRiseSize) {
+					for (int j = whiteStart; j <= bHeight; j++) {
+						uchar * r = image.scanLine(j);
+						*(r + (x >> 3)) &= ~(1 << (7-(x & 7)));  //image.setPixel(x, j, 0);
+					}
+				}
+			}
+		}
+	}
+
+	for (int y = 0; y < bHeight; y++) {
+		uchar * s = image.scanLine(y);
+
+		bool inWhite = false;
+		int whiteStart = 0;
+
+		for (int x = 0; x < bWidth; x++) {
+			index = (*(s + (x >> 3)) >> (~x & 7)) & 1;
+
+			if (inWhite) {
+				if (index == 1) {
+					// another white pixel, keep moving
+					continue;
+				}
+
+				// got black: close up this segment;
+				inWhite = false;
+				if (x - whiteStart < minRunSize) {
+					// not a big enough section
+					continue;
+				}
+
+				rects.append(QRect(whiteStart, y, x - whiteStart, 1));
+			}
+			else {
+				if (index != 1) {		// qBlue(current) != 0xff
+					// another black pixel, keep moving
+					continue;
+				}
+
+				inWhite = true;
+				whiteStart = x;
+			}
+		}
+		if (inWhite) {
+			// close up the last segment
+			if (bWidth - whiteStart >= minRunSize) {
+				rects.append(QRect(whiteStart, y, bWidth - whiteStart, 1));
+			}
+		}
+	}
+}
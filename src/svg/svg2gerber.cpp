@@ -22,6 +22,7 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include "../debugdialog.h"
 #include "svgflattener.h"
 #include <QTextStream>
+#include <QIODevice>
 #include <QSettings>
 #include <QSet>
 #include <QtDebug>
@@ -73,7 +74,23 @@ int SVG2gerber::convert(const QString & svgStr, bool doubleSided, const QString
 }
 
 QString SVG2gerber::getGerber() {
-	return m_gerber_header + m_gerber_paths;
+	return m_gerber_header + QString::fromLatin1(m_gerber_paths.toByteArray());
+}
+
+bool SVG2gerber::writeGerber(QIODevice & device) {
+	QByteArray header = m_gerber_header.toLatin1();
+	if (device.write(header) != header.size()) return false;
+
+	return m_gerber_paths.writeTo(device);
+}
+
+void SVG2gerber::setSpooling(bool spooling) {
+	// call before convert()
+	m_gerber_paths.setSpooling(spooling);
+}
+
+qint64 SVG2gerber::peakBufferSize() const {
+	return m_gerber_header.size() + m_gerber_paths.peakBufferSize();
 }
 
 int SVG2gerber::renderGerber(bool doubleSided, const QString & mainLayerName, ForWhy forWhy) {
@@ -549,18 +566,18 @@ int SVG2gerber::allPaths2gerber(ForWhy forWhy) {
 
 		QString data = path.attribute("d").trimmed();
 
-		const char * slot = SLOT(path2gerbCommandSlot(QChar, bool, QList<double> &, void *));
-
 		PathUserData pathUserData;
 		pathUserData.x = 0;
 		pathUserData.y = 0;
 		pathUserData.pathStarting = true;
 		pathUserData.string = "";
 
+		// the commands are written to pathUserData.string, which is only added to the output below,
+		// since those before a parse error have already been visited
 		SvgFlattener flattener;
 		bool invalid = false;
 		try {
-			flattener.parsePath(data, slot, pathUserData, this, true);
+			invalid = !flattener.parsePath(data, &SVG2gerber::path2gerbCommand, this, pathUserData, true);
 		}
 		catch (const QString & msg) {
 			DebugDialog::debug("flattener.parsePath failed " + msg);
@@ -778,12 +795,10 @@ QString SVG2gerber::path2gerber(QDomElement pathElement) {
 	return d;
 }
 
-void SVG2gerber::path2gerbCommandSlot(QChar command, bool relative, QList<double> & args, void * userData) {
+void SVG2gerber::path2gerbCommand(QChar command, bool relative, const SVGPathArgs & args, PathUserData * pathUserData) {
 	QString gerb_path;
 	double x, y;
 
-	auto * pathUserData = (PathUserData *) userData;
-
 	if (command.toLatin1() == 'z' || command.toLatin1() == 'Z') {
 		gerb_path = "X" + f2gerber(m_pathstart_x) + "Y" + f2gerber(flipy(m_pathstart_y)) + "D01*\n";
 		gerb_path += "D02*\n";
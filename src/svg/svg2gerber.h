@@ -27,6 +27,11 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include <QTransform>
 #include <QMultiHash>
 
+#include "gerberwriter.h"
+#include "svgpathvisitor.h"
+
+struct PathUserData;
+
 class SVG2gerber : public QObject
 {
 	Q_OBJECT
@@ -46,11 +51,14 @@ public:
 
 	int convert(const QString & svgStr, bool doubleSided, const QString & mainLayerName, ForWhy, QSizeF boardSize);
 	QString getGerber();
+	bool writeGerber(class QIODevice &);
+	void setSpooling(bool);
+	qint64 peakBufferSize() const;
 
 protected:
 	QDomDocument m_SVGDom;
 	QString m_gerber_header;
-	QString m_gerber_paths;
+	GerberWriter m_gerber_paths;
 	QString m_drill_slots;
 	QSizeF m_boardSize;
 	QMultiHash<QString, QString> m_platedApertures;
@@ -89,10 +97,7 @@ protected:
 	void doPoly(QDomElement & polygon, ForWhy forWhy, bool closedCurve,
 	            QHash<QString, QString> & apertureMap, QString & current_dcode, int & dcode_index);
 
-
-
-protected Q_SLOTS:
-	void path2gerbCommandSlot(QChar command, bool relative, QList<double> & args, void * userData);
+	void path2gerbCommand(QChar command, bool relative, const SVGPathArgs & args, PathUserData * pathUserData);
 
 
 };
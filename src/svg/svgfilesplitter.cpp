@@ -23,23 +23,13 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include "../utils/misc.h"
 #include "../utils/textutils.h"
 #include "../debugdialog.h"
-#include "svgpathparser.h"
 #include "svgpathlexer.h"
-#include "svgpathrunner.h"
 
 #include <QDomDocument>
 #include <QFile>
 #include <QtDebug>
 #include <QXmlStreamReader>
 
-struct HVConvertData {
-	double x;
-	double y;
-	double subX;
-	double subY;
-	QString path;
-};
-
 void appendPair(QString & path, double a1, double a2) {
 	path.append(QString::number(a1));
 	path.append(',');
@@ -279,11 +269,13 @@ void SvgFileSplitter::painterPathChild(QDomElement & element, QPainterPath & ppa
 	else if (element.nodeName().compare("polygon") == 0 || element.nodeName().compare("polyline") == 0) {
 		QString data = element.attribute("points");
 		if (!data.isEmpty()) {
-			const char * slot = SLOT(painterPathCommandSlot(QChar, bool, QList<double> &, void *));
+			// the commands before a parse error have already been visited, so only keep the polygon if it all parsed
+			QPainterPath polygonPath;
 			PathUserData pathUserData;
 			pathUserData.pathStarting = true;
-			pathUserData.painterPath = &ppath;
-			if (parsePath(data, slot, pathUserData, this, false)) {
+			pathUserData.painterPath = &polygonPath;
+			if (parsePath(data, &SvgFileSplitter::painterPathCommand, this, pathUserData, false)) {
+				ppath.addPath(polygonPath);
 			}
 		}
 	}
@@ -291,14 +283,13 @@ void SvgFileSplitter::painterPathChild(QDomElement & element, QPainterPath & ppa
 		/*
 		QString data = element.attribute("d").trimmed();
 		if (!data.isEmpty()) {
-			const char * slot = SLOT(normalizeCommandSlot(QChar, bool, QList<double> &, void *));
 			PathUserData pathUserData;
 			pathUserData.pathStarting = true;
 			pathUserData.sNewHeight = sNewHeight;
 			pathUserData.sNewWidth = sNewWidth;
 			pathUserData.vbHeight = vbHeight;
 			pathUserData.vbWidth = vbWidth;
-		    if (parsePath(data, slot, pathUserData, this, true)) {
+		    if (parsePath(data, &SvgFileSplitter::normalizeCommand, this, pathUserData, true)) {
 				element.setAttribute("d", pathUserData.string);
 			}
 		}
@@ -397,14 +388,13 @@ void SvgFileSplitter::normalizeChild(QDomElement & element,
 		normalizeAttribute(element, "stroke-width", sNewWidth, vbWidth);
 		QString data = element.attribute("points");
 		if (!data.isEmpty()) {
-			const char * slot = SLOT(normalizeCommandSlot(QChar, bool, QList<double> &, void *));
 			PathUserData pathUserData;
 			pathUserData.pathStarting = true;
 			pathUserData.sNewHeight = sNewHeight;
 			pathUserData.sNewWidth = sNewWidth;
 			pathUserData.vbHeight = vbHeight;
 			pathUserData.vbWidth = vbWidth;
-			if (parsePath(data, slot, pathUserData, this, false)) {
+			if (parsePath(data, &SvgFileSplitter::normalizeCommand, this, pathUserData, false)) {
 				pathUserData.string.remove(0, 1);			// get rid of the "M"
 				element.setAttribute("points", pathUserData.string);
 			}
@@ -417,14 +407,13 @@ void SvgFileSplitter::normalizeChild(QDomElement & element,
 		setStrokeOrFill(element, blackOnly, "black", false);
 		QString data = element.attribute("d").trimmed();
 		if (!data.isEmpty()) {
-			const char * slot = SLOT(normalizeCommandSlot(QChar, bool, QList<double> &, void *));
 			PathUserData pathUserData;
 			pathUserData.pathStarting = true;
 			pathUserData.sNewHeight = sNewHeight;
 			pathUserData.sNewWidth = sNewWidth;
 			pathUserData.vbHeight = vbHeight;
 			pathUserData.vbWidth = vbWidth;
-			if (parsePath(data, slot, pathUserData, this, true)) {
+			if (parsePath(data, &SvgFileSplitter::normalizeCommand, this, pathUserData, true)) {
 				element.setAttribute("d", pathUserData.string);
 			}
 		}
@@ -642,12 +631,11 @@ void SvgFileSplitter::shiftChild(QDomElement & element, double x, double y, bool
 	else if (nodeName.compare("polygon") == 0 || nodeName.compare("polyline") == 0) {
 		QString data = element.attribute("points");
 		if (!data.isEmpty()) {
-			const char * slot = SLOT(shiftCommandSlot(QChar, bool, QList<double> &, void *));
 			PathUserData pathUserData;
 			pathUserData.pathStarting = true;
 			pathUserData.x = x;
 			pathUserData.y = y;
-			if (parsePath(data, slot, pathUserData, this, false)) {
+			if (parsePath(data, &SvgFileSplitter::shiftCommand, this, pathUserData, false)) {
 				pathUserData.string.remove(0, 1);			// get rid of the "M"
 				element.setAttribute("points", pathUserData.string);
 			}
@@ -656,12 +644,11 @@ void SvgFileSplitter::shiftChild(QDomElement & element, double x, double y, bool
 	else if (nodeName.compare("path") == 0) {
 		QString data = element.attribute("d").trimmed();
 		if (!data.isEmpty()) {
-			const char * slot = SLOT(shiftCommandSlot(QChar, bool, QList<double> &, void *));
 			PathUserData pathUserData;
 			pathUserData.pathStarting = true;
 			pathUserData.x = x;
 			pathUserData.y = y;
-			if (parsePath(data, slot, pathUserData, this, true)) {
+			if (parsePath(data, &SvgFileSplitter::shiftCommand, this, pathUserData, true)) {
 				element.setAttribute("d", pathUserData.string);
 			}
 		}
@@ -675,12 +662,10 @@ void SvgFileSplitter::shiftChild(QDomElement & element, double x, double y, bool
 	}
 }
 
-void SvgFileSplitter::normalizeCommandSlot(QChar command, bool relative, QList<double> & args, void * userData) {
+void SvgFileSplitter::normalizeCommand(QChar command, bool relative, const SVGPathArgs & args, PathUserData * pathUserData) {
 
 	Q_UNUSED(relative);			// just normalizing here, so relative is not used
 
-	auto * pathUserData = (PathUserData *) userData;
-
 	double d;
 	pathUserData->string.append(command);
 	switch(command.toLatin1()) {
@@ -751,12 +736,10 @@ void SvgFileSplitter::normalizeCommandSlot(QChar command, bool relative, QList<d
 	}
 }
 
-void SvgFileSplitter::painterPathCommandSlot(QChar command, bool relative, QList<double> & args, void * userData) {
+void SvgFileSplitter::painterPathCommand(QChar command, bool relative, const SVGPathArgs & args, PathUserData * pathUserData) {
 
 	Q_UNUSED(relative);			// just normalizing here, so relative is not used
-	Q_UNUSED(command)			// note: painterPathCommandSlot is only partially implemented
-
-	auto * pathUserData = (PathUserData *) userData;
+	Q_UNUSED(command)			// note: painterPathCommand is only partially implemented
 
 	double dx, dy;
 	for (int i = 0; i < args.count(); i += 2) {
@@ -774,12 +757,10 @@ void SvgFileSplitter::painterPathCommandSlot(QChar command, bool relative, QList
 
 }
 
-void SvgFileSplitter::shiftCommandSlot(QChar command, bool relative, QList<double> & args, void * userData) {
+void SvgFileSplitter::shiftCommand(QChar command, bool relative, const SVGPathArgs & args, PathUserData * pathUserData) {
 
 	Q_UNUSED(relative);			// just normalizing here, so relative is not used
 
-	auto * pathUserData = (PathUserData *) userData;
-
 	double d;
 	pathUserData->string.append(command);
 	switch(command.toLatin1()) {
@@ -843,7 +824,7 @@ void SvgFileSplitter::shiftCommandSlot(QChar command, bool relative, QList<doubl
 	}
 }
 
-void SvgFileSplitter::standardArgs(bool relative, bool starting, QList<double> & args, PathUserData * pathUserData) {
+void SvgFileSplitter::standardArgs(bool relative, bool starting, const SVGPathArgs & args, PathUserData * pathUserData) {
 	for (int i = 0; i < args.count(); i++) {
 		double d = args[i];
 		if (i % 2 == 0) {
@@ -863,56 +844,7 @@ void SvgFileSplitter::standardArgs(bool relative, bool starting, QList<double> &
 	}
 }
 
-QVector<QVariant> SvgFileSplitter::simpleParsePath(const QString & data) {
-	static QVector<QVariant> emptyStack;
-
-	QString dataCopy(data);
-
-	if (!dataCopy.startsWith('M', Qt::CaseInsensitive)) {
-		dataCopy.prepend('M');
-	}
-	while (dataCopy.at(dataCopy.length() - 1).isSpace()) {
-		dataCopy.remove(dataCopy.length() - 1, 1);
-	}
-	QChar last = dataCopy.at(dataCopy.length() - 1);
-	if (last != 'z' && last != 'Z' && last != SVGPathLexer::FakeClosePathChar) {
-		dataCopy.append(SVGPathLexer::FakeClosePathChar);
-	}
-
-	SVGPathLexer lexer(dataCopy);
-	SVGPathParser parser;
-	if (!parser.parse(lexer)) {
-		//DebugDialog::debug(QString("svg path parse failed %1").arg(dataCopy));
-		return emptyStack;
-	}
-
-	return parser.symStack();
-}
-
-
-bool SvgFileSplitter::parsePath(const QString & dataString, const char * slot, PathUserData & pathUserData, QObject * slotTarget, bool convertHV) {
-	QVector<QVariant> symStack = simpleParsePath(dataString);
-
-	if (convertHV && (dataString.contains("h", Qt::CaseInsensitive) || dataString.contains("v",  Qt::CaseInsensitive)))
-	{
-		SVGPathRunner svgPathRunner;
-		HVConvertData data;
-		data.x = data.y = data.subX = data.subY = 0;
-		data.path = "";
-		connect(&svgPathRunner, SIGNAL(commandSignal(QChar, bool, QList<double> &, void *)),
-		        this, SLOT(convertHVSlot(QChar, bool, QList<double> &, void *)),
-		        Qt::DirectConnection);
-		svgPathRunner.runPath(symStack, &data);
-		return parsePath(data.path, slot, pathUserData, slotTarget, false);
-	}
-
-	SVGPathRunner svgPathRunner;
-	connect(&svgPathRunner, SIGNAL(commandSignal(QChar, bool, QList<double> &, void *)), slotTarget, slot, Qt::DirectConnection);
-	return svgPathRunner.runPath(symStack, &pathUserData);
-}
-
-void SvgFileSplitter::convertHVSlot(QChar command, bool /* relative */, QList<double> & args, void * userData) {
-	auto * data = (HVConvertData *) userData;
+void SvgFileSplitter::convertHVCommand(QChar command, bool /* relative */, const SVGPathArgs & args, HVConvertData * data) {
 
 	switch(command.toLatin1()) {
 	case 'M':
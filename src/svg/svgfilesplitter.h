@@ -30,6 +30,8 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include <QPainterPath>
 #include <QFile>
 
+#include "svgpathvisitor.h"
+
 struct PathUserData {
 	QString string;
 	QTransform transform;
@@ -43,6 +45,14 @@ struct PathUserData {
 	QPainterPath * painterPath;
 };
 
+struct HVConvertData {
+	double x;
+	double y;
+	double subX;
+	double subY;
+	QString path;
+};
+
 class SvgFileSplitter : public QObject {
 	Q_OBJECT
 
@@ -55,8 +65,8 @@ public:
 	bool normalize(double dpi, const QString & elementID, bool blackOnly, double & factor);
 	QString shift(double x, double y, const QString & elementID, bool shiftTransforms);
 	QString elementString(const QString & elementID);
-	virtual bool parsePath(const QString & data, const char * slot, PathUserData &, QObject * slotTarget, bool convertHV);
-	QVector<QVariant> simpleParsePath(const QString & data);
+	template <class Target>
+	bool parsePath(const QString & data, void (Target::*command)(QChar, bool, const SVGPathArgs &, PathUserData *), Target * target, PathUserData &, bool convertHV);
 	QPainterPath painterPath(double dpi, const QString & elementID);			// note: only partially implemented
 	void shiftChild(QDomElement & element, double x, double y, bool shiftTransforms);
 	bool load(const QString * filename);
@@ -94,7 +104,7 @@ protected:
 	                          double sNewWidth, double sNewHeight,
 	                          double vbWidth, double vbHeight);
 	bool shiftTranslation(QDomElement & element, double x, double y);
-	void standardArgs(bool relative, bool starting, QList<double> & args, PathUserData * pathUserData);
+	void standardArgs(bool relative, bool starting, const SVGPathArgs & args, PathUserData * pathUserData);
 
 protected:
 	static bool shiftAttribute(QDomElement & element, const char * attributeName, double d);
@@ -102,12 +112,12 @@ protected:
 	static void hideTextAux(QDomElement & parent, bool hideChildren);
 	static void showTextAux(QDomElement & parent, bool & hasText, bool root);
 
-protected Q_SLOTS:
-	void normalizeCommandSlot(QChar command, bool relative, QList<double> & args, void * userData);
-	void shiftCommandSlot(QChar command, bool relative, QList<double> & args, void * userData);
-	virtual void rotateCommandSlot(QChar, bool, QList<double> &, void *) {}
-	void painterPathCommandSlot(QChar command, bool relative, QList<double> & args, void * userData);
-	void convertHVSlot(QChar command, bool relative, QList<double> & args, void * userData);
+protected:
+	void normalizeCommand(QChar command, bool relative, const SVGPathArgs & args, PathUserData * pathUserData);
+	void shiftCommand(QChar command, bool relative, const SVGPathArgs & args, PathUserData * pathUserData);
+	virtual void rotateCommand(QChar, bool, const SVGPathArgs &, PathUserData *) {}
+	void painterPathCommand(QChar command, bool relative, const SVGPathArgs & args, PathUserData * pathUserData);
+	void convertHVCommand(QChar command, bool relative, const SVGPathArgs & args, HVConvertData * data);
 
 protected:
 	QByteArray m_byteArray;
@@ -115,4 +125,33 @@ protected:
 
 };
 
+/**
+ * Parse svg path data and call command on target for each path command, with all of its arguments.
+ * @param data path data ("d" attribute) or polygon/polyline points
+ * @param command member function to call for each path command
+ * @param target object to call command on
+ * @param pathUserData state passed along to command
+ * @param convertHV convert 'H' and 'V' commands to 'L' (and 'h', 'v' to 'l') before parsing
+ * @return false if the path data could not be parsed
+ */
+template <class Target>
+bool SvgFileSplitter::parsePath(const QString & data, void (Target::*command)(QChar, bool, const SVGPathArgs &, PathUserData *), Target * target, PathUserData & pathUserData, bool convertHV) {
+	if (convertHV && (data.contains("h", Qt::CaseInsensitive) || data.contains("v", Qt::CaseInsensitive)))
+	{
+		HVConvertData hvData;
+		hvData.x = hvData.y = hvData.subX = hvData.subY = 0;
+		auto convert = [this, &hvData](QChar c, bool relative, const SVGPathArgs & args) {
+			convertHVCommand(c, relative, args, &hvData);
+		};
+		if (!SVGPathVisitor::visit(data, convert)) return false;
+
+		return parsePath(hvData.path, command, target, pathUserData, false);
+	}
+
+	auto visitor = [command, target, &pathUserData](QChar c, bool relative, const SVGPathArgs & args) {
+		(target->*command)(c, relative, args, &pathUserData);
+	};
+	return SVGPathVisitor::visit(data, visitor);
+}
+
 #endif
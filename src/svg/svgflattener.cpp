@@ -114,10 +114,9 @@ void SvgFlattener::unRotateChild(QDomElement & element, QTransform transform, co
 		if(tag == "path") {
 			QString data = element.attribute("d").trimmed();
 			if (!data.isEmpty()) {
-				const char * slot = SLOT(rotateCommandSlot(QChar, bool, QList<double> &, void *));
 				PathUserData pathUserData;
 				pathUserData.transform = transform;
-				if (parsePath(data, slot, pathUserData, this, true)) {
+				if (parsePath(data, &SvgFlattener::rotateCommand, this, pathUserData, true)) {
 					element.setAttribute("d", pathUserData.string);
 				}
 			}
@@ -125,10 +124,9 @@ void SvgFlattener::unRotateChild(QDomElement & element, QTransform transform, co
 		else if ((tag == "polygon") || (tag == "polyline")) {
 			QString data = element.attribute("points");
 			if (!data.isEmpty()) {
-				const char * slot = SLOT(rotateCommandSlot(QChar, bool, QList<double> &, void *));
 				PathUserData pathUserData;
 				pathUserData.transform = transform;
-				if (parsePath(data, slot, pathUserData, this, false)) {
+				if (parsePath(data, &SvgFlattener::rotateCommand, this, pathUserData, false)) {
 					pathUserData.string.remove(0, 1);			// get rid of the "M"
 					element.setAttribute("points", pathUserData.string);
 				}
@@ -228,12 +226,10 @@ bool SvgFlattener::hasOtherTransform(QDomElement & element)
 	return (!transform.contains("translate"));
 }
 
-void SvgFlattener::rotateCommandSlot(QChar command, bool relative, QList<double> & args, void * userData) {
+void SvgFlattener::rotateCommand(QChar command, bool relative, const SVGPathArgs & args, PathUserData * pathUserData) {
 
 	Q_UNUSED(relative);			// just normalizing here, so relative is not used
 
-	auto * pathUserData = (PathUserData *) userData;
-
 	pathUserData->string.append(command);
 	double x;
 	double y;
@@ -49,8 +49,8 @@ protected:
 	static bool loadDocIf(const QString & filename, const QString & svg, QDomDocument & domDocument);
 
 
-protected Q_SLOTS:
-	void rotateCommandSlot(QChar command, bool relative, QList<double> & args, void * userData);
+protected:
+	void rotateCommand(QChar command, bool relative, const SVGPathArgs & args, PathUserData * pathUserData) override;
 
 };
 
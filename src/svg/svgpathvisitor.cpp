@@ -0,0 +1,115 @@
+/*******************************************************************
+
+Part of the Fritzing project - http://fritzing.org
+Copyright (c) 2007-2019 Fritzing
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************/
+
+#include "svgpathvisitor.h"
+
+#include <QLocale>
+
+/**
+ * Number of arguments taken by one repetition of a path command
+ * @param command path command letter
+ * @return argument count, or -1 if command is not a path command
+ */
+int SVGPathVisitor::argCount(QChar command) noexcept
+{
+	switch (command.unicode()) {
+	case 'Z':
+	case 'z':
+		return 0;
+	case 'H':
+	case 'h':
+	case 'V':
+	case 'v':
+		return 1;
+	case 'M':
+	case 'm':
+	case 'L':
+	case 'l':
+	case 'T':
+	case 't':
+		return 2;
+	case 'S':
+	case 's':
+	case 'Q':
+	case 'q':
+		return 4;
+	case 'C':
+	case 'c':
+		return 6;
+	case 'A':
+	case 'a':
+		return 7;
+	default:
+		return -1;
+	}
+}
+
+void SVGPathVisitor::skipSeparators(const QChar *& pos, const QChar * end) noexcept
+{
+	while (pos != end && (pos->isSpace() || *pos == QLatin1Char(','))) {
+		++pos;
+	}
+}
+
+/**
+ * Read one number at pos, following the svg number grammar: an optional sign, digits with an
+ * optional decimal point, and an optional exponent. The number ends at the first character that
+ * can not continue it, so "1-2" and "1.5.5" are read as two numbers each.
+ * @param pos start of the number; advanced past it on success
+ * @param end end of the path data
+ * @param value the number read
+ * @return false if there is no number at pos
+ */
+bool SVGPathVisitor::readNumber(const QChar *& pos, const QChar * end, double & value)
+{
+	const QChar * p = pos;
+	if (p != end && (*p == QLatin1Char('-') || *p == QLatin1Char('+'))) ++p;
+
+	bool digits = false;
+	while (p != end && p->isDigit()) {
+		++p;
+		digits = true;
+	}
+	if (p != end && *p == QLatin1Char('.')) {
+		++p;
+		while (p != end && p->isDigit()) {
+			++p;
+			digits = true;
+		}
+	}
+	if (!digits) return false;
+
+	if (p != end && (*p == QLatin1Char('e') || *p == QLatin1Char('E'))) {
+		const QChar * exponent = p + 1;
+		if (exponent != end && (*exponent == QLatin1Char('-') || *exponent == QLatin1Char('+'))) ++exponent;
+		if (exponent != end && exponent->isDigit()) {
+			while (exponent != end && exponent->isDigit()) ++exponent;
+			p = exponent;
+		}
+	}
+
+	static const QLocale cLocale = QLocale::c();
+	bool ok = false;
+	value = cLocale.toDouble(QStringView(pos, p), &ok);
+	if (!ok) return false;
+
+	pos = p;
+	return true;
+}
@@ -0,0 +1,125 @@
+/*******************************************************************
+
+Part of the Fritzing project - http://fritzing.org
+Copyright (c) 2007-2019 Fritzing
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************/
+
+#ifndef SVGPATHVISITOR_H
+#define SVGPATHVISITOR_H
+
+#include <QChar>
+#include <QStringView>
+#include <QVarLengthArray>
+
+// read-only view of the arguments of one path command; only valid during the visitor call
+class SVGPathArgs
+{
+public:
+	SVGPathArgs(const double * args, int count) : m_args(args), m_count(count) {}
+
+	int count() const noexcept { return m_count; }
+	bool isEmpty() const noexcept { return m_count == 0; }
+	double operator[](int i) const noexcept { return m_args[i]; }
+
+protected:
+	const double * m_args;
+	int m_count;
+};
+
+/**
+ * Single pass tokenizer and parser for svg path data (the "d" attribute of a path, or the
+ * "points" attribute of a polygon or polyline).
+ *
+ * Each command is passed to the visitor together with all of its arguments, so implicit
+ * repetitions ("L1,2 3,4") arrive in one call. The visitor is any callable with the signature
+ *     void (QChar command, bool relative, const SVGPathArgs & args)
+ * Arguments are kept on the stack unless a single command has more than ArgsReserve of them.
+ *
+ * Data not starting with a moveto gets an implicit 'M' (polygon and polyline points), and
+ * SVGPathLexer::FakeClosePathChar is accepted as the end of the data.
+ */
+class SVGPathVisitor
+{
+public:
+	template <class Visitor>
+	static bool visit(QStringView data, Visitor & visitor);
+
+	static int argCount(QChar command) noexcept;
+	static bool readNumber(const QChar *& pos, const QChar * end, double & value);
+
+public:
+	static constexpr int ArgsReserve = 64;
+
+protected:
+	static void skipSeparators(const QChar *& pos, const QChar * end) noexcept;
+};
+
+template <class Visitor>
+bool SVGPathVisitor::visit(QStringView data, Visitor & visitor)
+{
+	QVarLengthArray<double, ArgsReserve> args;
+	const QChar * pos = data.begin();
+	const QChar * end = data.end();
+
+	skipSeparators(pos, end);
+	if (pos == end) return false;
+
+	QChar command('M');
+	if (*pos == QLatin1Char('M') || *pos == QLatin1Char('m')) {
+		command = *pos++;
+	}
+	int commandArgCount = argCount(command);
+
+	auto visitCommand = [&]() {
+		if (commandArgCount == 0) {
+			if (!args.isEmpty()) return false;
+		}
+		else if (args.isEmpty() || args.count() % commandArgCount != 0) return false;
+
+		visitor(command, command.isLower(), SVGPathArgs(args.constData(), args.count()));
+		args.clear();
+		return true;
+	};
+
+	while (true) {
+		skipSeparators(pos, end);
+		if (pos == end) break;
+
+		if (*pos == QLatin1Char('x')) {
+			// SVGPathLexer::FakeClosePathChar terminates the path data
+			skipSeparators(++pos, end);
+			if (pos != end) return false;
+			break;
+		}
+
+		int newArgCount = argCount(*pos);
+		if (newArgCount >= 0) {
+			if (!visitCommand()) return false;
+			command = *pos++;
+			commandArgCount = newArgCount;
+			continue;
+		}
+
+		double value;
+		if (!readNumber(pos, end, value)) return false;
+		args.append(value);
+	}
+
+	return visitCommand();
+}
+
+#endif // SVGPATHVISITOR_H
@@ -0,0 +1,129 @@
+/*******************************************************************
+
+Part of the Fritzing project - http://fritzing.org
+Copyright (c) 2007-2019 Fritzing
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************/
+
+#include "svgprefetch.h"
+#include "svgfilesplitter.h"
+#include "../model/modelpart.h"
+#include "../model/modelpartshared.h"
+#include "../items/partfactory.h"
+#include "../debugdialog.h"
+
+#include <QFile>
+#include <QFileInfo>
+#include <QtConcurrentRun>
+
+QHash<QString, QFuture<SvgPrefetch::LayerBytes> > SvgPrefetch::Futures;
+int SvgPrefetch::Prepared = 0;
+int SvgPrefetch::Hits = 0;
+int SvgPrefetch::Misses = 0;
+bool SvgPrefetch::Enabled = true;
+
+void SvgPrefetch::start(const QList<ModelPart *> & modelParts, const QList<ViewLayer::ViewID> & viewIDs) {
+	Prepared = Hits = Misses = 0;
+	if (!Enabled) return;
+
+	// queued view by view in the order the views are loaded, so the workers stay ahead of the gui thread
+	Q_FOREACH (ViewLayer::ViewID viewID, viewIDs) {
+		Q_FOREACH (ModelPart * modelPart, modelParts) {
+			ModelPartShared * modelPartShared = modelPart->modelPartShared();
+			if (modelPartShared == nullptr) continue;
+
+			bool multipleLayers = modelPartShared->hasMultipleLayers(viewID);
+			Q_FOREACH (ViewLayer::ViewLayerID viewLayerID, modelPartShared->viewLayers(viewID)) {
+				QString imageFilename = modelPartShared->imageFileName(viewID, viewLayerID);
+				if (imageFilename.isEmpty()) continue;
+
+				// don't generate svgs here; parts with generated svgs are loaded as before
+				QString filename = PartFactory::getSvgFilename(modelPart, imageFilename, false, false);
+				if (!QFileInfo::exists(filename)) continue;
+
+				QString k = key(filename, viewLayerID, multipleLayers);
+				if (Futures.contains(k)) continue;
+
+				Futures.insert(k, QtConcurrent::run(&SvgPrefetch::loadLayerBytes, filename, viewLayerID, multipleLayers));
+			}
+		}
+	}
+}
+
+void SvgPrefetch::finish() {
+	if (Futures.isEmpty()) return;
+
+	Prepared = Futures.count();
+	DebugDialog::debug(QString("svg prefetch: %1 layers prepared, %2 used, %3 loaded directly").arg(Futures.count()).arg(Hits).arg(Misses));
+	Futures.clear();
+}
+
+QByteArray SvgPrefetch::layerBytes(const QString & filename, ViewLayer::ViewLayerID viewLayerID, bool multipleLayers, bool & hasText) {
+	LayerBytes layerBytes;
+	auto future = Futures.constFind(key(filename, viewLayerID, multipleLayers));
+	if (future == Futures.constEnd()) {
+		Misses++;
+		layerBytes = loadLayerBytes(filename, viewLayerID, multipleLayers);
+	}
+	else {
+		Hits++;
+		layerBytes = future.value().result();
+	}
+
+	hasText = layerBytes.hasText;
+	return layerBytes.bytes;
+}
+
+SvgPrefetch::LayerBytes SvgPrefetch::loadLayerBytes(const QString & filename, ViewLayer::ViewLayerID viewLayerID, bool multipleLayers) {
+	// runs on worker threads: no gui objects and nothing from the model here
+	LayerBytes layerBytes;
+	if (viewLayerID == ViewLayer::Schematic) {
+		layerBytes.bytes = SvgFileSplitter::hideText(filename);
+	}
+	else if (viewLayerID == ViewLayer::SchematicText) {
+		layerBytes.hasText = false;
+		layerBytes.bytes = SvgFileSplitter::showText(filename, layerBytes.hasText);
+	}
+	else if (multipleLayers) {
+		// need to treat create "virtual" svg file for each layer
+		SvgFileSplitter svgFileSplitter;
+		if (svgFileSplitter.split(filename, ViewLayer::viewLayerXmlNameFromID(viewLayerID))) {
+			layerBytes.bytes = svgFileSplitter.byteArray();
+		}
+	}
+	else {
+		// only one layer, just load it directly
+		QFile file(filename);
+		file.open(QFile::ReadOnly);
+		layerBytes.bytes = file.readAll();
+	}
+
+	return layerBytes;
+}
+
+void SvgPrefetch::setEnabled(bool enabled) {
+	Enabled = enabled;
+}
+
+void SvgPrefetch::lastCounts(int & prepared, int & used, int & direct) {
+	prepared = Prepared;
+	used = Hits;
+	direct = Misses;
+}
+
+QString SvgPrefetch::key(const QString & filename, ViewLayer::ViewLayerID viewLayerID, bool multipleLayers) {
+	return QString("%1|%2|%3").arg(filename).arg(viewLayerID).arg(multipleLayers ? 1 : 0);
+}
@@ -0,0 +1,61 @@
+/*******************************************************************
+
+Part of the Fritzing project - http://fritzing.org
+Copyright (c) 2007-2019 Fritzing
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************/
+
+#ifndef SVGPREFETCH_H
+#define SVGPREFETCH_H
+
+#include <QByteArray>
+#include <QFuture>
+#include <QHash>
+#include <QList>
+#include <QString>
+
+#include "../viewlayer.h"
+
+// The svg of each part layer as ItemBase::setUpImage() loads it: read from disk, split out of
+// a multi-layer file, or with its schematic text hidden or shown. While a sketch is being loaded
+// these are prepared on worker threads, ahead of the items that need them.
+class SvgPrefetch
+{
+public:
+	static void start(const QList<class ModelPart *> &, const QList<ViewLayer::ViewID> &);
+	static void finish();
+	static QByteArray layerBytes(const QString & filename, ViewLayer::ViewLayerID, bool multipleLayers, bool & hasText);
+	static void setEnabled(bool);			// off loads every layer on the gui thread as before, to compare load times
+	static void lastCounts(int & prepared, int & used, int & direct);		// for the sketch loaded last
+
+protected:
+	struct LayerBytes {
+		QByteArray bytes;
+		bool hasText = true;
+	};
+
+	static LayerBytes loadLayerBytes(const QString & filename, ViewLayer::ViewLayerID, bool multipleLayers);
+	static QString key(const QString & filename, ViewLayer::ViewLayerID, bool multipleLayers);
+
+protected:
+	static QHash<QString, QFuture<LayerBytes> > Futures;		// only used from the gui thread
+	static int Prepared;
+	static int Hits;
+	static int Misses;
+	static bool Enabled;
+};
+
+#endif
@@ -0,0 +1,114 @@
+/*******************************************************************
+
+Part of the Fritzing project - http://fritzing.org
+Copyright (c) 2022 Fritzing GmbH
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************/
+
+#include "FProbeTiming.h"
+
+#include <QMap>
+#include <QMutexLocker>
+
+namespace {
+
+QMutex TimingsMutex;
+QMap<QString, FProbeTiming *> Timings;
+
+class FProbeTimings : public FProbe {
+public:
+	FProbeTimings() : FProbe("Timings") {}
+
+	QVariant read() {
+		QMutexLocker locker(&TimingsMutex);
+		QStringList lines;
+		Q_FOREACH (FProbeTiming * timing, Timings) {
+			lines << timing->name().c_str() + QString(" ") + timing->summary();
+		}
+		return lines.join("\n");
+	}
+
+	void write(QVariant data) {
+		QMutexLocker locker(&TimingsMutex);
+		Q_FOREACH (FProbeTiming * timing, Timings) {
+			timing->write(data);
+		}
+	}
+};
+
+}
+
+FProbeTiming::FProbeTiming(const QString & operation) :
+	FProbe("Timing" + operation.toStdString()),
+	m_operation(operation)
+{
+}
+
+/**
+ * The probe for operation; probes are created on first use and live until the application exits.
+ */
+FProbeTiming * FProbeTiming::probe(const QString & operation) {
+	QMutexLocker locker(&TimingsMutex);
+	static FProbeTimings * timings = new FProbeTimings();
+	Q_UNUSED(timings);
+
+	FProbeTiming * timing = Timings.value(operation, nullptr);
+	if (timing == nullptr) {
+		timing = new FProbeTiming(operation);
+		Timings.insert(operation, timing);
+	}
+	return timing;
+}
+
+void FProbeTiming::record(qint64 nsecs) {
+	QMutexLocker locker(&m_mutex);
+	m_calls++;
+	m_totalNsecs += nsecs;
+	m_lastNsecs = nsecs;
+	m_maxNsecs = qMax(m_maxNsecs, nsecs);
+}
+
+QString FProbeTiming::summary() {
+	QMutexLocker locker(&m_mutex);
+	return QString("%1 %2 %3 %4")
+	       .arg(m_calls)
+	       .arg(m_totalNsecs / 1e6, 0, 'f', 3)
+	       .arg(m_lastNsecs / 1e6, 0, 'f', 3)
+	       .arg(m_maxNsecs / 1e6, 0, 'f', 3);
+}
+
+QVariant FProbeTiming::read() {
+	return summary();
+}
+
+void FProbeTiming::write(QVariant data) {
+	Q_UNUSED(data);
+	QMutexLocker locker(&m_mutex);
+	m_calls = 0;
+	m_totalNsecs = m_lastNsecs = m_maxNsecs = 0;
+}
+
+////////////////////////////////////////////////////
+
+FProbeTimer::FProbeTimer(const QString & operation) :
+	m_probe(FProbeTiming::probe(operation))
+{
+	m_timer.start();
+}
+
+FProbeTimer::~FProbeTimer() {
+	m_probe->record(m_timer.nsecsElapsed());
+}
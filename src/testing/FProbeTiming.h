@@ -0,0 +1,73 @@
+/*******************************************************************
+
+Part of the Fritzing project - http://fritzing.org
+Copyright (c) 2022 Fritzing GmbH
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************/
+
+#ifndef FPROBETIMING_H
+#define FPROBETIMING_H
+
+#include "FProbe.h"
+
+#include <QElapsedTimer>
+#include <QMutex>
+#include <QVariant>
+
+/**
+ * Call count and wall time of one operation, readable through the FTesting server as
+ * "Timing<operation>". Reading returns "calls total_ms last_ms max_ms";
+ * writing anything resets the counters.
+ * The probe "Timings" reads all operations, one per line, and writing it resets all of them.
+ */
+class FProbeTiming : public FProbe {
+public:
+	static FProbeTiming * probe(const QString & operation);
+
+	void record(qint64 nsecs);
+	QString summary();
+
+	QVariant read();
+	void write(QVariant);
+
+protected:
+	FProbeTiming(const QString & operation);
+	~FProbeTiming() {};
+
+protected:
+	QString m_operation;
+	QMutex m_mutex;
+	quint64 m_calls = 0;
+	qint64 m_totalNsecs = 0;
+	qint64 m_lastNsecs = 0;
+	qint64 m_maxNsecs = 0;
+};
+
+/**
+ * Records the time from construction to destruction in an FProbeTiming:
+ *     FProbeTimer probeTimer("renderToSVG");
+ */
+class FProbeTimer {
+public:
+	FProbeTimer(const QString & operation);
+	~FProbeTimer();
+
+protected:
+	FProbeTiming * m_probe;
+	QElapsedTimer m_timer;
+};
+
+#endif
@@ -30,10 +30,8 @@ FTesting::FTesting() {
 }
 
 std::shared_ptr<FTesting> FTesting::getInstance() {
-    static std::shared_ptr<FTesting> instance;
-    if (!instance) {
-	    instance.reset(new FTesting);
-    }
+    // probes are created on first use, from any thread
+    static std::shared_ptr<FTesting> instance(new FTesting);
     return instance;
 }
 
@@ -48,21 +46,26 @@ void FTesting::init() {
 
 void FTesting::addProbe(FProbe * probe)
 {
+    QMutexLocker locker(&m_probeMapMutex);
     m_probeMap[probe->name()] = probe;
 }
 
 stdx::optional<QVariant> FTesting::readProbe(std::string name)
 {
-    if(m_probeMap.find(name) != m_probeMap.end()) {
-	return m_probeMap[name]->read();
+    QMutexLocker locker(&m_probeMapMutex);
+    auto it = m_probeMap.find(name);
+    if(it != m_probeMap.end()) {
+	return it->second->read();
     }
     return std::nullopt;
 }
 
 void FTesting::writeProbe(std::string name, QVariant param)
 {
-    if(m_probeMap.find(name) != m_probeMap.end()) {
-	m_probeMap[name]->write(param);
+    QMutexLocker locker(&m_probeMapMutex);
+    auto it = m_probeMap.find(name);
+    if(it != m_probeMap.end()) {
+	it->second->write(param);
     }
 }
 
@@ -28,7 +28,6 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 
 #include <boost/config.hpp>
 #include <boost/graph/transitive_closure.hpp>
-#include <boost/graph/prim_minimum_spanning_tree.hpp>
 // #include <boost/graph/kolmogorov_max_flow.hpp>  // kolmogorov_max_flow is probably more efficient, but it doesn't compile
 #include <boost/graph/edmonds_karp_max_flow.hpp>
 #include <boost/graph/adjacency_list.hpp>
@@ -39,6 +38,7 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #endif
 
 #include "graphutils.h"
+#include "spanningtree.h"
 #include "../fsvgrenderer.h"
 #include "../items/wire.h"
 #include "../items/jumperitem.h"
@@ -322,10 +322,6 @@ void GraphUtils::minCut(QList<ConnectorItem *> & connectorItems, QList<SketchWid
 
 
 bool GraphUtils::chooseRatsnestGraph(const QList<ConnectorItem *> * partConnectorItems, ViewGeometry::WireFlags flags, ConnectorPairHash & result) {
-	using namespace boost;
-	typedef adjacency_list < vecS, vecS, undirectedS, property<vertex_distance_t, double>, property < edge_weight_t, double > > Graph;
-	typedef std::pair < int, int >E;
-
 	if (partConnectorItems->count() < 2) return false;
 
 	QList <ConnectorItem *> temp(*partConnectorItems);
@@ -344,99 +340,47 @@ bool GraphUtils::chooseRatsnestGraph(const QList<ConnectorItem *> * partConnecto
 		}
 	}
 
+	int num_nodes = temp.count();
 	QList<QPointF> locs;
-	Q_FOREACH (ConnectorItem * connectorItem, temp) {
-		locs << connectorItem->sceneAdjustedTerminalPoint(nullptr);
+	QHash<ConnectorItem *, int> indexes;
+	for (int i = 0; i < num_nodes; i++) {
+		locs << temp.at(i)->sceneAdjustedTerminalPoint(nullptr);
+		indexes.insert(temp.at(i), i);
 	}
 
-	QList < QList<ConnectorItem *> > wiredTo;
-
-	int num_nodes = temp.count();
-	int num_edges = num_nodes * (num_nodes - 1) / 2;
-	E * edges = new E[num_edges];
-	auto * weights = new double[num_edges];
-	int ix = 0;
-	QVector< QVector<double> > reverseWeights(num_nodes, QVector<double>(num_nodes, 0));
+	// connectors already wired together, or bussed within a part, need no ratsnest between them
+	DisjointSets groups(num_nodes);
+	QHash<QPair<ItemBase *, Bus *>, int> buses;
+	QVector<bool> collected(num_nodes, false);
 	for (int i = 0; i < num_nodes; i++) {
 		ConnectorItem * c1 = temp.at(i);
-		//c1->debugInfo("c1");
-		for (int j = i + 1; j < num_nodes; j++) {
-			edges[ix].first = i;
-			edges[ix].second = j;
-			ConnectorItem * c2 = temp.at(j);
-			if ((c1->attachedTo() == c2->attachedTo()) && ((c1->bus()) != nullptr) && (c1->bus() == c2->bus())) {
-				weights[ix++] = 0;
-				continue;
-			}
-
-			bool already = false;
-			bool checkWiredTo = true;
-			Q_FOREACH (QList<ConnectorItem *> list, wiredTo) {
-				if (list.contains(c1)) {
-					checkWiredTo = false;
-					if (list.contains(c2)) {
-						weights[ix++] = 0;
-						already = true;
-					}
-					break;
-				}
-			}
-			if (already) continue;
-
-			//c2->debugInfo("\tc2");
-
-			if (checkWiredTo) {
-				QList<ConnectorItem *> cwConnectorItems;
-				cwConnectorItems.append(c1);
-				ConnectorItem::collectEqualPotential(cwConnectorItems, true, flags);
-				wiredTo.append(cwConnectorItems);
-				//foreach (ConnectorItem * cx, cwConnectorItems) {
-				//cx->debugInfo("\t\tcx");
-				//}
-				if (cwConnectorItems.contains(c2)) {
-					weights[ix++] = 0;
-					continue;
-				}
-			}
-
-			//DebugDialog::debug("c2 not eliminated");
-			double dx = locs[i].x() - locs[j].x();
-			double dy = locs[i].y() - locs[j].y();
-			weights[ix++] = reverseWeights[i][j] = reverseWeights[j][i] = (dx * dx) + (dy * dy);
+		if (c1->bus() != nullptr) {
+			QPair<ItemBase *, Bus *> key(c1->attachedTo(), c1->bus());
+			int j = buses.value(key, -1);
+			if (j < 0) buses.insert(key, i);
+			else groups.unite(i, j);
 		}
-	}
-
-	bool retval = false;
-	try {
-		Graph g(edges, edges + num_edges, weights, num_nodes);
-		// Warning: weightmap not used?
-//		property_map<Graph, edge_weight_t>::type weightmap = get(edge_weight, g);
 
-		std::vector < graph_traits < Graph >::vertex_descriptor > p(num_vertices(g));
+		if (collected.at(i)) continue;
 
-		prim_minimum_spanning_tree(g, &p[0]);
+		QList<ConnectorItem *> cwConnectorItems;
+		cwConnectorItems.append(c1);
+		ConnectorItem::collectEqualPotential(cwConnectorItems, true, flags);
+		Q_FOREACH (ConnectorItem * cx, cwConnectorItems) {
+			int j = indexes.value(cx, -1);
+			if (j < 0) continue;
 
-		for (std::size_t i = 0; i != p.size(); ++i) {
-			if (i == p[i]) continue;
-			if (reverseWeights[(int) i][(int) p[i]] == 0) continue;
-
-			result.insert(temp[(int) i], temp[(int) p[i]]);
+			collected[j] = true;
+			groups.unite(i, j);
 		}
-		retval = true;
-	}
-	catch ( const std::exception& e ) {
-		// catch an error in boost 1.54
-		DebugDialog::debug(QString("boost spanning tree failure: %1").arg(e.what()));
-	}
-	catch(...) {
-		DebugDialog::debug("boost spanning tree failure");
 	}
 
+	QList< QPair<int, int> > edges = SpanningTree::euclidean(locs, groups);
+	for (const QPair<int, int> & edge : edges) {
+		result.insert(temp.at(edge.first), temp.at(edge.second));
+	}
 
-	delete [] edges;
-	delete [] weights;
-
-	return retval;
+	return true;
 }
 
 #define add_edge_d(i, j, g) \
@@ -0,0 +1,153 @@
+/*******************************************************************
+
+Part of the Fritzing project - http://fritzing.org
+Copyright (c) 2007-2019 Fritzing
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************/
+
+#include "spanningtree.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+DisjointSets::DisjointSets(int count)
+	: m_parent(count, 0)
+	, m_rank(count, 0)
+	, m_sets(count)
+{
+	for (int i = 0; i < count; i++) {
+		m_parent[i] = i;
+	}
+}
+
+int DisjointSets::find(int i) {
+	while (m_parent[i] != i) {
+		m_parent[i] = m_parent[m_parent[i]];
+		i = m_parent[i];
+	}
+	return i;
+}
+
+bool DisjointSets::unite(int i, int j) {
+	i = find(i);
+	j = find(j);
+	if (i == j) return false;
+
+	if (m_rank[i] < m_rank[j]) std::swap(i, j);
+	m_parent[j] = i;
+	if (m_rank[i] == m_rank[j]) m_rank[i]++;
+	m_sets--;
+	return true;
+}
+
+namespace {
+
+constexpr int Cones = 8;
+
+struct CandidateEdge {
+	double weight;
+	int i;
+	int j;
+
+	bool operator<(const CandidateEdge & other) const {
+		return weight < other.weight;
+	}
+};
+
+int cone(double dx, double dy) {
+	int c = (int) ((std::atan2(dy, dx) + M_PI) * Cones / (2 * M_PI));
+	return qBound(0, c, Cones - 1);
+}
+
+// for each point, the nearest point from another group in each of eight 45 degree cones around it.
+// Any cut of the groups is crossed by one of these edges at minimum length, so the graph contains
+// a minimum spanning tree. Points are swept in x order; each sweep stops once the x distance
+// alone exceeds the best distance found in every cone on that side.
+void collectCandidates(const QList<QPointF> & locs, const QVector<int> & roots, const QVector<int> & order, std::vector<CandidateEdge> & edges)
+{
+	int count = order.count();
+	for (int r = 0; r < count; r++) {
+		int i = order.at(r);
+		const QPointF & p = locs.at(i);
+		double best[Cones];
+		int nearest[Cones];
+		for (int c = 0; c < Cones; c++) {
+			best[c] = std::numeric_limits<double>::infinity();
+			nearest[c] = -1;
+		}
+
+		// cones 2..5 face right, the others face left
+		auto visit = [&](int s, bool right) {
+			int j = order.at(s);
+			double dx = locs.at(j).x() - p.x();
+			double worst = 0;
+			for (int c = 0; c < Cones; c++) {
+				if ((c >= 2 && c <= 5) == right) worst = qMax(worst, best[c]);
+			}
+			if (dx * dx >= worst) return false;
+			if (roots.at(j) == roots.at(i)) return true;
+
+			double dy = locs.at(j).y() - p.y();
+			double d = (dx * dx) + (dy * dy);
+			int c = cone(dx, dy);
+			if (d < best[c]) {
+				best[c] = d;
+				nearest[c] = j;
+			}
+			return true;
+		};
+
+		for (int s = r + 1; s < count && visit(s, true); s++);
+		for (int s = r - 1; s >= 0 && visit(s, false); s--);
+
+		for (int c = 0; c < Cones; c++) {
+			if (nearest[c] >= 0) edges.push_back({ best[c], i, nearest[c] });
+		}
+	}
+}
+
+}
+
+QList< QPair<int, int> > SpanningTree::euclidean(const QList<QPointF> & locs, const DisjointSets & groups) {
+	QList< QPair<int, int> > result;
+	if (groups.count() <= 1) return result;
+
+	int count = locs.count();
+	DisjointSets sets(groups);
+	QVector<int> roots(count);
+	QVector<int> order(count);
+	for (int i = 0; i < count; i++) {
+		roots[i] = sets.find(i);
+		order[i] = i;
+	}
+	std::sort(order.begin(), order.end(), [&locs](int a, int b) { return locs.at(a).x() < locs.at(b).x(); });
+
+	std::vector<CandidateEdge> edges;
+	edges.reserve((size_t) count * Cones);
+	collectCandidates(locs, roots, order, edges);
+	std::sort(edges.begin(), edges.end());
+
+	for (const CandidateEdge & edge : edges) {
+		if (!sets.unite(edge.i, edge.j)) continue;
+
+		result.append(qMakePair(edge.i, edge.j));
+		if (sets.count() == 1) break;
+	}
+
+	return result;
+}
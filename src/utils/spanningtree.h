@@ -0,0 +1,54 @@
+/*******************************************************************
+
+Part of the Fritzing project - http://fritzing.org
+Copyright (c) 2007-2019 Fritzing
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************/
+
+#ifndef SPANNINGTREE_H
+#define SPANNINGTREE_H
+
+#include <QList>
+#include <QPair>
+#include <QPointF>
+#include <QVector>
+
+// union-find over the indexes 0..count-1, with path halving and union by rank
+class DisjointSets
+{
+public:
+	explicit DisjointSets(int count);
+
+	int find(int i);
+	bool unite(int i, int j);				// false if i and j were already in the same set
+	int count() const noexcept { return m_sets; }
+
+protected:
+	QVector<int> m_parent;
+	QVector<int> m_rank;
+	int m_sets = 0;
+};
+
+// minimum spanning tree over points in the plane, computed with Kruskal on a sparse
+// graph of each point's nearest neighbors (a Yao graph) rather than on the complete graph
+class SpanningTree
+{
+public:
+	// points in the same set of groups count as already connected; returns the new edges
+	static QList< QPair<int, int> > euclidean(const QList<QPointF> & locs, const DisjointSets & groups);
+};
+
+#endif
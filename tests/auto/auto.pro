@@ -1,3 +1,3 @@
 TEMPLATE = subdirs
 
-SUBDIRS = test_gerber test_svg test_textutils test_svg2gerber test_ngspice_simulator test_project_properties
+SUBDIRS = test_gerber test_svg test_textutils test_svg2gerber test_ngspice_simulator test_project_properties test_mazerouter_grid test_scanlinetracer
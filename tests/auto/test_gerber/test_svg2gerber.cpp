@@ -14,6 +14,7 @@ specifcation strings, and segments
 #include <boost/lexical_cast.hpp>
 #include <boost/test/unit_test.hpp>
 
+#include <QBuffer>
 #include <QFile>
 #include <QTextStream>
 
@@ -43,3 +44,44 @@ BOOST_AUTO_TEST_CASE( test_svg2gerber )
 	gerber3.convert(header + svgs[0], 2, "Silk1", SVG2gerber::ForSilk, QSizeF(3333.33, 2222.22));
 	BOOST_CHECK_EQUAL(gerber3.getGerber().toStdString(), gerbers[2].toStdString());
 }
+
+BOOST_AUTO_TEST_CASE( test_svg2gerber_spooling )
+{
+	// a large copper fill: many small filled squares, as produced by the ground fill
+	QString svg;
+	for (int i = 0; i < 20000; i++) {
+		double x = (i % 200) * 10.0;
+		double y = (i / 200) * 10.0;
+		svg += QString("<path fill='black' stroke='none' d='M%1,%2L%3,%2L%3,%4L%1,%4Z'/>\n")
+		       .arg(x).arg(y).arg(x + 5).arg(y + 5);
+	}
+	svg += "</svg>";
+
+	QString header = TextUtils::makeSVGHeader(1000, 1000, 2000, 1000);
+
+	SVG2gerber inMemory;
+	inMemory.convert(header + svg, 2, "Copper0", SVG2gerber::ForCopper, QSizeF(2000, 1000));
+	QBuffer inMemoryBuffer;
+	inMemoryBuffer.open(QIODevice::WriteOnly);
+	BOOST_REQUIRE(inMemory.writeGerber(inMemoryBuffer));
+
+	SVG2gerber spooled;
+	spooled.setSpooling(true);
+	spooled.convert(header + svg, 2, "Copper0", SVG2gerber::ForCopper, QSizeF(2000, 1000));
+	QBuffer spooledBuffer;
+	spooledBuffer.open(QIODevice::WriteOnly);
+	BOOST_REQUIRE(spooled.writeGerber(spooledBuffer));
+
+	// same output either way, and the same as the QString based getGerber()
+	BOOST_CHECK(inMemoryBuffer.data() == spooledBuffer.data());
+	BOOST_CHECK_EQUAL(QString::fromLatin1(spooledBuffer.data()).toStdString(), spooled.getGerber().toStdString());
+
+	qint64 outputSize = spooledBuffer.data().size();
+	BOOST_TEST_MESSAGE("gerber output " << outputSize << " bytes; held in memory: "
+	                   << inMemory.peakBufferSize() << " bytes unspooled, "
+	                   << spooled.peakBufferSize() << " bytes spooled (a QString would take "
+	                   << outputSize * 2 << " bytes)");
+	BOOST_CHECK(inMemory.peakBufferSize() >= outputSize);
+	BOOST_CHECK(spooled.peakBufferSize() < 2 * GerberWriter::ChunkSize);
+	BOOST_CHECK(spooled.peakBufferSize() < outputSize);
+}
@@ -0,0 +1,85 @@
+#define BOOST_TEST_MODULE MazeRouter Grid Tests
+#include <boost/test/included/unit_test.hpp>
+
+#include "autoroute/mazerouter/grid.h"
+
+#include <QRandomGenerator>
+#include <cstring>
+
+namespace {
+
+constexpr GridValue Obstacle = 7;
+
+// obstacle images are mostly white with scattered black runs, like a rendered board
+QImage makeImage(int width, int height, QRandomGenerator & random)
+{
+	QImage image(width, height, QImage::Format_Mono);
+	image.fill(0xffffffff);
+	int runs = random.bounded(width * height / 16 + 1);
+	for (int i = 0; i < runs; i++) {
+		int x = random.bounded(width);
+		int y = random.bounded(height);
+		int length = random.bounded(1, 40);
+		for (int j = x; j < qMin(width, x + length); j++) {
+			image.setPixel(j, y, 0);
+		}
+	}
+	return image;
+}
+
+// the pixel at a time transfer, to compare against
+QList<QPoint> referenceInit(Grid & grid, int sx, int sy, int sz, int width, int height, const QImage & image, int scale)
+{
+	QList<QPoint> points;
+	for (int iy = sy; iy < sy + height; iy++) {
+		for (int ix = sx; ix < sx + width; ix++) {
+			bool black = false;
+			for (int py = 0; py < scale; py++) {
+				for (int px = 0; px < scale; px++) {
+					if (image.pixelIndex((ix * scale) + px, (iy * scale) + py) == 0) black = true;
+				}
+			}
+			if (!black) continue;
+
+			grid.setAt(ix, iy, sz, Obstacle);
+			points.append(QPoint(ix, iy));
+		}
+	}
+	return points;
+}
+
+void compare(int scale)
+{
+	QRandomGenerator random(scale);
+	for (int trial = 0; trial < 200; trial++) {
+		int gx = random.bounded(1, 300);
+		int gy = random.bounded(1, 40);
+		QImage image = makeImage(gx * scale, gy * scale, random);
+		int sx = random.bounded(gx);
+		int sy = random.bounded(gy);
+		int width = random.bounded(1, gx - sx + 1);
+		int height = random.bounded(1, gy - sy + 1);
+
+		Grid grid(gx, gy, 2);
+		Grid reference(gx, gy, 2);
+		QList<QPoint> points = (scale == 4)
+			? grid.init4(sx, sy, 1, width, height, &image, Obstacle, true)
+			: grid.init(sx, sy, 1, width, height, image, Obstacle, true);
+		QList<QPoint> referencePoints = referenceInit(reference, sx, sy, 1, width, height, image, scale);
+
+		BOOST_REQUIRE(memcmp(grid.data, reference.data, gx * gy * 2 * sizeof(GridValue)) == 0);
+		BOOST_REQUIRE(points == referencePoints);
+	}
+}
+
+}
+
+BOOST_AUTO_TEST_CASE( test_init )
+{
+	compare(1);
+}
+
+BOOST_AUTO_TEST_CASE( test_init4 )
+{
+	compare(4);
+}
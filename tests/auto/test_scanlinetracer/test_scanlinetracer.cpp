@@ -0,0 +1,167 @@
+#define BOOST_TEST_MODULE ScanLineTracer Tests
+#include <boost/test/included/unit_test.hpp>
+
+#include "svg/scanlinetracer.h"
+
+#include <QRandomGenerator>
+#include <QStringList>
+
+namespace {
+
+// one string per row, '#' is a covered pixel
+QList<QRect> makeRuns(const QStringList & rows)
+{
+	QList<QRect> runs;
+	for (int y = 0; y < rows.count(); y++) {
+		const QString & row = rows.at(y);
+		int x = 0;
+		while (x < row.size()) {
+			if (row.at(x) != '#') {
+				x++;
+				continue;
+			}
+			int start = x;
+			while (x < row.size() && row.at(x) == '#') x++;
+			runs.append(QRect(start, y, x - start, 1));
+		}
+	}
+	return runs;
+}
+
+QVector<int> coverage(const QList<QRect> & runs, int width, int height)
+{
+	QVector<int> covered(width * height, 0);
+	for (const QRect & r : runs) {
+		for (int x = r.left(); x <= r.right(); x++) {
+			covered[r.y() * width + x] = 1;
+		}
+	}
+	return covered;
+}
+
+// the winding number of every pixel center; the polygons only have horizontal and vertical edges,
+// so a ray to the right only has to count the vertical ones
+QVector<int> winding(const QList<QPolygon> & polygons, int width, int height)
+{
+	QVector<int> windings(width * height, 0);
+	for (const QPolygon & polygon : polygons) {
+		for (int i = 0; i < polygon.count(); i++) {
+			QPoint p = polygon.at(i);
+			QPoint q = polygon.at((i + 1) % polygon.count());
+			BOOST_REQUIRE(p.x() == q.x() || p.y() == q.y());
+			if (p.x() != q.x()) continue;
+
+			int direction = (q.y() > p.y()) ? 1 : -1;
+			for (int y = qMin(p.y(), q.y()); y < qMax(p.y(), q.y()); y++) {
+				if (y < 0 || y >= height) continue;
+				for (int x = 0; x < qMin(p.x(), width); x++) {
+					windings[y * width + x] += direction;
+				}
+			}
+		}
+	}
+	return windings;
+}
+
+// under the nonzero rule the polygons cover exactly the runs, each covered pixel once
+void checkNonzero(const QList<QPolygon> & polygons, const QList<QRect> & runs, int width, int height)
+{
+	QVector<int> covered = coverage(runs, width, height);
+	QVector<int> windings = winding(polygons, width, height);
+	for (int i = 0; i < covered.count(); i++) {
+		BOOST_REQUIRE_EQUAL(qAbs(windings.at(i)), covered.at(i));
+	}
+}
+
+void check(const QStringList & rows, int pieces, int loops)
+{
+	int width = 0;
+	for (const QString & row : rows) {
+		width = qMax(width, int(row.size()));
+	}
+	QList<QRect> runs = makeRuns(rows);
+
+	QList<QPolygon> traced = ScanLineTracer::trace(runs);
+	BOOST_CHECK_EQUAL(traced.count(), pieces);
+	checkNonzero(traced, runs, width, rows.count());
+
+	QList<QPolygon> looped = ScanLineTracer::loops(runs);
+	BOOST_CHECK_EQUAL(looped.count(), loops);
+	checkNonzero(looped, runs, width, rows.count());
+}
+
+}
+
+BOOST_AUTO_TEST_CASE( test_island_in_hole )
+{
+	// an outline with a hole, an island in the hole, and a hole in the island
+	check(QStringList()
+		<< "#########"
+		<< "#.......#"
+		<< "#.#####.#"
+		<< "#.#...#.#"
+		<< "#.#.#.#.#"
+		<< "#.#...#.#"
+		<< "#.#####.#"
+		<< "#.......#"
+		<< "#########",
+		3, 5);
+}
+
+BOOST_AUTO_TEST_CASE( test_diagonal_pieces )
+{
+	// pieces that only touch at a corner are separate pieces
+	check(QStringList()
+		<< "##....."
+		<< "##....."
+		<< "..##..."
+		<< "..##..."
+		<< "....#.#"
+		<< ".....#.",
+		5, 5);
+}
+
+BOOST_AUTO_TEST_CASE( test_hole_touching_outline )
+{
+	// a hole touching a notch in the outline at a corner, and a hole touching another hole;
+	// the boundary turns right at such corners, keeping the covered pixels apart, so the first hole
+	// is walked as part of the outline and the other two make one loop
+	check(QStringList()
+		<< ".#######"
+		<< "#.######"
+		<< "######.#"
+		<< "#####.##"
+		<< "########",
+		1, 2);
+}
+
+BOOST_AUTO_TEST_CASE( test_random )
+{
+	QRandomGenerator random(48);
+	for (int trial = 0; trial < 200; trial++) {
+		int width = random.bounded(1, 60);
+		int height = random.bounded(1, 40);
+		int density = random.bounded(20, 80);
+		QImage image(width, height, QImage::Format_Mono);
+		image.fill(0);
+		for (int y = 0; y < height; y++) {
+			for (int x = 0; x < width; x++) {
+				if (random.bounded(100) < density) {
+					image.setPixel(x, y, 1);
+				}
+			}
+		}
+
+		QList<QRect> runs;
+		ScanLineTracer::scanLines(image, width, height, 1, 1, runs);
+		QVector<int> covered = coverage(runs, width, height);
+		for (int y = 0; y < height; y++) {
+			for (int x = 0; x < width; x++) {
+				BOOST_REQUIRE_EQUAL(covered.at(y * width + x), image.pixelIndex(x, y));
+			}
+		}
+
+		checkNonzero(ScanLineTracer::trace(runs), runs, width, height);
+		checkNonzero(ScanLineTracer::loops(runs), runs, width, height);
+	}
+}
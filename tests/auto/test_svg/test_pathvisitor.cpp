@@ -0,0 +1,131 @@
+#include "svg/svgpathvisitor.h"
+#include "svg/svgpathparser.h"
+#include "svg/svgpathlexer.h"
+
+/*
+Test that SVGPathVisitor produces the same commands and arguments as the
+SVGPathParser symbol stack, and compare the speed of both parsers
+*/
+
+#include <QElapsedTimer>
+
+#include <boost/test/unit_test.hpp>
+
+namespace {
+
+// Collect the visited commands in the same layout as SVGPathParser::symStack
+struct StackVisitor {
+	QList<QVariant> stack;
+
+	void operator()(QChar command, bool relative, const SVGPathArgs & args) {
+		BOOST_CHECK_EQUAL(relative, command.isLower());
+		stack.append(command);
+		for (int i = 0; i < args.count(); i++) {
+			stack.append(args[i]);
+		}
+	}
+};
+
+struct CountVisitor {
+	int commands = 0;
+	double sum = 0;
+
+	void operator()(QChar, bool, const SVGPathArgs & args) {
+		commands++;
+		for (int i = 0; i < args.count(); i++) {
+			sum += args[i];
+		}
+	}
+};
+
+}
+
+BOOST_AUTO_TEST_CASE( pathvisitor_matches_parser )
+{
+	const QStringList inputs = {
+		"m0,0x",
+		"m5,9.9x",
+		"m-3-9.7x",
+		"m0,0z",
+		"m1,-2a2.6,3.5,0,0,1,-5.2,0x",
+		"m3-2a2.6 3.5 0 0 1-5.2 0x",
+		"m-2+9.7x",
+		"M1.5.5L2e2,3E-1 4 5c1,2,3,4,5,6 1 2 3 4 5 6z",
+		"M 10 10 H 90 V 90 h -80 v -80 Z",
+		"M0,0 Q1,1 2,2 T3,3 S4,4 5,5x",
+	};
+
+	for (int inp = 0; inp < inputs.size(); ++inp) {
+		QString dataCopy(inputs.at(inp));
+		SVGPathLexer lexer(dataCopy);
+		SVGPathParser parser;
+		BOOST_REQUIRE(parser.parse(lexer));
+		QList<QVariant> expected = parser.symStack().toList();
+
+		StackVisitor visitor;
+		BOOST_CHECK_MESSAGE(SVGPathVisitor::visit(inputs.at(inp), visitor), "visit failed for input " << inp);
+		BOOST_CHECK_MESSAGE(visitor.stack == expected, "different commands or arguments for input " << inp);
+	}
+}
+
+BOOST_AUTO_TEST_CASE( pathvisitor_points )
+{
+	// polygon and polyline points get an implicit moveto
+	StackVisitor visitor;
+	BOOST_CHECK(SVGPathVisitor::visit(QString("1,2 3,4 5,6"), visitor));
+	QList<QVariant> expected = { QChar('M'), 1.0, 2.0, 3.0, 4.0, 5.0, 6.0 };
+	BOOST_CHECK(visitor.stack == expected);
+}
+
+BOOST_AUTO_TEST_CASE( pathvisitor_bad )
+{
+	const QStringList inputs = {
+		"",
+		"M",
+		"M1",
+		"M1,2L3",
+		"M1,2z3",
+		"M1,2 foo",
+		"M1,2x3",
+		"M1,2a1,2,3,4,5,6",
+	};
+
+	for (int inp = 0; inp < inputs.size(); ++inp) {
+		CountVisitor visitor;
+		BOOST_CHECK_MESSAGE(!SVGPathVisitor::visit(inputs.at(inp), visitor), "visit accepted bad input " << inp);
+	}
+}
+
+BOOST_AUTO_TEST_CASE( pathvisitor_benchmark )
+{
+	QString data = "M0,0";
+	for (int i = 0; i < 500; i++) {
+		data += QString("L%1,%2c1.5,-2.5,3,4.25,-5,6e-1a2.6 3.5 0 0 1-5.2 0").arg(i).arg(-i * 0.5);
+	}
+	data += "z";
+	const int runs = 50;
+
+	QElapsedTimer timer;
+	timer.start();
+	int parserSymbols = 0;
+	for (int run = 0; run < runs; run++) {
+		QString dataCopy(data);
+		SVGPathLexer lexer(dataCopy);
+		SVGPathParser parser;
+		BOOST_REQUIRE(parser.parse(lexer));
+		parserSymbols += parser.symStack().count();
+	}
+	qint64 parserTime = timer.nsecsElapsed();
+
+	timer.restart();
+	CountVisitor visitor;
+	for (int run = 0; run < runs; run++) {
+		BOOST_REQUIRE(SVGPathVisitor::visit(data, visitor));
+	}
+	qint64 visitorTime = timer.nsecsElapsed();
+
+	BOOST_CHECK_EQUAL(visitor.commands, runs * 1502);
+	BOOST_TEST_MESSAGE("path of " << data.length() << " chars, " << runs << " runs: "
+	                   << "SVGPathLexer/SVGPathParser " << parserTime / 1000 << " us (" << parserSymbols / runs << " symbols), "
+	                   << "SVGPathVisitor " << visitorTime / 1000 << " us");
+}
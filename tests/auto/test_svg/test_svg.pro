@@ -35,11 +35,13 @@ HEADERS += $$files(../../../src/svg/svgpathlexer.h)
 HEADERS += $$files(../../../src/utils/textutils.h)
 HEADERS += $$files(../../../src/svg/svgpathgrammar_p.h)
 HEADERS += $$files(../../../src/svg/svgpathparser.h)
+HEADERS += $$files(../../../src/svg/svgpathvisitor.h)
 
 SOURCES += $$files(../../../src/svg/svgtext.cpp)
 SOURCES += $$files(../../../src/svg/svgpathlexer.cpp)
 SOURCES += $$files(../../../src/svg/svgpathparser.cpp)
 SOURCES += $$files(../../../src/svg/svgpathgrammar.cpp)
+SOURCES += $$files(../../../src/svg/svgpathvisitor.cpp)
 SOURCES += $$files(../../../src/utils/textutils.cpp)
 #INCLUDEPATH += $$top_srcdir
 # unix:QMAKE_POST_LINK = $$PWD/generated/test_svg
@@ -10,21 +10,27 @@
 #include <QFile>
 
 /*
-Testing that svg2gerber path2gerbCommandSlot is not influenced by newlines and whitespace.
+Testing that svg2gerber path2gerbCommand is not influenced by newlines and whitespace.
 */
 
 #include <algorithm>
 
 #include <boost/lexical_cast.hpp>
 
+// Get access to protected members of class SVG2gerber for testing
+class SVG2gerberTest : public SVG2gerber {
+public:
+	using SVG2gerber::path2gerbCommand;
+};
+
 BOOST_AUTO_TEST_CASE( svg2gerber_parse )
 {
 	QString data1 = "M1495.5,1742.5L1504.5,1742.5 M195.5,1743.5L204.5,1743.5 M1495.5,1743.5L1504.5,1743.5 M195.5,1744.5L204.5,1744.5 M1495.5,1744.5L1504.5,1744.5 M195.5,1745.5L1504.5,1745.5 M195.5,1746.5L1504.5,1746.5 M195.5,1747.5L1504.5,1747.5 M195.5,1748.5L1504.5,1748.5 M195.5,1749.5L1504.5,1749.5 \nM195.5,1750.5L1504.5,1750.5 M195.5,1751.5L1504.5,1751.5";
 
 	QString data2 = "M1495.5,1742.5L1504.5,1742.5 M195.5,1743.5L204.5,1743.5 M1495.5,1743.5L1504.5,1743.5 M195.5,1744.5L204.5,1744.5 M1495.5,1744.5L1504.5,1744.5 M195.5,1745.5L1504.5,1745.5 M195.5,1746.5L1504.5,1746.5 M195.5,1747.5L1504.5,1747.5 M195.5,1748.5L1504.5,1748.5 M195.5,1749.5L1504.5,1749.5  M195.5,1750.5L1504.5,1750.5 M195.5,1751.5L1504.5,1751.5";
 
-	SVG2gerber svg2gerber;
-	const char * slot = SLOT(path2gerbCommandSlot(QChar, bool, QList<double> &, void *));
+	SVG2gerberTest svg2gerber;
+	SVG2gerber * target = &svg2gerber;
 	PathUserData pathUserData1;
 	pathUserData1.x = 0;
 	pathUserData1.y = 0;
@@ -39,8 +45,8 @@ BOOST_AUTO_TEST_CASE( svg2gerber_parse )
 
 	SvgFlattener flattener;
 	try {
-		flattener.parsePath(data1, slot, pathUserData1, &svg2gerber, true);
-		flattener.parsePath(data2, slot, pathUserData2, &svg2gerber, true);
+		flattener.parsePath(data1, &SVG2gerberTest::path2gerbCommand, target, pathUserData1, true);
+		flattener.parsePath(data2, &SVG2gerberTest::path2gerbCommand, target, pathUserData2, true);
 	}
 	catch (const QString & msg) {
 	}
@@ -50,3 +56,23 @@ BOOST_AUTO_TEST_CASE( svg2gerber_parse )
 	}
 	BOOST_CHECK_EQUAL(pathUserData1.string.toStdString(), pathUserData2.string.toStdString());
 }
+
+/*
+The commands before a parse error have already been visited when parsePath returns false,
+so callers must only use what was collected after checking the result.
+*/
+BOOST_AUTO_TEST_CASE( svg2gerber_parse_error )
+{
+	SVG2gerberTest svg2gerber;
+	SVG2gerber * target = &svg2gerber;
+	PathUserData pathUserData;
+	pathUserData.x = 0;
+	pathUserData.y = 0;
+	pathUserData.pathStarting = true;
+	pathUserData.string = "";
+
+	SvgFlattener flattener;
+	bool result = flattener.parsePath("M10,10L20,10L20,20 x 5", &SVG2gerberTest::path2gerbCommand, target, pathUserData, true);
+	BOOST_CHECK(!result);
+	BOOST_CHECK(!pathUserData.string.isEmpty());
+}
@@ -0,0 +1,156 @@
+/*******************************************************************
+
+Part of the Fritzing project - http://fritzing.org
+Copyright (c) 2019 Fritzing
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************/
+
+#include <QtTest>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QProcess>
+#include <QTemporaryDir>
+
+/*
+Autoroute the PCB view of bundled example sketches with the Fritzing executable in FRITZING_BINARY,
+using the headless batch service (-batch -outputs autoroute).  Each sketch is routed once with the
+sequential router, which retries with different net orderings, and once with negotiated congestion,
+undoing in between.  Reports per sketch, and summed, the nets routed, the vias added and the time.
+Sketches without exactly one board are skipped.
+
+On each routed board the traces are also stored in both undo layouts, the single AddWiresCommand
+and the five commands per trace used before, and the heap each takes (glibc only, -1 elsewhere)
+and the time to undo and redo it are reported.
+*/
+
+namespace {
+
+const int SketchCount = 20;
+
+}
+
+class BenchAutoroute : public QObject
+{
+	Q_OBJECT
+
+private Q_SLOTS:
+	void initTestCase();
+	void autorouteSketches();
+
+private:
+	QString m_binary;
+};
+
+void BenchAutoroute::initTestCase()
+{
+	m_binary = qEnvironmentVariable("FRITZING_BINARY");
+	if (m_binary.isEmpty() || !QFileInfo(m_binary).isExecutable()) {
+		QSKIP("set FRITZING_BINARY to a built Fritzing executable");
+	}
+}
+
+void BenchAutoroute::autorouteSketches()
+{
+	QTemporaryDir outputDir;
+	QVERIFY(outputDir.isValid());
+	QDir dir(SKETCHES_DIR);
+	const QStringList sketches = dir.entryList(QStringList("*.fzz"), QDir::Files, QDir::Size).mid(0, SketchCount);
+	for (const QString & sketch : sketches) {
+		QVERIFY(QFile::copy(dir.absoluteFilePath(sketch), outputDir.filePath(sketch)));
+	}
+
+	QProcessEnvironment environment = QProcessEnvironment::systemEnvironment();
+	environment.insert("QT_QPA_PLATFORM", "offscreen");
+
+	QBENCHMARK_ONCE {
+		QProcess process;
+		process.setProcessEnvironment(environment);
+		process.start(m_binary, QStringList() << "-batch" << outputDir.path() << "-outputs" << "autoroute");
+		QVERIFY(process.waitForFinished(60 * 60 * 1000));
+		QCOMPARE(process.exitStatus(), QProcess::NormalExit);
+	}
+
+	QFile file(QDir(outputDir.path()).absoluteFilePath("fritzing_batch.json"));
+	QVERIFY(file.open(QIODevice::ReadOnly));
+	QJsonObject summary = QJsonDocument::fromJson(file.readAll()).object();
+	QCOMPARE(summary["failed"].toInt(), 0);
+
+	static const QStringList Modes = { "orderings", "negotiated" };
+	static const QStringList Layouts = { "addWires", "perTrace" };
+	QMap<QString, QJsonObject> totals;
+	QMap<QString, QMap<QString, double> > undoTotals;		// mode -> layout + measure -> sum
+	int routedSketches = 0;
+	const QJsonArray files = summary["files"].toArray();
+	for (const QJsonValue & value : files) {
+		QJsonObject result = value.toObject();
+		QJsonObject autoroute = result["autoroute"].toObject();
+		if (autoroute.isEmpty() || autoroute["orderings"].toObject().contains("skipped")) continue;
+
+		routedSketches++;
+		QString line = QFileInfo(result["file"].toString()).fileName();
+		for (const QString & mode : Modes) {
+			QJsonObject routing = autoroute[mode].toObject();
+			QJsonObject & total = totals[mode];
+			for (const QString & key : QStringList { "nets", "routed", "vias", "time" }) {
+				total[key] = total[key].toVariant().toLongLong() + routing[key].toVariant().toLongLong();
+			}
+			line += QString("  %1: %2/%3 routed, %4 vias, %5 ms").arg(mode)
+				.arg(routing["routed"].toInt()).arg(routing["nets"].toInt())
+				.arg(routing["vias"].toInt()).arg(routing["time"].toVariant().toLongLong());
+
+			QJsonObject undo = routing["undo"].toObject();
+			QMap<QString, double> & undoTotal = undoTotals[mode];
+			undoTotal["traces"] += undo["traces"].toDouble();
+			for (const QString & layout : Layouts) {
+				QJsonObject measures = undo[layout].toObject();
+				for (const QString & key : QStringList { "bytes", "undo", "redo" }) {
+					undoTotal[layout + key] += measures[key].toDouble();
+				}
+			}
+		}
+		qInfo("%s", qPrintable(line));
+
+		QJsonObject undo = autoroute["orderings"].toObject()["undo"].toObject();
+		line = QString("  undo of %1 traces, %2 connections:").arg(undo["traces"].toInt()).arg(undo["connections"].toInt());
+		for (const QString & layout : Layouts) {
+			QJsonObject measures = undo[layout].toObject();
+			line += QString("  %1: %2 bytes, undo %3 ms, redo %4 ms").arg(layout)
+				.arg(measures["bytes"].toVariant().toLongLong())
+				.arg(measures["undo"].toDouble(), 0, 'f', 1).arg(measures["redo"].toDouble(), 0, 'f', 1);
+		}
+		qInfo("%s", qPrintable(line));
+	}
+	QCOMPARE(files.count(), sketches.count());
+
+	qInfo("%d sketches routed", routedSketches);
+	for (const QString & mode : Modes) {
+		const QJsonObject & total = totals[mode];
+		qInfo("%s: %lld/%lld routed, %lld vias, %lld ms", qPrintable(mode),
+		      total["routed"].toVariant().toLongLong(), total["nets"].toVariant().toLongLong(),
+		      total["vias"].toVariant().toLongLong(), total["time"].toVariant().toLongLong());
+
+		const QMap<QString, double> & undoTotal = undoTotals[mode];
+		for (const QString & layout : Layouts) {
+			qInfo("%s undo of %.0f traces, %s: %.0f bytes, undo %.1f ms, redo %.1f ms", qPrintable(mode),
+			      undoTotal.value("traces"), qPrintable(layout), undoTotal.value(layout + "bytes"),
+			      undoTotal.value(layout + "undo"), undoTotal.value(layout + "redo"));
+		}
+	}
+}
+
+QTEST_GUILESS_MAIN(BenchAutoroute)
+#include "bench_autoroute.moc"
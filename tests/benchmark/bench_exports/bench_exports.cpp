@@ -0,0 +1,120 @@
+/*******************************************************************
+
+Part of the Fritzing project - http://fritzing.org
+Copyright (c) 2019 Fritzing
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************/
+
+#include <QtTest>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QProcess>
+#include <QTemporaryDir>
+
+/*
+Export the largest bundled example sketches with the Fritzing executable in FRITZING_BINARY,
+using the headless batch service (-batch), once with only the exporters that trace nets
+(bom, netlist, ipc) and once with every output.  Reports the time each output took, summed over
+the sketches, and how often the exporters shared a cached connectivity graph.
+*/
+
+namespace {
+
+const int SketchCount = 10;
+
+}
+
+class BenchExports : public QObject
+{
+	Q_OBJECT
+
+private Q_SLOTS:
+	void initTestCase();
+	void exportSketches_data();
+	void exportSketches();
+
+private:
+	QString m_binary;
+};
+
+void BenchExports::initTestCase()
+{
+	m_binary = qEnvironmentVariable("FRITZING_BINARY");
+	if (m_binary.isEmpty() || !QFileInfo(m_binary).isExecutable()) {
+		QSKIP("set FRITZING_BINARY to a built Fritzing executable");
+	}
+}
+
+void BenchExports::exportSketches_data()
+{
+	QTest::addColumn<QString>("outputs");
+
+	QTest::newRow("nets") << "bom,netlist,ipc";
+	QTest::newRow("all") << "gerber,svg,bom,netlist,ipc";
+}
+
+void BenchExports::exportSketches()
+{
+	QFETCH(QString, outputs);
+
+	QTemporaryDir outputDir;
+	QVERIFY(outputDir.isValid());
+	QDir dir(SKETCHES_DIR);
+	const QStringList sketches = dir.entryList(QStringList("*.fzz"), QDir::Files, QDir::Size).mid(0, SketchCount);
+	for (const QString & sketch : sketches) {
+		QVERIFY(QFile::copy(dir.absoluteFilePath(sketch), outputDir.filePath(sketch)));
+	}
+
+	QProcessEnvironment environment = QProcessEnvironment::systemEnvironment();
+	environment.insert("QT_QPA_PLATFORM", "offscreen");
+
+	QBENCHMARK_ONCE {
+		QProcess process;
+		process.setProcessEnvironment(environment);
+		process.start(m_binary, QStringList() << "-batch" << outputDir.path() << "-outputs" << outputs);
+		QVERIFY(process.waitForFinished(10 * 60 * 1000));
+		QCOMPARE(process.exitStatus(), QProcess::NormalExit);
+	}
+
+	QFile file(QDir(outputDir.path()).absoluteFilePath("fritzing_batch.json"));
+	QVERIFY(file.open(QIODevice::ReadOnly));
+	QJsonObject summary = QJsonDocument::fromJson(file.readAll()).object();
+	QCOMPARE(summary["failed"].toInt(), 0);
+
+	QMap<QString, qint64> times;
+	int hits = 0;
+	int misses = 0;
+	const QJsonArray files = summary["files"].toArray();
+	for (const QJsonValue & value : files) {
+		QJsonObject result = value.toObject();
+		QJsonObject timings = result["timings"].toObject();
+		for (const QString & key : timings.keys()) {
+			times[key] += timings[key].toVariant().toLongLong();
+		}
+		hits += result["netlistCacheHits"].toInt();
+		misses += result["netlistCacheMisses"].toInt();
+	}
+	QCOMPARE(files.count(), sketches.count());
+
+	for (const QString & key : times.keys()) {
+		qInfo("%s: %lld ms", qPrintable(key), times.value(key));
+	}
+	qInfo("netlist cache: %d hits, %d misses", hits, misses);
+}
+
+QTEST_GUILESS_MAIN(BenchExports)
+#include "bench_exports.moc"
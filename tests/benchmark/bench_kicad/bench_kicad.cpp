@@ -0,0 +1,130 @@
+/*******************************************************************
+
+Part of the Fritzing project - http://fritzing.org
+Copyright (c) 2019 Fritzing
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************/
+
+#include <QtTest>
+#include <QProcess>
+#include <QTemporaryDir>
+
+/*
+Convert a synthetic KiCad footprint library with a growing number of modules with the Fritzing
+executable in FRITZING_BINARY, using the headless footprint conversion service (-kicad),
+which writes one svg per module.
+*/
+
+namespace {
+
+// dual inline packages with a silkscreen outline and a pad per pin
+QString makeLibrary(int modules)
+{
+	QString index;
+	QString body;
+	for (int m = 0; m < modules; m++) {
+		int pins = 8 + (m % 16) * 2;
+		QString name = QString("DIP-%1_%2").arg(pins).arg(m);
+		index += name + "\n";
+
+		int length = (pins / 2) * 1000;
+		body += QString("$MODULE %1\n").arg(name);
+		body += "Po 0 0 0 15 00000000 00000000 ~~\n";
+		body += QString("Li %1\n").arg(name);
+		body += QString("Cd %1 pins DIL package\n").arg(pins);
+		body += "Kw DIL\n";
+		body += "Sc 0\nAR\nOp 0 0 0\n";
+		body += QString("T0 0 -2000 500 500 0 100 N V 21 N \"%1\"\n").arg(name);
+		body += "T1 0 2000 500 500 0 100 N V 21 N \"VAL**\"\n";
+		body += QString("DS %1 -1000 %2 -1000 150 21\n").arg(-length / 2).arg(length / 2);
+		body += QString("DS %1 1000 %2 1000 150 21\n").arg(-length / 2).arg(length / 2);
+		body += QString("DC %1 0 %2 250 150 21\n").arg(-length / 2).arg(-length / 2 + 250);
+		for (int p = 0; p < pins; p++) {
+			int x = -length / 2 + 500 + (p % (pins / 2)) * 1000;
+			int y = p < pins / 2 ? 1500 : -1500;
+			body += "$PAD\n";
+			body += QString("Sh \"%1\" %2 600 600 0 0 0\n").arg(p + 1).arg(p == 0 ? "R" : "C");
+			body += "Dr 320 0 0\n";
+			body += "At STD N 00E0FFFF\n";
+			body += "Ne 0 \"\"\n";
+			body += QString("Po %1 %2\n").arg(x).arg(y);
+			body += "$EndPAD\n";
+		}
+		body += QString("$EndMODULE %1\n").arg(name);
+	}
+
+	return "PCBNEW-LibModule-V1  01/01/2019 00:00:00\n# encoding utf-8\nUnits deci-mils\n$INDEX\n" + index + "$EndINDEX\n" + body + "$EndLIBRARY\n";
+}
+
+}
+
+class BenchKicad : public QObject
+{
+	Q_OBJECT
+
+private Q_SLOTS:
+	void initTestCase();
+	void convertLibrary_data();
+	void convertLibrary();
+
+private:
+	QString m_binary;
+};
+
+void BenchKicad::initTestCase()
+{
+	m_binary = qEnvironmentVariable("FRITZING_BINARY");
+	if (m_binary.isEmpty() || !QFileInfo(m_binary).isExecutable()) {
+		QSKIP("set FRITZING_BINARY to a built Fritzing executable");
+	}
+}
+
+void BenchKicad::convertLibrary_data()
+{
+	QTest::addColumn<int>("modules");
+	QTest::newRow("100") << 100;
+	QTest::newRow("1000") << 1000;
+	QTest::newRow("5000") << 5000;
+}
+
+void BenchKicad::convertLibrary()
+{
+	QFETCH(int, modules);
+
+	QTemporaryDir outputDir;
+	QVERIFY(outputDir.isValid());
+	QFile file(outputDir.filePath("bench.mod"));
+	QVERIFY(file.open(QIODevice::WriteOnly));
+	file.write(makeLibrary(modules).toUtf8());
+	file.close();
+
+	QProcessEnvironment environment = QProcessEnvironment::systemEnvironment();
+	environment.insert("QT_QPA_PLATFORM", "offscreen");
+
+	QBENCHMARK_ONCE {
+		QProcess process;
+		process.setProcessEnvironment(environment);
+		process.start(m_binary, QStringList() << "-kicad" << outputDir.path());
+		QVERIFY(process.waitForFinished(10 * 60 * 1000));
+		QCOMPARE(process.exitStatus(), QProcess::NormalExit);
+	}
+
+	QDir dir(outputDir.path());
+	QCOMPARE(dir.entryList(QStringList("*_bench.svg"), QDir::Files).count(), modules);
+}
+
+QTEST_GUILESS_MAIN(BenchKicad)
+#include "bench_kicad.moc"
@@ -0,0 +1,163 @@
+/*******************************************************************
+
+Part of the Fritzing project - http://fritzing.org
+Copyright (c) 2019 Fritzing
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************/
+
+#include "svg/bitmaptracer.h"
+#include "svg/scanlinetracer.h"
+
+#include <QtTest>
+#include <QPainter>
+#include <QPainterPath>
+#include <QSvgRenderer>
+
+/*
+Trace raster logos the way LogoItem imports them, from a couple of bundled images scaled up
+and a synthetic image of filled shapes.  Reports the size of the traced svg against the pixel
+polygons the ground fill tracer would write, and renders the svg back to check it still
+covers the same pixels.  The traced svg must be plain polygons, which gerber export keeps as vectors.
+*/
+
+namespace {
+
+QImage toMono(const QImage & source, int width)
+{
+	QImage image(source.size(), QImage::Format_ARGB32);
+	image.fill(Qt::white);
+	QPainter painter(&image);
+	painter.drawImage(0, 0, source);
+	painter.end();
+
+	image = image.scaledToWidth(width, Qt::SmoothTransformation);
+	return image.convertToFormat(QImage::Format_Mono, Qt::MonoOnly | Qt::ThresholdDither);
+}
+
+QImage makeShapes(int size)
+{
+	QImage image(size, size, QImage::Format_ARGB32);
+	image.fill(Qt::white);
+	QPainter painter(&image);
+	painter.setRenderHint(QPainter::Antialiasing);
+	painter.setPen(Qt::NoPen);
+	painter.setBrush(Qt::black);
+	for (int i = 0; i < 8; i++) {
+		double x = (i % 4) * size / 4.0;
+		double y = (i / 4) * size / 4.0;
+		double d = size / 5.0;
+		QPainterPath path;
+		path.addEllipse(x + 10, y + 10, d, d);
+		path.addEllipse(x + 10 + d / 4, y + 10 + d / 4, d / 2, d / 2);
+		path.addRect(x + 10, y + size / 2.0, d, d / 3);
+		painter.drawPath(path);
+	}
+	painter.setBrush(Qt::NoBrush);
+	for (int i = 0; i < 20; i++) {
+		painter.setPen(QPen(Qt::black, 2 + i % 6));
+		painter.drawLine(QPointF(0, size * 0.75 + i * 10), QPointF(size, size * 0.8 + i * 5));
+	}
+	painter.end();
+
+	return image.convertToFormat(QImage::Format_Mono, Qt::MonoOnly | Qt::ThresholdDither);
+}
+
+// the svg as GroundPlaneGenerator::makeOnePoly would write the pixel outlines
+int polygonSvgSize(const QList<QRect> & runs)
+{
+	int size = 0;
+	Q_FOREACH (QPolygon polygon, ScanLineTracer::trace(runs)) {
+		size += QString("<polygon fill='#000000' stroke='none' stroke-width='0' points='\n'/>\n").length();
+		Q_FOREACH (QPoint p, polygon) {
+			size += QString("%1,%2 ").arg(p.x()).arg(p.y()).length();
+		}
+	}
+	return size;
+}
+
+bool isSet(const QImage & image, int x, int y)
+{
+	return (*(image.constScanLine(y) + (x >> 3)) >> (~x & 7)) & 1;
+}
+
+}
+
+class BenchLogo : public QObject
+{
+	Q_OBJECT
+
+private Q_SLOTS:
+	void traceLogo_data();
+	void traceLogo();
+};
+
+void BenchLogo::traceLogo_data()
+{
+	QTest::addColumn<QImage>("image");
+
+	QImage fritzing(QString(IMAGES_DIR) + "/AboutBoxLogoShield.png");
+	QImage aisler(QString(IMAGES_DIR) + "/icons/aisler_donut-cloud_logo_icon.png");
+	QVERIFY(!fritzing.isNull());
+	QVERIFY(!aisler.isNull());
+
+	Q_FOREACH (int width, QList<int>() << 500 << 1000 << 2000) {
+		QTest::newRow(qPrintable(QString("fritzing %1").arg(width))) << toMono(fritzing, width);
+		QTest::newRow(qPrintable(QString("aisler %1").arg(width))) << toMono(aisler, width);
+	}
+	QTest::newRow("shapes 2000") << makeShapes(2000);
+}
+
+void BenchLogo::traceLogo()
+{
+	QFETCH(QImage, image);
+	QString svg;
+
+	QBENCHMARK {
+		svg = BitmapTracer::traceSvg(image, 1000, "#000000", "silkscreen");
+	}
+
+	QList<QRect> runs = BitmapTracer::runs(image);
+	qInfo("%d runs, pixel polygons %d bytes, traced svg %d bytes", runs.count(), polygonSvgSize(runs), svg.toUtf8().size());
+	QVERIFY(!svg.isEmpty());
+	QVERIFY(svg.toUtf8().size() < polygonSvgSize(runs));
+	QVERIFY(!svg.contains("<path"));
+	QCOMPARE(svg.count("<polygon"), BitmapTracer::polygons(runs).count());
+
+	// render the svg back over the image and count the pixels that came out differently
+	QSvgRenderer renderer(svg.toUtf8());
+	QVERIFY(renderer.isValid());
+	QImage rendered(image.size(), QImage::Format_ARGB32);
+	rendered.fill(Qt::white);
+	QPainter painter(&rendered);
+	renderer.render(&painter, QRectF(QPointF(0, 0), image.size()));
+	painter.end();
+
+	int set = 0;
+	int mismatched = 0;
+	for (int y = 0; y < image.height(); y++) {
+		for (int x = 0; x < image.width(); x++) {
+			bool inImage = isSet(image, x, y);
+			bool inSvg = qGray(rendered.pixel(x, y)) < 128;
+			if (inImage) set++;
+			if (inImage != inSvg) mismatched++;
+		}
+	}
+	qInfo("%d of %d set pixels differ", mismatched, set);
+	QVERIFY(mismatched < set / 20);
+}
+
+QTEST_GUILESS_MAIN(BenchLogo)
+#include "bench_logo.moc"
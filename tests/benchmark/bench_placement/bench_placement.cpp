@@ -0,0 +1,142 @@
+/*******************************************************************
+
+Part of the Fritzing project - http://fritzing.org
+Copyright (c) 2019 Fritzing
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************/
+
+#include "autoroute/autoplacer.h"
+
+#include <QtTest>
+#include <QRandomGenerator>
+#include <QThread>
+
+#include <cmath>
+
+/*
+Auto-placement of a synthetic board with a growing number of parts: parts of a few footprint
+sizes, wired to their neighbors in a grid plus a power and a ground net, dropped in a
+pile beside the board the way parts arrive from breadboard view.
+*/
+
+namespace {
+
+constexpr double Pitch = 90;
+
+void makeBoard(int count, QRectF & area, QList<AutoPlacer::Part> & parts, QList<AutoPlacer::Net> & nets)
+{
+	QRandomGenerator random(count);
+	int columns = qMax(1, (int) std::ceil(std::sqrt((double) count)));
+	area = QRectF(0, 0, columns * Pitch * 1.5, ((count + columns - 1) / columns) * Pitch * 1.5);
+
+	for (int i = 0; i < count; i++) {
+		AutoPlacer::Part part;
+		part.size = QSizeF(30 + (i % 3) * 20, 30 + (i % 2) * 30);
+		part.center = QPointF(-Pitch - random.bounded(Pitch * 2), random.bounded(area.height()));
+		parts << part;
+	}
+
+	AutoPlacer::Net power;
+	AutoPlacer::Net ground;
+	for (int i = 0; i < count; i++) {
+		AutoPlacer::Pin pin;
+		pin.part = i;
+		pin.offset = QPointF(-10, 0);
+		int right = i + 1;
+		int below = i + columns;
+		QList<int> neighbors;
+		if (right % columns != 0 && right < count) neighbors << right;
+		if (below < count) neighbors << below;
+		for (int neighbor : neighbors) {
+			AutoPlacer::Pin other;
+			other.part = neighbor;
+			other.offset = QPointF(10, 0);
+			nets << (AutoPlacer::Net() << pin << other);
+		}
+
+		pin.offset = QPointF(0, -10);
+		if (i % 4 == 0) power << pin;
+		pin.offset = QPointF(0, 10);
+		if (i % 4 == 1) ground << pin;
+	}
+	nets << power << ground;
+}
+
+void addPartCounts()
+{
+	QTest::addColumn<int>("count");
+	QTest::addColumn<int>("chains");
+	QTest::newRow("10") << 10 << 1;
+	QTest::newRow("50") << 50 << 1;
+	QTest::newRow("100") << 100 << 1;
+	QTest::newRow("100 threads") << 100 << QThread::idealThreadCount();
+}
+
+}
+
+class BenchPlacement : public QObject
+{
+	Q_OBJECT
+
+private Q_SLOTS:
+	void place_data();
+	void place();
+};
+
+void BenchPlacement::place_data()
+{
+	addPartCounts();
+}
+
+void BenchPlacement::place()
+{
+	QFETCH(int, count);
+	QFETCH(int, chains);
+	QRectF area;
+	QList<AutoPlacer::Part> parts;
+	QList<AutoPlacer::Net> nets;
+	makeBoard(count, area, parts, nets);
+
+	AutoPlacer placer(area, parts, nets);
+	QBENCHMARK_ONCE {
+		placer.place(chains);
+	}
+
+	QCOMPARE(placer.overlaps(), 0);
+	QList<QPointF> centers = placer.centers();
+	for (int i = 0; i < count; i++) {
+		QRectF r(QPointF(), parts.at(i).size);
+		r.moveCenter(centers.at(i));
+		QVERIFY(area.contains(r));
+		for (int j = i + 1; j < count; j++) {
+			QRectF other(QPointF(), parts.at(j).size);
+			other.moveCenter(centers.at(j));
+			QVERIFY(!r.intersects(other));
+		}
+	}
+
+	// no worse than the grid the nets were made from
+	QList<QPointF> grid;
+	int columns = qMax(1, (int) std::ceil(std::sqrt((double) count)));
+	for (int i = 0; i < count; i++) {
+		grid << QPointF((i % columns + 0.5) * Pitch * 1.5, (i / columns + 0.5) * Pitch * 1.5);
+	}
+	QVERIFY(placer.wirelength() <= AutoPlacer::wirelength(nets, grid) * 1.25);
+	qDebug() << "wirelength" << placer.initialWirelength() << "->" << placer.wirelength();
+}
+
+QTEST_GUILESS_MAIN(BenchPlacement)
+#include "bench_placement.moc"
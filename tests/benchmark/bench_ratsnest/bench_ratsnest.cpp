@@ -0,0 +1,158 @@
+/*******************************************************************
+
+Part of the Fritzing project - http://fritzing.org
+Copyright (c) 2019 Fritzing
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************/
+
+#include "utils/spanningtree.h"
+
+#include <QtTest>
+#include <QRandomGenerator>
+
+#include <boost/config.hpp>
+#include <boost/graph/adjacency_list.hpp>
+#include <boost/graph/prim_minimum_spanning_tree.hpp>
+
+#include <cmath>
+
+/*
+Ratsnest spanning trees for a single net with a growing number of pins, as computed by
+GraphUtils::chooseRatsnestGraph: the sparse nearest neighbor tree, and for comparison
+the Prim tree over the complete graph that was used before.
+*/
+
+namespace {
+
+// pins laid out like a power net, a few pins per part, every fourth part already wired
+void makeNet(int pins, QList<QPointF> & locs, DisjointSets & groups)
+{
+	QRandomGenerator random(pins);
+	for (int i = 0; i < pins; i++) {
+		int part = i / 4;
+		double x = (part % 25) * 400 + random.bounded(100.0);
+		double y = (part / 25) * 300 + (i % 4) * 100.0;
+		locs << QPointF(x, y);
+		if ((part % 4 == 0) && (i % 4 != 0)) groups.unite(i, i - (i % 4));
+	}
+}
+
+double length(const QList<QPointF> & locs, const QList< QPair<int, int> > & edges)
+{
+	double total = 0;
+	for (const QPair<int, int> & edge : edges) {
+		QPointF d = locs.at(edge.first) - locs.at(edge.second);
+		total += std::sqrt((d.x() * d.x()) + (d.y() * d.y()));
+	}
+	return total;
+}
+
+QList< QPair<int, int> > completePrim(const QList<QPointF> & locs, DisjointSets & groups)
+{
+	using namespace boost;
+	typedef adjacency_list < vecS, vecS, undirectedS, property<vertex_distance_t, double>, property < edge_weight_t, double > > Graph;
+	typedef std::pair < int, int > E;
+
+	int num_nodes = locs.count();
+	std::vector<E> edges;
+	std::vector<double> weights;
+	for (int i = 0; i < num_nodes; i++) {
+		for (int j = i + 1; j < num_nodes; j++) {
+			edges.push_back(E(i, j));
+			if (groups.find(i) == groups.find(j)) {
+				weights.push_back(0);
+				continue;
+			}
+			QPointF d = locs.at(i) - locs.at(j);
+			weights.push_back((d.x() * d.x()) + (d.y() * d.y()));
+		}
+	}
+
+	Graph g(edges.begin(), edges.end(), weights.begin(), num_nodes);
+	std::vector < graph_traits < Graph >::vertex_descriptor > p(num_vertices(g));
+	prim_minimum_spanning_tree(g, &p[0]);
+
+	QList< QPair<int, int> > result;
+	for (std::size_t i = 0; i != p.size(); ++i) {
+		if (i == p[i]) continue;
+		if (groups.find((int) i) == groups.find((int) p[i])) continue;
+		result.append(qMakePair((int) i, (int) p[i]));
+	}
+	return result;
+}
+
+void addPinCounts()
+{
+	QTest::addColumn<int>("pins");
+	QTest::newRow("50") << 50;
+	QTest::newRow("200") << 200;
+	QTest::newRow("1000") << 1000;
+}
+
+}
+
+class BenchRatsnest : public QObject
+{
+	Q_OBJECT
+
+private Q_SLOTS:
+	void sparse_data();
+	void sparse();
+	void complete_data();
+	void complete();
+};
+
+void BenchRatsnest::sparse_data()
+{
+	addPinCounts();
+}
+
+void BenchRatsnest::sparse()
+{
+	QFETCH(int, pins);
+	QList<QPointF> locs;
+	DisjointSets groups(pins);
+	makeNet(pins, locs, groups);
+
+	QList< QPair<int, int> > edges;
+	QBENCHMARK {
+		edges = SpanningTree::euclidean(locs, groups);
+	}
+	QCOMPARE(edges.count(), groups.count() - 1);
+
+	// the nearest neighbor tree should be as short as the tree over the complete graph
+	QVERIFY(qAbs(length(locs, edges) - length(locs, completePrim(locs, groups))) < 1e-6);
+}
+
+void BenchRatsnest::complete_data()
+{
+	addPinCounts();
+}
+
+void BenchRatsnest::complete()
+{
+	QFETCH(int, pins);
+	QList<QPointF> locs;
+	DisjointSets groups(pins);
+	makeNet(pins, locs, groups);
+
+	QBENCHMARK {
+		completePrim(locs, groups);
+	}
+}
+
+QTEST_GUILESS_MAIN(BenchRatsnest)
+#include "bench_ratsnest.moc"
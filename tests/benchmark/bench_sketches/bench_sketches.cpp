@@ -0,0 +1,158 @@
+/*******************************************************************
+
+Part of the Fritzing project - http://fritzing.org
+Copyright (c) 2019 Fritzing
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************/
+
+#include <QtTest>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QProcess>
+#include <QTemporaryDir>
+
+/*
+Load each bundled example sketch with the Fritzing executable in FRITZING_BINARY, using the
+headless svg export service (-svg), which opens the sketch and renders all three views.
+
+loadLargest loads the largest examples in one -batch run, with the part svgs prepared on worker
+threads and again with -noprefetch, and reports the summed load times and how many layers the
+prefetch prepared and the views used.
+*/
+
+namespace {
+
+const int LargestCount = 10;
+
+}
+
+class BenchSketches : public QObject
+{
+	Q_OBJECT
+
+private Q_SLOTS:
+	void initTestCase();
+	void loadSketch_data();
+	void loadSketch();
+	void loadLargest_data();
+	void loadLargest();
+
+private:
+	QString m_binary;
+};
+
+void BenchSketches::initTestCase()
+{
+	m_binary = qEnvironmentVariable("FRITZING_BINARY");
+	if (m_binary.isEmpty() || !QFileInfo(m_binary).isExecutable()) {
+		QSKIP("set FRITZING_BINARY to a built Fritzing executable");
+	}
+}
+
+void BenchSketches::loadSketch_data()
+{
+	QTest::addColumn<QString>("sketch");
+
+	QDir dir(SKETCHES_DIR);
+	const QStringList sketches = dir.entryList(QStringList("*.fzz"), QDir::Files, QDir::Name);
+	for (const QString & sketch : sketches) {
+		QTest::newRow(qPrintable(sketch)) << dir.absoluteFilePath(sketch);
+	}
+}
+
+void BenchSketches::loadSketch()
+{
+	QFETCH(QString, sketch);
+
+	QTemporaryDir outputDir;
+	QVERIFY(outputDir.isValid());
+	QFileInfo info(sketch);
+	QVERIFY(QFile::copy(sketch, outputDir.filePath(info.fileName())));
+
+	QProcessEnvironment environment = QProcessEnvironment::systemEnvironment();
+	environment.insert("QT_QPA_PLATFORM", "offscreen");
+
+	QBENCHMARK_ONCE {
+		QProcess process;
+		process.setProcessEnvironment(environment);
+		process.start(m_binary, QStringList() << "-svg" << outputDir.path());
+		QVERIFY(process.waitForFinished(5 * 60 * 1000));
+		QCOMPARE(process.exitStatus(), QProcess::NormalExit);
+	}
+
+	QDir dir(outputDir.path());
+	QCOMPARE(dir.entryList(QStringList(info.completeBaseName() + "_*.svg"), QDir::Files).count(), 3);
+}
+
+void BenchSketches::loadLargest_data()
+{
+	QTest::addColumn<QStringList>("arguments");
+
+	QTest::newRow("prefetch") << QStringList();
+	QTest::newRow("no prefetch") << QStringList("-noprefetch");
+}
+
+void BenchSketches::loadLargest()
+{
+	QFETCH(QStringList, arguments);
+
+	QTemporaryDir outputDir;
+	QVERIFY(outputDir.isValid());
+	QDir dir(SKETCHES_DIR);
+	const QStringList sketches = dir.entryList(QStringList("*.fzz"), QDir::Files, QDir::Size).mid(0, LargestCount);
+	for (const QString & sketch : sketches) {
+		QVERIFY(QFile::copy(dir.absoluteFilePath(sketch), outputDir.filePath(sketch)));
+	}
+
+	QProcessEnvironment environment = QProcessEnvironment::systemEnvironment();
+	environment.insert("QT_QPA_PLATFORM", "offscreen");
+
+	QBENCHMARK_ONCE {
+		QProcess process;
+		process.setProcessEnvironment(environment);
+		process.start(m_binary, QStringList() << "-batch" << outputDir.path() << "-outputs" << "bom" << arguments);
+		QVERIFY(process.waitForFinished(10 * 60 * 1000));
+		QCOMPARE(process.exitStatus(), QProcess::NormalExit);
+	}
+
+	QFile file(QDir(outputDir.path()).absoluteFilePath("fritzing_batch.json"));
+	QVERIFY(file.open(QIODevice::ReadOnly));
+	QJsonObject summary = QJsonDocument::fromJson(file.readAll()).object();
+	QCOMPARE(summary["failed"].toInt(), 0);
+
+	qint64 load = 0;
+	int prepared = 0;
+	int used = 0;
+	int direct = 0;
+	const QJsonArray files = summary["files"].toArray();
+	for (const QJsonValue & value : files) {
+		QJsonObject result = value.toObject();
+		qint64 ms = result["timings"].toObject()["load"].toVariant().toLongLong();
+		QJsonObject prefetch = result["svgPrefetch"].toObject();
+		qInfo("%s: load %lld ms", qPrintable(QFileInfo(result["file"].toString()).fileName()), ms);
+		load += ms;
+		prepared += prefetch["prepared"].toInt();
+		used += prefetch["used"].toInt();
+		direct += prefetch["direct"].toInt();
+	}
+	QCOMPARE(files.count(), sketches.count());
+
+	qInfo("load: %lld ms; svg layers: %d prepared, %d used, %d loaded directly", load, prepared, used, direct);
+}
+
+QTEST_GUILESS_MAIN(BenchSketches)
+#include "bench_sketches.moc"
@@ -0,0 +1,376 @@
+/*******************************************************************
+
+Part of the Fritzing project - http://fritzing.org
+Copyright (c) 2019 Fritzing
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************/
+
+#include "svg/svgpathvisitor.h"
+#include "svg/svgpathparser.h"
+#include "svg/svgpathlexer.h"
+#include "svg/svgfilesplitter.h"
+#include "svg/svg2gerber.h"
+#include "svg/scanlinetracer.h"
+#include "autoroute/drcbitmap.h"
+#include "utils/textutils.h"
+
+#include <QtMath>
+#include <QtTest>
+#include <QTemporaryFile>
+
+/*
+Benchmarks of the svg processing used when loading parts, exporting gerbers and
+tracing ground fills, and of the DRC bitmap loops, run on synthetic boards with
+a growing number of parts.
+*/
+
+namespace {
+
+QString makePathData(int segments)
+{
+	QString data = "M0,0";
+	for (int i = 0; i < segments; i++) {
+		data += QString("L%1,%2c1.5,-2.5,3,4.25,-5,6e-1a2.6 3.5 0 0 1-5.2 0").arg(i).arg(-i * 0.5);
+	}
+	return data + "z";
+}
+
+// a copper layer with one footprint-like group of pads, holes and traces per part
+QString makeBoardSvg(int parts)
+{
+	const int columns = 20;
+	double width = columns * 100;
+	double height = ((parts + columns - 1) / columns) * 100;
+
+	QString svg = TextUtils::makeSVGHeader(1000, 1000, width, height);
+	svg += "<g id='copper0'>\n";
+	for (int i = 0; i < parts; i++) {
+		double x = (i % columns) * 100;
+		double y = (i / columns) * 100;
+		svg += QString("<g transform='translate(%1,%2)'>\n").arg(x).arg(y);
+		svg += "<circle cx='10' cy='10' r='6' fill='none' stroke='#F7BD13' stroke-width='4'/>\n";
+		svg += "<circle cx='50' cy='10' r='6' fill='none' stroke='#F7BD13' stroke-width='4'/>\n";
+		svg += "<rect x='4' y='40' width='12' height='20' fill='#F7BD13'/>\n";
+		svg += "<rect x='44' y='40' width='12' height='20' fill='#F7BD13'/>\n";
+		svg += "<polygon points='70,10 90,10 90,30 80,40 70,30' fill='#F7BD13'/>\n";
+		svg += "<path d='M10,10L30,30C40,40 50,30 50,10' fill='none' stroke='#F7BD13' stroke-width='8'/>\n";
+		svg += "</g>\n";
+	}
+	svg += "</g>\n</svg>\n";
+	return svg;
+}
+
+// the scan line runs of a ground fill with a round and a square clearance per part
+QList<QRect> makeFillRuns(int parts)
+{
+	const int columns = 20;
+	const int cell = 100;
+	int width = columns * cell;
+	int height = ((parts + columns - 1) / columns) * cell;
+
+	QList<QRect> runs;
+	for (int y = 0; y < height; y++) {
+		int row = y / cell;
+		int cy = y % cell;
+		int left = 0;
+		for (int c = 0; c < columns && row * columns + c < parts; c++) {
+			QList<QPair<int, int> > clearances;
+			double dy = cy + 0.5 - 30;
+			if (qAbs(dy) < 12) {
+				int dx = qFloor(qSqrt(144 - dy * dy));
+				clearances << qMakePair(c * cell + 30 - dx, c * cell + 30 + dx);
+			}
+			if (cy >= 50 && cy < 80) {
+				clearances << qMakePair(c * cell + 60, c * cell + 80);
+			}
+			for (const QPair<int, int> & clearance : clearances) {
+				if (clearance.first > left) {
+					runs.append(QRect(left, y, clearance.first - left, 1));
+				}
+				left = clearance.second;
+			}
+		}
+		if (left < width) {
+			runs.append(QRect(left, y, width - left, 1));
+		}
+	}
+	return runs;
+}
+
+// the ground fill as the mono image scanLines reads: the runs are white (1), the clearances black (0)
+QImage makeFillImage(int parts, const QList<QRect> & runs)
+{
+	const int columns = 20;
+	const int cell = 100;
+	QImage image(columns * cell, ((parts + columns - 1) / columns) * cell, QImage::Format_Mono);
+	image.fill(0);
+	for (const QRect & r : runs) {
+		uchar * s = image.scanLine(r.y());
+		for (int x = r.left(); x <= r.right(); x++) {
+			*(s + (x >> 3)) |= DRCBitmap::BitTable[x & 7];
+		}
+	}
+	return image;
+}
+
+void addPartCounts()
+{
+	QTest::addColumn<int>("count");
+	QTest::newRow("10") << 10;
+	QTest::newRow("100") << 100;
+	QTest::newRow("1000") << 1000;
+}
+
+}
+
+class BenchSvg : public QObject
+{
+	Q_OBJECT
+
+private Q_SLOTS:
+	void pathVisitor_data();
+	void pathVisitor();
+	void pathParser_data();
+	void pathParser();
+	void fixMuch_data();
+	void fixMuch();
+	void splitter_data();
+	void splitter();
+	void svg2gerber_data();
+	void svg2gerber();
+	void traceScanLines_data();
+	void traceScanLines();
+	void scanLines_data();
+	void scanLines();
+	void extendBorder_data();
+	void extendBorder();
+	void pixelsCollide_data();
+	void pixelsCollide();
+};
+
+void BenchSvg::pathVisitor_data()
+{
+	addPartCounts();
+}
+
+void BenchSvg::pathVisitor()
+{
+	QFETCH(int, count);
+	QString data = makePathData(count);
+	int commands = 0;
+	auto visitor = [&commands](QChar, bool, const SVGPathArgs &) { commands++; };
+
+	QBENCHMARK {
+		QVERIFY(SVGPathVisitor::visit(data, visitor));
+	}
+	QVERIFY(commands > 0);
+}
+
+void BenchSvg::pathParser_data()
+{
+	addPartCounts();
+}
+
+void BenchSvg::pathParser()
+{
+	QFETCH(int, count);
+	QString data = makePathData(count);
+
+	QBENCHMARK {
+		QString dataCopy(data);
+		SVGPathLexer lexer(dataCopy);
+		SVGPathParser parser;
+		QVERIFY(parser.parse(lexer));
+	}
+}
+
+void BenchSvg::fixMuch_data()
+{
+	addPartCounts();
+}
+
+void BenchSvg::fixMuch()
+{
+	QFETCH(int, count);
+	QString svg = makeBoardSvg(count);
+
+	QBENCHMARK {
+		QString svgCopy(svg);
+		TextUtils::fixMuch(svgCopy, true);
+	}
+}
+
+void BenchSvg::splitter_data()
+{
+	addPartCounts();
+}
+
+void BenchSvg::splitter()
+{
+	QFETCH(int, count);
+	QTemporaryFile file;
+	QVERIFY(file.open());
+	file.write(makeBoardSvg(count).toUtf8());
+	file.close();
+
+	QBENCHMARK {
+		SvgFileSplitter splitter;
+		QVERIFY(splitter.split(file.fileName(), "copper0"));
+	}
+}
+
+void BenchSvg::svg2gerber_data()
+{
+	addPartCounts();
+}
+
+void BenchSvg::svg2gerber()
+{
+	QFETCH(int, count);
+	QString svg = makeBoardSvg(count);
+	QSizeF boardSize(20 * 100, ((count + 19) / 20) * 100);
+
+	QBENCHMARK {
+		SVG2gerber gerber;
+		gerber.convert(svg, true, "Copper0", SVG2gerber::ForCopper, boardSize);
+	}
+}
+
+void BenchSvg::traceScanLines_data()
+{
+	addPartCounts();
+}
+
+void BenchSvg::traceScanLines()
+{
+	QFETCH(int, count);
+	QList<QRect> runs = makeFillRuns(count);
+	QList<QPolygon> polygons;
+
+	QBENCHMARK {
+		polygons = ScanLineTracer::trace(runs);
+	}
+
+	// the fill is one piece, and the traced polygon covers exactly the runs
+	QCOMPARE(polygons.count(), 1);
+	qint64 runArea = 0;
+	for (const QRect & r : runs) {
+		runArea += r.width();
+	}
+	qint64 doubledArea = 0;
+	const QPolygon & polygon = polygons.first();
+	for (int i = 0; i < polygon.count(); i++) {
+		QPoint p = polygon.at(i);
+		QPoint q = polygon.at((i + 1) % polygon.count());
+		doubledArea += qint64(p.x()) * q.y() - qint64(q.x()) * p.y();
+	}
+	QCOMPARE(doubledArea, 2 * runArea);
+}
+
+void BenchSvg::scanLines_data()
+{
+	QTest::addColumn<int>("count");
+	QTest::addColumn<int>("minSize");
+	QTest::newRow("10") << 10 << 1;
+	QTest::newRow("100") << 100 << 1;
+	QTest::newRow("1000") << 1000 << 1;
+	// the minimum run and rise size of the ground fill
+	QTest::newRow("10 min 10") << 10 << 10;
+	QTest::newRow("100 min 10") << 100 << 10;
+	QTest::newRow("1000 min 10") << 1000 << 10;
+}
+
+void BenchSvg::scanLines()
+{
+	QFETCH(int, count);
+	QFETCH(int, minSize);
+	QList<QRect> runs = makeFillRuns(count);
+	QImage image = makeFillImage(count, runs);
+	QList<QRect> rects;
+
+	// scanLines blacks out short rises in place, so each pass works on a fresh copy
+	QBENCHMARK {
+		QImage copy = image.copy();
+		rects.clear();
+		ScanLineTracer::scanLines(copy, copy.width(), copy.height(), minSize, minSize, rects);
+	}
+
+	if (minSize == 1) {
+		QCOMPARE(rects, runs);
+	}
+	else {
+		QVERIFY(!rects.isEmpty());
+	}
+}
+
+void BenchSvg::extendBorder_data()
+{
+	addPartCounts();
+}
+
+void BenchSvg::extendBorder()
+{
+	QFETCH(int, count);
+	QImage image = makeFillImage(count, makeFillRuns(count));
+	QImage copy;
+
+	// extendBorder works in place, so each pass works on a fresh copy
+	QBENCHMARK {
+		copy = image.copy();
+		DRCBitmap::extendBorder(4, &copy);		// a keepout of four pixels
+	}
+
+	// the clearances grow, so fewer pixels stay white
+	QCOMPARE(copy.size(), image.size());
+	QVERIFY(copy != image);
+}
+
+void BenchSvg::pixelsCollide_data()
+{
+	addPartCounts();
+}
+
+void BenchSvg::pixelsCollide()
+{
+	QFETCH(int, count);
+	// the clearances of one image against the same clearances moved by a few pixels,
+	// so every part overlaps a little as in a failing DRC
+	QImage plusImage = makeFillImage(count, makeFillRuns(count));
+	QImage minusImage(plusImage.size(), QImage::Format_Mono);
+	minusImage.fill(1);
+	for (int y = 0; y < plusImage.height(); y++) {
+		const uchar * s = plusImage.constScanLine(y);
+		uchar * d = minusImage.scanLine(y);
+		for (int x = 0; x + 3 < plusImage.width(); x++) {
+			if ((*(s + (x >> 3)) & DRCBitmap::BitTable[x & 7]) == 0) {
+				*(d + ((x + 3) >> 3)) &= ~DRCBitmap::BitTable[(x + 3) & 7];
+			}
+		}
+	}
+	QImage displayImage(plusImage.size(), QImage::Format_Mono);
+	bool collide = false;
+
+	QBENCHMARK {
+		displayImage.fill(0);
+		QList<QPointF> points;
+		collide = DRCBitmap::pixelsCollide(&plusImage, &minusImage, &displayImage, 0, 0, plusImage.width(), plusImage.height(), 1, points);
+	}
+
+	QVERIFY(collide);
+}
+
+QTEST_GUILESS_MAIN(BenchSvg)
+#include "bench_svg.moc"
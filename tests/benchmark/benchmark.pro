@@ -0,0 +1,29 @@
+# /*******************************************************************
+# Part of the Fritzing project - http://fritzing.org
+# Copyright (c) 2019 Fritzing
+# Fritzing is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+# Fritzing is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+# GNU General Public License for more details.
+# You should have received a copy of the GNU General Public License
+# along with Fritzing. If not, see <http://www.gnu.org/licenses/>.
+# ********************************************************************/
+
+# QtTest QBENCHMARK suites. Run a benchmark with machine readable results, e.g.
+#   ./bench_svg -o bench_svg.xml,xml -o -,txt
+#   ./bench_svg -o bench_svg.csv,csv
+# bench_sketches loads the bundled sketches/ examples and bench_kicad converts a
+# generated KiCad footprint library with a built Fritzing executable, set
+# FRITZING_BINARY to its path; bench_sketches also compares loading with and
+# without -noprefetch. bench_exports times the -batch exports of the
+# largest examples with the same executable, and bench_autoroute compares the
+# sequential and the negotiated autorouter on the examples, and the undo layouts
+# of the routed traces.
+
+TEMPLATE = subdirs
+
+SUBDIRS = bench_svg bench_ratsnest bench_placement bench_sketches bench_kicad bench_logo bench_exports bench_autoroute
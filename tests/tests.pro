@@ -2,5 +2,5 @@ CONFIG += C++17
 
 TEMPLATE = subdirs
 
-SUBDIRS = auto
+SUBDIRS = auto benchmark
 